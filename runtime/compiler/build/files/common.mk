@@ -355,6 +355,7 @@ JIT_PRODUCT_SOURCE_FILES+=\
     compiler/runtime/HWProfiler.cpp \
     compiler/runtime/HookHelpers.cpp \
     compiler/runtime/IProfiler.cpp \
+    compiler/runtime/IProfilerSnapshot.cpp \
     compiler/runtime/J9CodeCache.cpp \
     compiler/runtime/J9CodeCacheManager.cpp \
     compiler/runtime/J9CodeCacheMemorySegment.cpp \
@@ -404,7 +405,9 @@ JIT_PRODUCT_SOURCE_FILES+=\
     compiler/net/ServerStream.cpp \
     compiler/runtime/CompileService.cpp \
     compiler/runtime/JITClientSession.cpp \
+    compiler/runtime/JITServerAOTCache.cpp \
     compiler/runtime/JITServerIProfiler.cpp \
+    compiler/runtime/JITServerROMClassCache.cpp \
     compiler/runtime/JITServerStatisticsThread.cpp \
     compiler/runtime/Listener.cpp
 endif
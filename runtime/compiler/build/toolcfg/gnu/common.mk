@@ -433,6 +433,9 @@ SOLINK_SLINK+=$(PRODUCT_SLINK) j9thr$(J9_VERSION) j9hookable$(J9_VERSION)
 ifeq ($(HOST_ARCH),z)
     CX_DEFINES+=COMPRESS_AOT_DATA
     SOLINK_SLINK+=j9zlib$(J9_VERSION)
+else ifneq ($(J9VM_OPT_JITSERVER),)
+    # JITServer messages can be compressed
+    SOLINK_SLINK+=j9zlib$(J9_VERSION)
 endif
 
 ifeq ($(HOST_ARCH),x)
@@ -468,11 +468,11 @@ TR::DefaultCompilationStrategy::processInterpreterSample(TR_MethodEvent *event)
                      if (logSampling)
                         {
                         if (n > 0)
-                           curMsg += sprintf(curMsg, " promoted from %d", n);
+                           curMsg += sprintf(curMsg, " promoted");
                         else if (n == 0)
                            curMsg += sprintf(curMsg, " comp in progress");
                         else
-                           curMsg += sprintf(curMsg, " already in the right place %d", n);
+                           curMsg += sprintf(curMsg, " already in the right place");
                         }
                      }
                   }
@@ -77,6 +77,8 @@ template <typename T> class TR_PersistentArray;
 typedef J9JITExceptionTable TR_MethodMetaData;
 #if defined(J9VM_OPT_JITSERVER)
 class ClientSessionHT;
+class JITServerSharedROMClassCache;
+class JITServerAOTCacheMap;
 #endif /* defined(J9VM_OPT_JITSERVER) */
 
 struct TR_SignatureCountPair
@@ -687,6 +689,10 @@ public:
    TR_MethodToBeCompiled *addOutOfProcessMethodToBeCompiled(JITServer::ServerStream *stream);
 #endif /* defined(J9VM_OPT_JITSERVER) */
    void                   queueEntry(TR_MethodToBeCompiled *entry);
+   void                   dequeueEntry(TR_MethodToBeCompiled *entry);
+   void                   changeQueuedEntryPriority(TR_MethodToBeCompiled *entry, uint16_t priority);
+   TR_MethodToBeCompiled *findQueuedEntry(TR::IlGeneratorMethodDetails &details, TR_FrontEnd *fe);
+   TR_MethodToBeCompiled *findQueuedNonDLTEntry(J9Method *method);
    void                   recycleCompilationEntry(TR_MethodToBeCompiled *cur);
 #if defined(J9VM_OPT_JITSERVER)
    void                   requeueOutOfProcessEntry(TR_MethodToBeCompiled *entry);
@@ -698,6 +704,10 @@ public:
    void changeCompReqFromAsyncToSync(J9Method * method);
    int32_t                promoteMethodInAsyncQueue(J9Method * method, void *pc);
    TR_MethodToBeCompiled *getNextMethodToBeCompiled(TR::CompilationInfoPerThread *compInfoPT, bool compThreadCameOutOfSleep, TR_CompThreadActions*);
+#if defined(J9VM_OPT_JITSERVER)
+   TR_MethodToBeCompiled *getNextOutOfProcessEntry();
+   int32_t getNumCompilationsInProgressForClient(uint64_t clientUID);
+#endif /* defined(J9VM_OPT_JITSERVER) */
    TR_MethodToBeCompiled *peekNextMethodToBeCompiled();
    TR_MethodToBeCompiled *getMethodQueue() { return _methodQueue; }
    int32_t getOverallCompCpuUtilization() const { return _overallCompCpuUtilization; } // -1 in case of error. 0 if feature is not enabled
@@ -878,11 +888,13 @@ public:
    void queueForcedAOTUpgrade(TR_MethodToBeCompiled *originalEntry, uint16_t hints, TR_FrontEnd *fe);
 
    uint32_t getNumTargetCPUs() const { return _cpuEntitlement.getNumTargetCPUs(); }
+   uint32_t getNumEntitledCPUs() const { return _cpuEntitlement.getNumEntitledCPUs(); }
 
    bool isHypervisorPresent() { return _cpuEntitlement.isHypervisorPresent(); }
    double getGuestCpuEntitlement() const { return _cpuEntitlement.getGuestCpuEntitlement(); }
    void computeAndCacheCpuEntitlement() { _cpuEntitlement.computeAndCacheCpuEntitlement(); }
    double getJvmCpuEntitlement() const { return _cpuEntitlement.getJvmCpuEntitlement(); }
+   double getCgroupCpuEntitlement() const { return _cpuEntitlement.getCgroupCpuEntitlement(); }
 
    bool importantMethodForStartup(J9Method *method);
    bool shouldDowngradeCompReq(TR_MethodToBeCompiled *entry);
@@ -890,6 +902,28 @@ public:
 
    int32_t computeDynamicDumbInlinerBytecodeSizeCutoff(TR::Options *options);
    TR_YesNoMaybe shouldActivateNewCompThread();
+   /**
+    * @brief Moving average of the time (ms) spent by requests in the compilation queue.
+    *        Maintained on dequeue and halved for every half-life elapsed since the last
+    *        dequeue, so that waits measured before the queue drained do not keep
+    *        activating threads. Caller must hold the compilation queue monitor.
+    */
+   uint32_t getAvgQueueWaitMs();
+   /**
+    * @brief Whether requests wait so little in the queue that a compilation thread
+    *        can be suspended; always false unless TR::Options::_compQueueWaitTargetMs is set.
+    *        Like activation by queue wait in shouldActivateNewCompThread, this only applies
+    *        when the number of threads to activate is determined from the number of CPUs,
+    *        otherwise threads would be suspended by the wait but activated by other rules.
+    *        The lower bound is half the target so that threads are not resumed and
+    *        suspended in quick succession.
+    */
+   bool queueWaitBelowTarget()
+      {
+      return TR::Options::_compQueueWaitTargetMs > 0 &&
+             TR::Options::_useCPUsToDetermineMaxNumberOfCompThreadsToActivate &&
+             getAvgQueueWaitMs() < (uint32_t)TR::Options::_compQueueWaitTargetMs / 2;
+      }
 #if DEBUG
    void debugPrint(char *debugString);
    void debugPrint(J9VMThread *, char *);
@@ -1018,6 +1052,10 @@ public:
 #if defined(J9VM_OPT_JITSERVER)
    ClientSessionHT *getClientSessionHT() const { return _clientSessionHT; }
    void setClientSessionHT(ClientSessionHT *ht) { _clientSessionHT = ht; }
+   JITServerSharedROMClassCache *getJITServerSharedROMClassCache() const { return _sharedROMClassCache; }
+   void setJITServerSharedROMClassCache(JITServerSharedROMClassCache *cache) { _sharedROMClassCache = cache; }
+   JITServerAOTCacheMap *getJITServerAOTCacheMap() const { return _JITServerAOTCacheMap; }
+   void setJITServerAOTCacheMap(JITServerAOTCacheMap *map) { _JITServerAOTCacheMap = map; }
 
    PersistentVector<TR_OpaqueClassBlock*> *getUnloadedClassesTempList() const { return _unloadedClassesTempList; }
    void setUnloadedClassesTempList(PersistentVector<TR_OpaqueClassBlock*> *it) { _unloadedClassesTempList = it; }
@@ -1081,6 +1119,8 @@ public:
    static const uint32_t MAX_CLIENT_USABLE_COMP_THREADS = 7;  // For JITClient and non-JITServer mode
    static const uint32_t MAX_SERVER_USABLE_COMP_THREADS = 63; // JITServer
    static const uint32_t MAX_DIAGNOSTIC_COMP_THREADS = 1;
+   // JITServer requests queued for longer than this are processed ahead of higher priority ones
+   static const uint64_t JITSERVER_MAX_QUEUE_WAIT_MS = 2000;
 
 private:
 
@@ -1111,6 +1151,27 @@ private:
 
    static const size_t DLT_HASHSIZE = 123;
 
+   // The main compilation queue is a list ordered by priority (FIFO among equal priorities).
+   // To avoid walking it, entries are also indexed by J9Method and the last entry of every
+   // priority present in the queue is remembered, which gives the insertion point of a new
+   // entry. Both structures are embedded here and in the entries themselves, so queuing a
+   // request never allocates memory.
+   static const uint32_t COMP_QUEUE_INDEX_BITS = 10;
+   static const size_t COMP_QUEUE_INDEX_SIZE = (size_t)1 << COMP_QUEUE_INDEX_BITS;
+   static const int32_t COMP_QUEUE_MAX_PRIORITY_TAILS = 32;
+   struct CompQueuePriorityTail
+      {
+      TR_MethodToBeCompiled *_entry; // last entry with this priority; NULL if the slot is free
+      int32_t                _numEntries; // entries with _hasQueuePriorityTail set
+      uint16_t               _priority;
+      };
+   static size_t compQueueIndexBucket(J9Method *method)
+      {
+      // Fibonacci hashing: J9Methods are allocated contiguously, so take the top bits of the product
+      return (size_t)((uint32_t)((uintptr_t)method >> 3) * 0x9E3779B1U) >> (32 - COMP_QUEUE_INDEX_BITS);
+      }
+   CompQueuePriorityTail *findCompQueuePriorityTail(uint16_t priority);
+
    static TR::CompilationInfo * _compilationRuntime;
 
    static int32_t *_compThreadActivationThresholds;
@@ -1121,6 +1182,13 @@ private:
    TR::CompilationInfoPerThread *_compInfoForDiagnosticCompilationThread; // compinfo for dump compilation thread
    TR::CompilationInfoPerThreadBase *_compInfoForCompOnAppThread; // This is NULL for separate compilation thread
    TR_MethodToBeCompiled *_methodQueue;
+   TR_MethodToBeCompiled *_methodQueueIndex[COMP_QUEUE_INDEX_SIZE]; // buckets chained through _nextInQueueIndex
+   CompQueuePriorityTail  _methodQueuePriorityTails[COMP_QUEUE_MAX_PRIORITY_TAILS];
+   int32_t                _numQueuedWithoutPriorityTail; // entries queued when all priority tail slots were in use
+#if defined(J9VM_OPT_JITSERVER)
+   TR_MethodToBeCompiled *_oldestOutOfProcessEntry; // queued out-of-process requests in arrival order, chained through _nextArrived
+   TR_MethodToBeCompiled *_newestOutOfProcessEntry;
+#endif /* defined(J9VM_OPT_JITSERVER) */
    TR_MethodToBeCompiled *_methodPool;
    int32_t                _methodPoolSize; // shouldn't this and _methodPool be static?
 
@@ -1154,6 +1222,8 @@ private:
    int32_t                _maxQueueSize;
    int32_t                _numQueuedFirstTimeCompilations; // these have oldStartPC==0
    int32_t                _queueWeight; // approximation on overhead to process the entire queue
+   uint32_t               _avgQueueWaitMs; // moving average of queue wait of dequeued requests; use compQmonitor to change
+   uint64_t               _lastQueueWaitUpdateTime; // elapsed time (ms) when _avgQueueWaitMs was last updated
    CpuUtilization*        _cpuUtil; // object to compute cpu utilization
    int32_t                _overallCompCpuUtilization; // In percentage points. Valid only if TR::Options::_compThreadCPUEntitlement has a positive value
    int32_t                _idleThreshold; // % of entire machine CPU
@@ -1259,6 +1329,8 @@ private:
 
 #if defined(J9VM_OPT_JITSERVER)
    ClientSessionHT               *_clientSessionHT; // JITServer hashtable that holds session information about JITClients
+   JITServerSharedROMClassCache  *_sharedROMClassCache; // JITServer store of ROM classes shared by all clients; NULL if disabled
+   JITServerAOTCacheMap          *_JITServerAOTCacheMap; // JITServer AOT bodies reused by identical clients; NULL if disabled
    PersistentUnorderedSet<J9Class*> _classesCachedAtServer;
    TR::Monitor *_classesCachedAtServerMonitor;
    PersistentVector<TR_OpaqueClassBlock*> *_unloadedClassesTempList; // JITServer list of classes unloaded
@@ -102,6 +102,7 @@
 #include "control/JITServerCompilationThread.hpp"
 #include "control/JITServerHelpers.hpp"
 #include "runtime/JITClientSession.hpp"
+#include "runtime/Listener.hpp"
 #include "net/ClientStream.hpp"
 #include "net/ServerStream.hpp"
 #include "omrformatconsts.h"
@@ -544,6 +545,33 @@ TR_YesNoMaybe TR::CompilationInfo::shouldActivateNewCompThread()
        getPersistentInfo()->getElapsedTime() < (uint64_t)getPersistentInfo()->getClassLoadingPhaseGracePeriod())
       return TR_no;
 
+   // When a queue wait target is set, the measured wait rather than the queue
+   // weight decides activation. The upper bound of comp threads is still one
+   // less than the number of CPUs the JVM is entitled to.
+   if (TR::Options::_compQueueWaitTargetMs > 0 && TR::Options::_useCPUsToDetermineMaxNumberOfCompThreadsToActivate)
+      {
+      // Assume the wait shrinks in proportion to the number of threads draining the queue
+      uint32_t avgQueueWaitMs = getAvgQueueWaitMs();
+      int32_t target = TR::Options::_compQueueWaitTargetMs;
+      int32_t numCompThreadsNeeded = (int32_t)(((int64_t)getNumCompThreadsActive() * avgQueueWaitMs + target - 1) / target);
+      if (avgQueueWaitMs <= (uint32_t)target ||
+          getNumCompThreadsActive() >= numCompThreadsNeeded ||
+          getNumCompThreadsActive() >= (int32_t)getNumEntitledCPUs() - 1)
+         return TR_no;
+      if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerboseCompilationThreads))
+         {
+         TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "t=%6u Queue wait %u ms exceeds target %d ms. Qweight=%d active=%d needed=%d entitledCPUs=%u",
+            (uint32_t)getPersistentInfo()->getElapsedTime(),
+            avgQueueWaitMs,
+            target,
+            _queueWeight,
+            getNumCompThreadsActive(),
+            numCompThreadsNeeded,
+            getNumEntitledCPUs());
+         }
+      return TR_yes;
+      }
+
    // Activate if the compilation backlog is large.
    // If there is no comp thread starvation or if the number of comp threads was
    // determined based on the number of CPUs, then the upper bound of comp threads is _numTargetCPUs-1
@@ -551,7 +579,7 @@ TR_YesNoMaybe TR::CompilationInfo::shouldActivateNewCompThread()
    // to activate additional comp threads irrespective of the CPU entitlement
    if (TR::Options::_useCPUsToDetermineMaxNumberOfCompThreadsToActivate)
       {
-      if (getNumCompThreadsActive() < getNumTargetCPUs() - 1)
+      if (getNumCompThreadsActive() < getNumEntitledCPUs() - 1)
          {
          if (_queueWeight > _compThreadActivationThresholds[getNumCompThreadsActive()])
             return TR_yes;
@@ -858,8 +886,8 @@ TR::CompilationInfoPerThread::getAndCacheRemoteROMClass(J9Class *clazz, TR_Memor
    if (romClass == NULL)
       {
       JITServerHelpers::ClassInfoTuple classInfoTuple;
-      romClass = JITServerHelpers::getRemoteROMClass(clazz, getStream(), trMemory ? trMemory : TR::comp()->trMemory(), &classInfoTuple);
-      JITServerHelpers::cacheRemoteROMClass(getClientData(), clazz, romClass, &classInfoTuple);
+      romClass = JITServerHelpers::getRemoteROMClass(clazz, getClientData(), getStream(), trMemory ? trMemory : TR::comp()->trMemory(), &classInfoTuple);
+      romClass = JITServerHelpers::cacheRemoteROMClass(getClientData(), clazz, romClass, &classInfoTuple);
       }
    return romClass;
    }
@@ -1167,6 +1195,8 @@ TR::CompilationInfo::CompilationInfo(J9JITConfig *jitConfig) :
    _interpSamplTrackingInfo = new (PERSISTENT_NEW) TR_InterpreterSamplingTracking(this);
 #if defined(J9VM_OPT_JITSERVER)
    _clientSessionHT = NULL; // This will be set later when options are processed
+   _sharedROMClassCache = NULL; // This will be set later when options are processed
+   _JITServerAOTCacheMap = NULL; // This will be set later when options are processed
    _unloadedClassesTempList = NULL;
    _illegalFinalFieldModificationList = NULL;
    _newlyExtendedClasses = NULL;
@@ -1519,7 +1549,7 @@ TR::CompilationInfo::getMethodBytecodeSize(J9Method* method)
       {
          {
          ClientSessionData *clientSessionData = TR::compInfoPT->getClientData();
-         OMR::CriticalSection getRemoteROMClass(clientSessionData->getROMMapMonitor());
+         JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(clientSessionData->getJ9MethodMapRWMutex());
          auto it = clientSessionData->getJ9MethodMap().find(method);
          if (it != clientSessionData->getJ9MethodMap().end())
             {
@@ -1547,7 +1577,7 @@ TR::CompilationInfo::isJSR292(J9Method *j9method)
       {
          {
          ClientSessionData *clientSessionData = TR::compInfoPT->getClientData();
-         OMR::CriticalSection getRemoteROMClass(clientSessionData->getROMMapMonitor());
+         JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(clientSessionData->getJ9MethodMapRWMutex());
          auto it = clientSessionData->getJ9MethodMap().find(j9method);
          if (it != clientSessionData->getJ9MethodMap().end())
             {
@@ -1862,10 +1892,25 @@ TR::CompilationInfo::incNumInvRequestsQueued(TR_MethodToBeCompiled *entry)
    entry->_entryIsCountedAsInvRequest = true; _numInvRequestsInCompQueue++;
    }
 
+uint32_t
+TR::CompilationInfo::getAvgQueueWaitMs()
+   {
+   // The half-life is the wait target, or 100 ms when no target is set
+   uint64_t halfLife = TR::Options::_compQueueWaitTargetMs > 0 ? (uint64_t)TR::Options::_compQueueWaitTargetMs : 100;
+   uint64_t crtTime = getPersistentInfo()->getElapsedTime();
+   uint64_t numHalvings = crtTime > _lastQueueWaitUpdateTime ? (crtTime - _lastQueueWaitUpdateTime) / halfLife : 0;
+   return numHalvings >= 32 ? 0 : _avgQueueWaitMs >> numHalvings;
+   }
+
 void
 TR::CompilationInfo::updateCompQueueAccountingOnDequeue(TR_MethodToBeCompiled *entry)
    {
    _numQueuedMethods--; // one less method in the queue
+   // Weight the latest wait by 1/8 in the moving average
+   uint64_t crtTime = getPersistentInfo()->getElapsedTime();
+   uint32_t queueWait = crtTime > entry->_entryTime ? (uint32_t)(crtTime - entry->_entryTime) : 0;
+   _avgQueueWaitMs = (getAvgQueueWaitMs() * 7 + queueWait) >> 3;
+   _lastQueueWaitUpdateTime = crtTime;
    decNumGCRReqestsQueued(entry);
    decNumInvReqestsQueued(entry);
    if (entry->getMethodDetails().isOrdinaryMethod() && entry->_oldStartPC==0)
@@ -1940,7 +1985,6 @@ void TR::CompilationInfo::invalidateRequestsForNativeMethods(J9Class * clazz, J9
 
    // if compiling on app thread, there is no compilation queue
    TR_MethodToBeCompiled *cur = _methodQueue;
-   TR_MethodToBeCompiled *prev = NULL;
    while (cur)
       {
       TR_MethodToBeCompiled *next = cur->_next;
@@ -1965,20 +2009,13 @@ void TR::CompilationInfo::invalidateRequestsForNativeMethods(J9Class * clazz, J9
             }
 
          // detach from queue
-         if (prev)
-            prev->_next = cur->_next;
-         else
-            _methodQueue = cur->_next;
+         dequeueEntry(cur);
          updateCompQueueAccountingOnDequeue(cur);
          // decrease the queue weight
          decreaseQueueWeightBy(cur->_weight);
          // put back into the pool
          recycleCompilationEntry(cur);
          }
-      else
-         {
-         prev = cur;
-         }
       cur = next;
       }
    // LPQ does not need to be checked because JNI thunk requests cannot be put in LPQ
@@ -2035,7 +2072,6 @@ void TR::CompilationInfo::invalidateRequestsForUnloadedMethods(TR_OpaqueClassBlo
       } // end for
    // if compiling on app thread, there is no compilation queue
    TR_MethodToBeCompiled *cur  = _methodQueue;
-   TR_MethodToBeCompiled *prev = NULL;
    bool verboseDetails = TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerboseHookDetails);
    while (cur)
       {
@@ -2076,24 +2112,13 @@ void TR::CompilationInfo::invalidateRequestsForUnloadedMethods(TR_OpaqueClassBlo
                   }
                }
             // detach from queue
-            if (prev)
-               prev->_next = cur->_next;
-            else
-               _methodQueue = cur->_next;
+            dequeueEntry(cur);
             updateCompQueueAccountingOnDequeue(cur);
             // decrease the queue weight
             decreaseQueueWeightBy(cur->_weight);
             // put back into the pool
             recycleCompilationEntry(cur);
             }
-         else
-            {
-            prev = cur;
-            }
-         }
-      else
-         {
-         prev = cur;
          }
       cur = next;
       }
@@ -2393,7 +2418,7 @@ void TR::CompilationInfo::purgeMethodQueue(TR_CompilationErrorCode errorCode)
    while (_methodQueue)
       {
       TR_MethodToBeCompiled * cur = _methodQueue;
-      _methodQueue = cur->_next;
+      dequeueEntry(cur);
       updateCompQueueAccountingOnDequeue(cur);
       // decrease the queue weight
       decreaseQueueWeightBy(cur->_weight);
@@ -3397,6 +3422,15 @@ void TR::CompilationInfo::stopCompilationThreads()
          }
       fprintf(stderr, "-------------------------\n");
 
+      fprintf(stderr, "RELOS AND RELO TIME (usec) BY TYPE ------\n");
+      for (uint32_t i = 0; i < TR_NumExternalRelocationKinds; i++)
+         {
+         if (aotStats->numRelocationsByType[i])
+            fprintf(stderr, "%s: %u %" OMR_PRIu64 "\n", TR::ExternalRelocation::getName((TR_ExternalRelocationTargetKind)i),
+                    aotStats->numRelocationsByType[i], aotStats->relocationTimeByType[i]);
+         }
+      fprintf(stderr, "-------------------------\n");
+
       } // AOT stats
 
 
@@ -4406,6 +4440,7 @@ TR::CompilationInfoPerThread::processEntry(TR_MethodToBeCompiled &entry, J9::J9S
             && TR::Options::getCmdLineOptions()->getOption(TR_SuspendEarly)
             && compInfo->getQueueWeight() < TR::CompilationInfo::getCompThreadSuspensionThreshold(compInfo->getNumCompThreadsActive())
             )
+         || (!tryCompilingAgain && compInfo->queueWaitBelowTarget())
 #if defined(J9VM_OPT_JITSERVER)
          || (compInfo->getPersistentInfo()->getRemoteCompilationMode() == JITServer::CLIENT
             && compInfo->serverHasLowPhysicalMemory()) // keep suspending threads until server space frees up
@@ -4418,13 +4453,15 @@ TR::CompilationInfoPerThread::processEntry(TR_MethodToBeCompiled &entry, J9::J9S
       compInfo->decNumCompThreadsActive();
       if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerboseCompilationThreads))
          {
-         TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "t=%6u Suspend compThread %d Qweight=%d active=%d %s %s %s",
+         TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "t=%6u Suspend compThread %d Qweight=%d active=%d QWait=%u %s %s %s %s",
             (uint32_t)compInfo->getPersistentInfo()->getElapsedTime(),
             getCompThreadId(),
             compInfo->getQueueWeight(),
             compInfo->getNumCompThreadsActive(),
+            compInfo->getAvgQueueWaitMs(),
             compInfo->getRampDownMCT() ? "RampDownMCT" : "",
             compInfo->getSuspendThreadDueToLowPhysicalMemory() ? "LowPhysicalMem" : "",
+            compInfo->queueWaitBelowTarget() ? "QueueWaitBelowTarget" : "",
 #if defined(J9VM_OPT_JITSERVER)
             compInfo->serverHasLowPhysicalMemory() ? "ServerLowPhysicalMem" :
 #endif
@@ -4606,9 +4643,7 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
 #endif
 
    // Add this method to the queue of methods waiting to be compiled.
-   TR_MethodToBeCompiled *cur = NULL, *prev = NULL;
-   uint32_t queueWeight = 0; // QW
-   int32_t numEntries = 0;
+   TR_MethodToBeCompiled *cur = NULL;
 
    // See if the method is already in the queue or is already being compiled
    //
@@ -4624,7 +4659,6 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
       TR_MethodToBeCompiled *compMethod = curCompThreadInfoPT->getMethodBeingCompiled();
       if (compMethod)
          {
-         queueWeight += compMethod->_weight; // QW
          if (compMethod->getMethodDetails().sameAs(details, fe))
             {
             if (!compMethod->_unloadedMethod) // Redefinition; see cmvc 192606 and RTC 36898
@@ -4639,13 +4673,7 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
          }
       }
 
-   for (prev = NULL, cur = _methodQueue; cur; prev = cur, cur = cur->_next)
-      {
-      numEntries++;
-      queueWeight += cur->_weight;
-      if (cur->getMethodDetails().sameAs(details, fe))
-         break;
-      }
+   cur = findQueuedEntry(details, fe);
 
    // NOTE: we do not need to search the methodPool since we cannot reach here if an entry
    // for the compilation of this method is already in the pool.  Things are put in the pool
@@ -4664,10 +4692,6 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
       if (pc)
          cur->_oldStartPC = pc;
 
-      // If the priority has increased, use the new priority
-      //
-      if (cur->_priority < priority)
-         cur->_priority = priority;
       // If the optimization level is higher, just upgrade
       // (unless the methods has excessive complexity)
       //
@@ -4682,20 +4706,34 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
                methodInfo->setNextCompileLevel(cur->_optimizationPlan->getOptLevel(), cur->_optimizationPlan->insertInstrumentation());
             }
          }
-      // If the position in the queue is still correct, just return
-      //
-      if (!prev || prev->_priority >= cur->_priority)
-         return cur;
-
-      // Must re-position in the queue
+      // If the priority has increased, use the new priority
+      // and re-position the entry in the queue if needed
       //
-      prev->_next = cur->_next; // take it out of the queue
+      if (cur->_priority < priority)
+         changeQueuedEntryPriority(cur, priority);
+      return cur;
       }
 
    // If method is not yet in the queue prepare the queue entry
    //
    else
       {
+#if defined(DEBUG)
+      // Duplicates are found through the queue index, so the accounting
+      // is verified by walking the queue only in debug builds
+      uint32_t queueWeight = 0; // QW
+      int32_t numEntries = 0;
+      for (uint8_t i = 0; i < getNumTotalCompilationThreads(); i++)
+         {
+         TR_MethodToBeCompiled *compMethod = _arrayOfCompilationInfoPerThread[i]->getMethodBeingCompiled();
+         if (compMethod)
+            queueWeight += compMethod->_weight;
+         }
+      for (TR_MethodToBeCompiled *queued = _methodQueue; queued; queued = queued->_next)
+         {
+         numEntries++;
+         queueWeight += queued->_weight;
+         }
       if (queueWeight != _queueWeight) //QW
          {
          if (TR::Options::isAnyVerboseOptionSet())
@@ -4709,6 +4747,7 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
             TR_VerboseLog::writeLineLocked(TR_Vlog_INFO, "Discrepancy for queue size while adding to queue: Before adding numEntries=%d  _numQueuedMethods=%d\n", numEntries, _numQueuedMethods);
          TR_ASSERT(false, "Discrepancy for queue size while adding to queue");
          }
+#endif /* defined(DEBUG) */
 
       cur = getCompilationQueueEntry();
       if (cur == NULL)  // Memory Allocation Failure.
@@ -4884,7 +4923,7 @@ TR::CompilationInfo::addMethodToBeCompiled(TR::IlGeneratorMethodDetails & detail
          }
       }
 
-   // Move the entry to the right place in the queue
+   // Insert the new entry at the right place in the queue
    //
    queueEntry(cur);
 
@@ -4901,23 +4940,207 @@ void TR::CompilationInfo::queueEntry(TR_MethodToBeCompiled *entry)
 
    entry->_freeTag |= ENTRY_QUEUED;
 
-   if (!_methodQueue || _methodQueue->_priority < entry->_priority)
+   // The entry goes after the last entry with a priority greater or equal to its own
+   uint16_t priority = entry->_priority;
+   TR_MethodToBeCompiled *prev = NULL;
+   CompQueuePriorityTail *tail = findCompQueuePriorityTail(priority);
+   if (tail)
       {
-      entry->_next = _methodQueue;
-      _methodQueue = entry;
+      prev = tail->_entry;
       }
-   else
+   else if (_numQueuedWithoutPriorityTail == 0)
       {
-      for (TR_MethodToBeCompiled *prev = _methodQueue; ; prev = prev->_next)
+      // Every priority present in the queue has a tail; the closest higher priority gives the position
+      CompQueuePriorityTail *higher = NULL;
+      for (int32_t i = 0; i < COMP_QUEUE_MAX_PRIORITY_TAILS; i++)
          {
-         if (!prev->_next || prev->_next->_priority < entry->_priority)
+         CompQueuePriorityTail *crt = &_methodQueuePriorityTails[i];
+         if (crt->_entry && crt->_priority > priority && (!higher || crt->_priority < higher->_priority))
+            higher = crt;
+         }
+      if (higher)
+         prev = higher->_entry;
+      }
+   else if (_methodQueue && _methodQueue->_priority >= priority)
+      {
+      // Some priorities are not tracked; fall back to scanning the queue
+      for (prev = _methodQueue; prev->_next && prev->_next->_priority >= priority; prev = prev->_next)
+         {}
+      }
+
+   entry->_prev = prev;
+   entry->_next = prev ? prev->_next : _methodQueue;
+   if (entry->_next)
+      entry->_next->_prev = entry;
+   if (prev)
+      prev->_next = entry;
+   else
+      _methodQueue = entry;
+
+   if (!tail)
+      {
+      for (int32_t i = 0; i < COMP_QUEUE_MAX_PRIORITY_TAILS; i++)
+         if (!_methodQueuePriorityTails[i]._entry)
             {
-            entry->_next = prev->_next;
-            prev->_next = entry;
+            tail = &_methodQueuePriorityTails[i];
+            tail->_priority = priority;
+            tail->_numEntries = 0;
             break;
             }
+      }
+   if (tail)
+      {
+      tail->_entry = entry;
+      tail->_numEntries++;
+      entry->_hasQueuePriorityTail = true;
+      }
+   else
+      {
+      _numQueuedWithoutPriorityTail++;
+      entry->_hasQueuePriorityTail = false;
+      }
+
+#if defined(J9VM_OPT_JITSERVER)
+   // Out-of-process requests are also kept in arrival order for getNextOutOfProcessEntry()
+   if (entry->_stream)
+      {
+      entry->_prevArrived = _newestOutOfProcessEntry;
+      entry->_nextArrived = NULL;
+      if (_newestOutOfProcessEntry)
+         _newestOutOfProcessEntry->_nextArrived = entry;
+      else
+         _oldestOutOfProcessEntry = entry;
+      _newestOutOfProcessEntry = entry;
+      }
+#endif /* defined(J9VM_OPT_JITSERVER) */
+
+   // Index the entry by method. Placeholders queued by the JITServer do not have a method yet.
+   J9Method *method = entry->getMethodDetails().getMethod();
+   entry->_queueIndexKey = method;
+   if (method)
+      {
+      size_t bucket = compQueueIndexBucket(method);
+      entry->_nextInQueueIndex = _methodQueueIndex[bucket];
+      _methodQueueIndex[bucket] = entry;
+      }
+   }
+
+//--------------------------- dequeueEntry -------------------------------
+// Take the compilation request out of the queue. Accounting (number of
+// queued methods, queue weight) is left to the caller.
+// Must have compilationQueueMonitor in hand
+//------------------------------------------------------------------------
+void TR::CompilationInfo::dequeueEntry(TR_MethodToBeCompiled *entry)
+   {
+   CompQueuePriorityTail *tail = findCompQueuePriorityTail(entry->_priority);
+   if (entry->_hasQueuePriorityTail)
+      {
+      TR_ASSERT(tail && tail->_numEntries > 0, "Priority tail missing for queued entry %p", entry);
+      tail->_numEntries--;
+      }
+   else
+      {
+      _numQueuedWithoutPriorityTail--;
+      }
+   if (tail)
+      {
+      if (tail->_numEntries == 0)
+         {
+         tail->_entry = NULL; // free the slot
+         }
+      else if (tail->_entry == entry)
+         {
+         TR_ASSERT(entry->_prev && entry->_prev->_priority == entry->_priority, "Queue not ordered by priority");
+         tail->_entry = entry->_prev;
          }
       }
+
+   if (entry->_prev)
+      entry->_prev->_next = entry->_next;
+   else
+      _methodQueue = entry->_next;
+   if (entry->_next)
+      entry->_next->_prev = entry->_prev;
+
+   if (entry->_queueIndexKey)
+      {
+      TR_MethodToBeCompiled **link = &_methodQueueIndex[compQueueIndexBucket(entry->_queueIndexKey)];
+      while (*link != entry)
+         link = &(*link)->_nextInQueueIndex;
+      *link = entry->_nextInQueueIndex;
+      }
+
+#if defined(J9VM_OPT_JITSERVER)
+   if (entry->_stream)
+      {
+      if (entry->_prevArrived)
+         entry->_prevArrived->_nextArrived = entry->_nextArrived;
+      else
+         _oldestOutOfProcessEntry = entry->_nextArrived;
+      if (entry->_nextArrived)
+         entry->_nextArrived->_prevArrived = entry->_prevArrived;
+      else
+         _newestOutOfProcessEntry = entry->_prevArrived;
+      entry->_nextArrived = NULL;
+      entry->_prevArrived = NULL;
+      }
+#endif /* defined(J9VM_OPT_JITSERVER) */
+
+   entry->_next = NULL;
+   entry->_prev = NULL;
+   entry->_nextInQueueIndex = NULL;
+   entry->_queueIndexKey = NULL;
+   entry->_hasQueuePriorityTail = false;
+   }
+
+//------------------------ changeQueuedEntryPriority ---------------------
+// Raise the priority of a queued request and move it to its new place.
+// A request whose position is still correct keeps it: the entries ahead of
+// it already have a priority greater or equal to the new one.
+//------------------------------------------------------------------------
+void TR::CompilationInfo::changeQueuedEntryPriority(TR_MethodToBeCompiled *entry, uint16_t priority)
+   {
+   TR_ASSERT(entry->_priority <= priority, "Lowering the priority of a queued entry would break FIFO order");
+   if (entry->_priority == priority)
+      return;
+   dequeueEntry(entry);
+   entry->_priority = priority;
+   queueEntry(entry);
+   }
+
+TR::CompilationInfo::CompQueuePriorityTail *
+TR::CompilationInfo::findCompQueuePriorityTail(uint16_t priority)
+   {
+   for (int32_t i = 0; i < COMP_QUEUE_MAX_PRIORITY_TAILS; i++)
+      {
+      CompQueuePriorityTail *tail = &_methodQueuePriorityTails[i];
+      if (tail->_entry && tail->_priority == priority)
+         return tail;
+      }
+   return NULL;
+   }
+
+// Must hold compilation queue monitor in hand
+TR_MethodToBeCompiled *
+TR::CompilationInfo::findQueuedEntry(TR::IlGeneratorMethodDetails &details, TR_FrontEnd *fe)
+   {
+   J9Method *method = details.getMethod();
+   if (!method)
+      return NULL;
+   for (TR_MethodToBeCompiled *cur = _methodQueueIndex[compQueueIndexBucket(method)]; cur; cur = cur->_nextInQueueIndex)
+      if (cur->_queueIndexKey == method && cur->getMethodDetails().sameAs(details, fe))
+         return cur;
+   return NULL;
+   }
+
+// Must hold compilation queue monitor in hand
+TR_MethodToBeCompiled *
+TR::CompilationInfo::findQueuedNonDLTEntry(J9Method *method)
+   {
+   for (TR_MethodToBeCompiled *cur = _methodQueueIndex[compQueueIndexBucket(method)]; cur; cur = cur->_nextInQueueIndex)
+      if (cur->_queueIndexKey == method && !cur->isDLTCompile())
+         return cur;
+   return NULL;
    }
 
 //--------------------------------- requeue ----------------------------------
@@ -4961,12 +5184,7 @@ TR::CompilationInfo::adjustCompilationEntryAndRequeue(
       }
 
    // Search the queue for my method
-   TR_MethodToBeCompiled *cur, *prev;
-   for (prev = NULL, cur = _methodQueue; cur; prev = cur, cur = cur->_next)
-      {
-      if (cur->getMethodDetails().sameAs(details, fe))
-         break;
-      }
+   TR_MethodToBeCompiled *cur = findQueuedEntry(details, fe);
    if (cur)
       {
       // here define the list of exclusions
@@ -4983,17 +5201,9 @@ TR::CompilationInfo::adjustCompilationEntryAndRequeue(
          cur->_optimizationPlan->setInsertInstrumentation(useProfiling);
          methodInfo->setNextCompileLevel(newOptLevel, useProfiling);
 
+         // put it at its proper place
          if (cur->_priority < priority)
-            {
-            // take the method out
-            if (prev)
-               prev->_next = cur->_next;
-            else
-               _methodQueue = cur->_next;
-            // put it back at its proper place
-            cur->_priority = priority;
-            queueEntry(cur);
-            }
+            changeQueuedEntryPriority(cur, priority);
          }
       //fprintf(stderr, "Adjusting optimization plan in the queue\n");
       }
@@ -5018,50 +5228,25 @@ int32_t TR::CompilationInfo::promoteMethodInAsyncQueue(J9Method * method, void *
          }
       }
 
-   int i = 0;
-   TR_MethodToBeCompiled *cur, *prev;
-   for (prev = NULL, cur = _methodQueue; cur; prev = cur, cur = cur->_next)
-      {
-      if (!cur->isDLTCompile() && method == cur->getMethodDetails().getMethod())
-         break;
-      i++;
-      }
-
-   if (!cur || !prev || cur->_priority >= CP_ASYNC_MAX || prev->_priority >= CP_ASYNC_MAX)
-      return -i;
+   // The position of the entry in the queue is not known without walking the queue,
+   // so return 1 if the entry was promoted and -1 if it was not
+   TR_MethodToBeCompiled *cur = findQueuedNonDLTEntry(method);
+   if (!cur || !cur->_prev || cur->_priority >= CP_ASYNC_MAX || cur->_prev->_priority >= CP_ASYNC_MAX)
+      return -1;
    changeCompThreadPriority(J9THREAD_PRIORITY_MAX, 9);
    _statNumQueuePromotions++;
 #ifdef STATS
    fprintf(stderr, "Promoting method in queue QSZ=%d\n", getMethodQueueSize());
 #endif
-   cur->_priority = CP_ASYNC_MAX;
-
-   // take the method out
-   prev->_next = cur->_next;
-   // find insertion point
-   if (_methodQueue->_priority < CP_ASYNC_MAX) // common case
-      {
-      cur->_next = _methodQueue;
-      _methodQueue = cur;
-      // FIXME: how about the compilation lag
-      }
-   else
-      {
-      for (prev = _methodQueue; prev->_next; prev = prev->_next)
-         if (prev->_next->_priority < CP_ASYNC_MAX)
-            {
-            cur->_next = prev->_next;
-            prev->_next = cur;
-            break;
-            }
-      }
-   return i;
+   // FIXME: how about the compilation lag
+   changeQueuedEntryPriority(cur, CP_ASYNC_MAX);
+   return 1;
    }
 
 void TR::CompilationInfo::changeCompReqFromAsyncToSync(J9Method * method)
    {
 
-   TR_MethodToBeCompiled *cur = NULL, *prev = NULL;
+   TR_MethodToBeCompiled *cur = NULL;
    // See if the method is already in the queue or is already being compiled
    //
    for (uint8_t i = 0; i < getNumUsableCompilationThreads(); i++)
@@ -5083,25 +5268,14 @@ void TR::CompilationInfo::changeCompReqFromAsyncToSync(J9Method * method)
       }
    if (!cur)
       {
-      for (cur = _methodQueue; cur; prev = cur, cur = cur->_next)
-         if (!cur->isDLTCompile() && method == cur->getMethodDetails().getMethod())
-            break;
+      cur = findQueuedNonDLTEntry(method);
       // Check if this is an asynchronous request
       //
       if (cur && cur->_priority <= CP_ASYNC_MAX)
          {
-         // Take the method out, increase its priority and insert it at the proper place
+         // Increase its priority and move it to the proper place
          //
-         cur->_priority = CP_SYNC_NORMAL;
-         if (prev)
-            {
-            prev->_next = cur->_next;
-            queueEntry(cur);
-            }
-         else // method already at the top of the queue
-            {
-            // Nothing to do
-            }
+         changeQueuedEntryPriority(cur, CP_SYNC_NORMAL);
          }
       else
          {
@@ -5139,10 +5313,7 @@ TR_MethodToBeCompiled * TR::CompilationInfo::requestExistsInCompilationQueue(TR:
          return curCompThreadInfoPT->getMethodBeingCompiled();
       }
 
-   for (TR_MethodToBeCompiled *cur = _methodQueue; cur; cur = cur->_next)
-      if (cur->getMethodDetails().sameAs(details, fe))
-         return cur;
-   return NULL;
+   return findQueuedEntry(details, fe);
    }
 
 TR_MethodToBeCompiled *TR::CompilationInfo::peekNextMethodToBeCompiled()
@@ -5174,17 +5345,20 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
    *compThreadAction = PROCESS_ENTRY;
    if (_methodQueue)
       {
+#if defined(J9VM_OPT_JITSERVER)
+      if (getPersistentInfo()->getRemoteCompilationMode() == JITServer::SERVER) // compile right away in server mode
+         {
+         m = getNextOutOfProcessEntry();
+         }
+      else
+#endif
       // If the request is sync or AOT load or InstantReplay, take it now
       if (compInfoPT->isDiagnosticThread() // InstantReplay compilations must be processed immediately
           || _methodQueue->_priority >= CP_SYNC_MIN // sync comp
-          || _methodQueue->_methodIsInSharedCache == TR_yes // very cheap relocation
-#if defined(J9VM_OPT_JITSERVER)
-          || getPersistentInfo()->getRemoteCompilationMode() == JITServer::SERVER // compile right away in server mode
-#endif
-         )
+          || _methodQueue->_methodIsInSharedCache == TR_yes) // very cheap relocation
          {
          m = _methodQueue;
-         _methodQueue = _methodQueue->_next;
+         dequeueEntry(m);
          }
       // Check if we need to throttle
       else if (exceedsCompCpuEntitlement() == TR_yes &&
@@ -5203,18 +5377,17 @@ TR::CompilationInfo::getNextMethodToBeCompiled(TR::CompilationInfoPerThread *com
                _methodQueue->_weight < TR::Options::_expensiveCompWeight) // This is a cheaper comp
          {
          m = _methodQueue;
-         _methodQueue = _methodQueue->_next;
+         dequeueEntry(m);
          }
       else // scan for a cold/warm method
          {
-         TR_MethodToBeCompiled *prev = _methodQueue;
-         for (m = _methodQueue->_next; m; prev = m, m = m->_next)
+         for (m = _methodQueue->_next; m; m = m->_next)
             {
             if (m->_optimizationPlan->getOptLevel() <= warm || // cheaper comp
                 m->_priority >= CP_SYNC_MIN ||       // sync comp
                 m->_methodIsInSharedCache == TR_yes) // very cheap relocation
                {
-               prev->_next = m->_next;
+               dequeueEntry(m);
                break;
                }
             }
@@ -6128,21 +6301,9 @@ void *TR::CompilationInfo::compileOnSeparateThread(J9VMThread * vmThread, TR::Il
          changeCompReqFromAsyncToSync(method);
       else
          {
-         TR_MethodToBeCompiled *reqMe, *prevReq;
-         for (prevReq=NULL, reqMe=_methodQueue; reqMe; prevReq = reqMe, reqMe = reqMe->_next)
-            {
-            if (!reqMe->isDLTCompile() && reqMe->getMethodDetails().getMethod() == method)
-               break;
-            }
+         TR_MethodToBeCompiled *reqMe = findQueuedNonDLTEntry(method);
          if (reqMe && reqMe->_priority<CP_ASYNC_ABOVE_NORMAL)
-            {
-            reqMe->_priority = CP_ASYNC_ABOVE_NORMAL;
-            if (prevReq && prevReq->_priority<CP_ASYNC_ABOVE_NORMAL)
-               {
-               prevReq->_next = reqMe->_next;
-               queueEntry(reqMe);
-               }
-            }
+            changeQueuedEntryPriority(reqMe, CP_ASYNC_ABOVE_NORMAL);
          }
       }
 #endif // J9VM_JIT_DYNAMIC_LOOP_TRANSFER
@@ -12049,7 +12210,7 @@ void TR_LowPriorityCompQueue::tryToScheduleCompilation(J9VMThread *vmThread, J9M
                                 (activate == TR_maybe &&
                                  TR::Options::getCmdLineOptions()->getOption(TR_ConcurrentLPQ) &&
                                  jitConfig->javaVM->phase == J9VM_PHASE_NOT_STARTUP && // ConcurrentLPQ is too damaging to startup
-                                 _compInfo->getNumCompThreadsActive() + 2 < _compInfo->getNumTargetCPUs()
+                                 _compInfo->getNumCompThreadsActive() + 2 < _compInfo->getNumEntitledCPUs()
                                 )
                               )
                               {
@@ -12907,9 +13068,12 @@ TR::CompilationInfo::addOutOfProcessMethodToBeCompiled(JITServer::ServerStream *
    TR_MethodToBeCompiled *entry = getCompilationQueueEntry(); // Allocate a new entry
    if (entry)
       {
-      // Initialize the entry with defaults (some, like methodDetails, are bogus)
+      // Initialize the entry with defaults (some, like methodDetails, are bogus).
+      // The priority assigned by the client is used for scheduling if the header
+      // of the request is already available; it is overwritten once the request is read.
       TR::IlGeneratorMethodDetails details;
-      entry->initialize(details, NULL, CP_SYNC_NORMAL, NULL);
+      int32_t priority = stream->peekCompilationRequestPriority();
+      entry->initialize(details, NULL, (priority != JITServer::ServerStream::UNKNOWN_PRIORITY) ? (CompilationPriority)priority : CP_ASYNC_NORMAL, NULL);
       entry->_entryTime = getPersistentInfo()->getElapsedTime(); // Cheaper version
       entry->_stream = stream; // Add the stream to the entry
       incrementMethodQueueSize(); // One more method added to the queue
@@ -12953,6 +13117,79 @@ TR::CompilationInfo::addOutOfProcessMethodToBeCompiled(JITServer::ServerStream *
    return entry;
    }
 
+// Server-side choice of the next request. A client numbers its requests and the server
+// processes them in that order (see waitForMyTurn), so requests are only reordered across
+// clients: the candidates are the oldest queued request of each client, found by walking
+// the queued requests in arrival order. Among the candidates with the highest priority (as
+// assigned by the clients), take the one from the client with the fewest compilations in
+// progress, so that a client flooding the server (e.g. with cold requests at startup) gets
+// at most its share of the compilation threads. The oldest request overall is taken first
+// if it waited longer than JITSERVER_MAX_QUEUE_WAIT_MS, so that low priority requests are
+// not starved. Must be called with the compilation monitor in hand.
+TR_MethodToBeCompiled *
+TR::CompilationInfo::getNextOutOfProcessEntry()
+   {
+   // Requests that are not tied to a client connection (e.g. to stop a compilation thread) go first
+   TR_MethodToBeCompiled *best = _methodQueue->_stream ? _oldestOutOfProcessEntry : _methodQueue;
+   if (best && best->_stream &&
+       (getPersistentInfo()->getElapsedTime() - best->_entryTime < JITSERVER_MAX_QUEUE_WAIT_MS))
+      {
+      static const int32_t MAX_CANDIDATE_CLIENTS = 64;
+      uint64_t candidateClients[MAX_CANDIDATE_CLIENTS];
+      int32_t numCandidateClients = 0;
+      int32_t bestLoad = INT_MAX;
+      best = NULL;
+      for (TR_MethodToBeCompiled *cur = _oldestOutOfProcessEntry; cur; cur = cur->_nextArrived)
+         {
+         // Connections that did not carry a request yet belong to new clients, which must not wait
+         uint64_t clientUID = cur->_stream->getClientId();
+         if (clientUID)
+            {
+            bool isOldestOfClient = true;
+            for (int32_t i = 0; i < numCandidateClients; i++)
+               {
+               if (candidateClients[i] == clientUID)
+                  {
+                  isOldestOfClient = false;
+                  break;
+                  }
+               }
+            if (!isOldestOfClient)
+               continue;
+            if (numCandidateClients == MAX_CANDIDATE_CLIENTS)
+               break;
+            candidateClients[numCandidateClients++] = clientUID;
+            }
+
+         if (best && (cur->_priority < best->_priority))
+            continue;
+         int32_t load = clientUID ? getNumCompilationsInProgressForClient(clientUID) : 0;
+         if (!best || (cur->_priority > best->_priority) || (load < bestLoad))
+            {
+            best = cur;
+            bestLoad = load;
+            }
+         }
+      }
+
+   dequeueEntry(best);
+   return best;
+   }
+
+// Must be called with the compilation monitor in hand
+int32_t
+TR::CompilationInfo::getNumCompilationsInProgressForClient(uint64_t clientUID)
+   {
+   int32_t numCompilations = 0;
+   for (uint8_t i = 0; i < getNumUsableCompilationThreads(); i++)
+      {
+      TR_MethodToBeCompiled *entry = _arrayOfCompilationInfoPerThread[i]->getMethodBeingCompiled();
+      if (entry && entry->_stream && entry->_stream->getClientId() == clientUID)
+         numCompilations++;
+      }
+   return numCompilations;
+   }
+
 void
 TR::CompilationInfo::requeueOutOfProcessEntry(TR_MethodToBeCompiled *entry)
    {
@@ -12963,7 +13200,17 @@ TR::CompilationInfo::requeueOutOfProcessEntry(TR_MethodToBeCompiled *entry)
    if (feGetEnv("TR_EnableJITServerPerCompConn"))
       return;
 
-   if (entry->_stream && addOutOfProcessMethodToBeCompiled(entry->_stream))
+   if (!entry->_stream)
+      return;
+
+   // Hand idle connections back to the listener so that they do not occupy a compilation
+   // thread until the client sends its next request. If the listener cannot take the connection
+   // (e.g. bytes of the next request were already read) queue it as before.
+   TR_Listener *listener = ((TR_JitPrivateConfig*)_jitConfig->privateConfig)->listener;
+   if (listener && listener->parkConnection(entry->_stream))
+      return;
+
+   if (addOutOfProcessMethodToBeCompiled(entry->_stream))
       {
       // successfully queued the new entry, so notify a thread
       getCompilationMonitor()->notifyAll();
@@ -543,16 +543,16 @@ IDATA J9VMDllMain(J9JavaVM* vm, IDATA stage, void * reserved)
             if (!fe->isAOT_DEPRECATED_DO_NOT_USE())
                TR_AnnotationBase::loadExpectedAnnotationClasses(curThread);
 
-            // Also set name for interpreter profiler thread if it exists
+            // Also set name for interpreter profiler threads if they exist
 #if defined (J9VM_INTERP_PROFILING_BYTECODES)
             TR_IProfiler *iProfiler = fe->getIProfiler();
-            if (iProfiler)
+            for (int32_t i = 0; iProfiler && i < iProfiler->getNumParserThreads(); i++)
                {
-               J9VMThread *iProfilerThread = iProfiler->getIProfilerThread();
+               J9VMThread *iProfilerThread = iProfiler->getParserThread(i);
                if (iProfilerThread)
                   {
                   vm->internalVMFunctions->initializeAttachedThread
-                      (curThread, "IProfiler", vm->systemThreadGroupRef,
+                      (curThread, (i == 0) ? "IProfiler" : "IProfiler Helper", vm->systemThreadGroupRef,
                       ((iProfilerThread->privateFlags & J9_PRIVATE_FLAGS_DAEMON_THREAD) != 0),
                       iProfilerThread);
                   if ((curThread->currentException != NULL) || (curThread->threadObject == NULL))
@@ -4098,6 +4098,9 @@ void JitShutdown(J9JITConfig * jitConfig)
       stopInterpreterProfiling(jitConfig);
       if (!options->getOption(TR_DisableIProfilerThread))
          iProfiler->stopIProfilerThread();
+      // Save the profiling data for the next run while the hash table is still complete
+      if (vmThread)
+         iProfiler->writeSnapshot(vmThread);
 #ifdef DEBUG
       uint32_t lockedEntries = iProfiler->releaseAllEntries();
       TR_ASSERT(lockedEntries == 0, "some entries were still locked on shutdown");
@@ -5676,6 +5679,7 @@ static int32_t J9THREAD_PROC samplerThreadProc(void * entryarg)
    uint64_t lastProcNumCheck = 0;
    bool idleMode = false;
    uint64_t lastMinuteCheck = 0; // for activities that need to be done rarely (every minute)
+   uint64_t lastIProfilerSnapshotTime = 0;
    // initialize the startTime and elapsedTime here
    PORT_ACCESS_FROM_JAVAVM(vm);
 
@@ -5777,6 +5781,8 @@ static int32_t J9THREAD_PROC samplerThreadProc(void * entryarg)
          {
          TR_VerboseLog::writeLine(TR_Vlog_INFO, "CPU entitlement = %3.2f", compInfo->getJvmCpuEntitlement());
          }
+      if (compInfo->getCgroupCpuEntitlement() > 0)
+         TR_VerboseLog::writeLine(TR_Vlog_INFO, "cgroup CPU quota = %3.2f", compInfo->getCgroupCpuEntitlement());
       TR_VerboseLog::vlogRelease();
       } // if (TR::Options::isAnyVerboseOptionSet())
 
@@ -5914,7 +5920,20 @@ static int32_t J9THREAD_PROC samplerThreadProc(void * entryarg)
                         scc->numROMClasses, scc->numAOTMethods, fe->sharedCache()->getSharedCacheDisabledReason());
                   }
 #endif
+
+               if (TR::CodeCacheManager::instance()->codeCacheConfig().verboseCodeCache())
+                  TR::CodeCacheManager::instance()->reportFreeSpaceStats("periodic");
                } // Default: Every minute
+
+#if defined(J9VM_INTERP_PROFILING_BYTECODES)
+            if (TR::Options::_iprofilerSnapshotPeriod > 0 &&
+                crtTime - lastIProfilerSnapshotTime >= (uint64_t)TR::Options::_iprofilerSnapshotPeriod * 1000)
+               {
+               lastIProfilerSnapshotTime = crtTime;
+               if (TR_IProfiler *iProfiler = fe->getIProfiler())
+                  iProfiler->writeSnapshot(samplerThread);
+               }
+#endif
             } // every 100 ms
 
          //classLoadPhaseReanalyzed = classLoadPhaseLogic(jitConfig, compInfo);  // moved down
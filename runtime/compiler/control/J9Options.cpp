@@ -147,6 +147,9 @@ int32_t J9::Options::_iprofilerReactivateThreshold=10;
 int32_t J9::Options::_iprofilerIntToTotalSampleRatio=2;
 int32_t J9::Options::_iprofilerSamplesBeforeTurningOff = 1000000; // samples
 int32_t J9::Options::_iprofilerNumOutstandingBuffers = 10;
+int32_t J9::Options::_iprofilerNumHelperThreads = -1;
+int32_t J9::Options::_iprofilerNumExtendedCallSiteSlots = 5; // at most NUM_EXTENDED_CS_SLOTS
+int32_t J9::Options::_iprofilerSnapshotPeriod = 0; // seconds; 0 means write the snapshot only at shutdown
 int32_t J9::Options::_iprofilerBufferMaxPercentageToDiscard = 0;
 int32_t J9::Options::_iProfilerBufferInterarrivalTimeToExitDeepIdle = 5000; // 5 seconds
 int32_t J9::Options::_iprofilerBufferSize = 1024;
@@ -246,7 +249,10 @@ int32_t J9::Options::_profileAllTheTime = 0;
 int32_t J9::Options::_seriousCompFailureThreshold = 10; // above this threshold we generate a trace point in the Snap file
 
 bool J9::Options::_useCPUsToDetermineMaxNumberOfCompThreadsToActivate = false;
+int32_t J9::Options::_compQueueWaitTargetMs = 0; // 0 means comp threads are activated based on queue weight
 int32_t J9::Options::_numCodeCachesToCreateAtStartup = 0; // 0 means no change from default which is 1
+int32_t J9::Options::_minFreeCodeCacheBlockToResumeCompilations = 2048; // bytes; 0 resumes compilations after any reclamation
+int32_t J9::Options::_hotCodeCacheKB = -1; // -1 means the size of a regular code cache
 
 int32_t J9::Options::_dataCacheQuantumSize = 64;
 int32_t J9::Options::_dataCacheMinQuanta = 2;
@@ -730,6 +736,9 @@ TR::OptionTable OMR::Options::_feOptions[] = {
    {"compilationYieldStatsThreshold=", "M<nnn>\tprint stats about compilation yield points if the "
                                        "threshold is exceeded. Default 1000 usec. ",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compYieldStatsThreshold, 0, "F%d", NOT_IN_SUBSET},
+   {"compQueueWaitTargetMs=", "M<nnn>\tTarget for the average time (ms) a request waits in the compilation queue. "
+                              "Compilation threads are activated above it and suspended well below it. Default 0 (disabled)",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compQueueWaitTargetMs, 0, "F%d", NOT_IN_SUBSET},
    {"compThreadPriority=",    "M<nnn>\tThe priority of the compilation thread. "
                               "Use an integer between 0 and 4. Default is 4 (highest priority)",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_compilationThreadPriorityCode, 0, "F%d", NOT_IN_SUBSET},
@@ -824,6 +833,9 @@ TR::OptionTable OMR::Options::_feOptions[] = {
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_hwprofilerZRIRGS, 0, "F%d", NOT_IN_SUBSET},
    {"HWProfilerZRISF=",               "O<nnn>\tZ RI Scaling Factor",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_hwprofilerZRISF, 0, "F%d", NOT_IN_SUBSET},
+   {"hotCodeCacheKB=", "R<nnn>\tsize in KB of the code cache that hot and scorching method bodies are placed in. "
+                       "0 disables the hot code cache; -1 (default) uses the size of a regular code cache",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_hotCodeCacheKB, 0, "F%d", NOT_IN_SUBSET},
    {"inlinefile=",        "D<filename>\tinline filter defined in filename.  "
                           "Use inlinefile=filename", TR::Options::inlinefileOption, 0, 0, "F%s"},
    {"interpreterSamplingDivisor=",    "R<nnn>\tThe divisor used to decrease the invocation count when an interpreted method is sampled",
@@ -855,6 +867,12 @@ TR::OptionTable OMR::Options::_feOptions[] = {
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_maxIprofilingCountInStartupMode, 0, "F%d", NOT_IN_SUBSET},
    {"iprofilerMemoryConsumptionLimit=",    "O<nnn>\tlimit on memory consumption for interpreter profiling data",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iProfilerMemoryConsumptionLimit, 0, "P%d", NOT_IN_SUBSET},
+   {"iprofilerNumExtendedCallSiteSlots=", "O<nnn>\tnumber of receiver classes tracked, in addition to the usual 3, "
+                                          "at call sites that see more receivers (at most 5). Specify 0 to disable",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iprofilerNumExtendedCallSiteSlots, 0, "F%d", NOT_IN_SUBSET},
+   {"iprofilerNumHelperThreads=", "O<nnn>\tnumber of threads that help the IProfiler thread "
+                                  "parse interpreter profiling buffers (at most 3)",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iprofilerNumHelperThreads, 0, "F%d", NOT_IN_SUBSET},
    {"iprofilerNumOutstandingBuffers=", "O<nnn>\tnumber of outstanding interpreter profiling buffers "
                                        "allowed in the system. Specify 0 to disable this optimization",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iprofilerNumOutstandingBuffers, 0, "F%d", NOT_IN_SUBSET},
@@ -866,6 +884,12 @@ TR::OptionTable OMR::Options::_feOptions[] = {
                                 "needs to be taken after the profiling starts going off to completely turn it off. "
                                 "Specify a very large value to disable this optimization",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iprofilerSamplesBeforeTurningOff, 0, "P%d", NOT_IN_SUBSET},
+   {"iprofilerSnapshotFile=", "O<filename>\tfile from which interpreter profiling data saved by a previous run is loaded, "
+                              "and to which the data of this run is saved at shutdown",
+        TR::Options::setStringForPrivateBase, offsetof(TR_JitPrivateConfig,iprofilerSnapshotFileName), 0, "P%s"},
+   {"iprofilerSnapshotPeriod=", "O<nnn>\tin seconds; also save interpreter profiling data to the snapshot file "
+                                "periodically while the application runs. 0 means only at shutdown",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_iprofilerSnapshotPeriod, 0, "F%d", NOT_IN_SUBSET},
    {"itFileNamePrefix=",  "L<filename>\tprefix for itrace filename",
         TR::Options::setStringForPrivateBase, offsetof(TR_JitPrivateConfig,itraceFileNamePrefix), 0, "P%s"},
    {"jProfilingEnablementSampleThreshold=", "M<nnn>\tNumber of global samples to allow generation of JProfiling bodies",
@@ -897,6 +921,8 @@ TR::OptionTable OMR::Options::_feOptions[] = {
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_maxCheckcastProfiledClassTests, 0, "%d", NOT_IN_SUBSET},
    {"maxOnsiteCacheSlotForInstanceOf=", "R<nnn>\tnumber of onsite cache slots for instanceOf",
       TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_maxOnsiteCacheSlotForInstanceOf, 0, "%d", NOT_IN_SUBSET},
+   {"minFreeCodeCacheBlockToResumeCompilations=", "R<nnn>\tsize in bytes of the largest free code cache block needed to resume compilations after the code cache was full",
+        TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_minFreeCodeCacheBlockToResumeCompilations, 0, "F%d", NOT_IN_SUBSET},
    {"minSamplingPeriod=", "R<nnn>\tminimum number of milliseconds between samples for hotness",
         TR::Options::setStaticNumeric, (intptr_t)&TR::Options::_minSamplingPeriod, 0, "P%d", NOT_IN_SUBSET},
    {"minSuperclassArraySize=", "I<nnn>\t set the size of the minimum superclass array size",
@@ -1083,6 +1109,21 @@ static std::string readFileToString(char *fileName)
       return "";
    }
 
+// Options that change the code generated for a method; clients that use a shared
+// AOT cache at the server must agree on them. The server adds the compressed refs
+// shift and the processor description of the client to the identity.
+static bool isJITServerAOTCacheRelevantOption(const char *option)
+   {
+   static const char * const prefixes[] = { "-Xjit", "-Xaot", "-Xnojit", "-Xnoaot", "-Xgcpolicy", "-Xshareclasses",
+                                            "-Xcompressedrefs", "-Xnocompressedrefs", "-XX:+CompactStrings", "-XX:-CompactStrings" };
+   for (size_t i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); ++i)
+      {
+      if (!strncmp(option, prefixes[i], strlen(prefixes[i])))
+         return true;
+      }
+   return false;
+   }
+
 static void JITServerParseCommonOptions(J9JavaVM *vm, TR::CompilationInfo *compInfo)
    {
    const char *xxJITServerPortOption = "-XX:JITServerPort=";
@@ -1090,12 +1131,32 @@ static void JITServerParseCommonOptions(J9JavaVM *vm, TR::CompilationInfo *compI
    const char *xxJITServerSSLKeyOption = "-XX:JITServerSSLKey=";
    const char *xxJITServerSSLCertOption = "-XX:JITServerSSLCert=";
    const char *xxJITServerSSLRootCertsOption = "-XX:JITServerSSLRootCerts=";
+   const char *xxJITServerCompressionOption = "-XX:+JITServerCompression";
+   const char *xxDisableJITServerCompressionOption = "-XX:-JITServerCompression";
+   const char *xxJITServerCompressionThresholdOption = "-XX:JITServerCompressionThreshold=";
+   const char *xxJITServerShareROMClassesOption = "-XX:+JITServerShareROMClasses";
+   const char *xxDisableJITServerShareROMClassesOption = "-XX:-JITServerShareROMClasses";
+   const char *xxJITServerPrefetchClassesOption = "-XX:JITServerPrefetchClasses=";
+   const char *xxJITServerUseAOTCacheOption = "-XX:+JITServerUseAOTCache";
+   const char *xxDisableJITServerUseAOTCacheOption = "-XX:-JITServerUseAOTCache";
+   const char *xxJITServerAOTCacheNameOption = "-XX:JITServerAOTCacheName=";
+   const char *xxJITServerAOTCacheMaxBytesOption = "-XX:JITServerAOTCacheMaxBytes=";
 
    int32_t xxJITServerPortArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerPortOption, 0);
    int32_t xxJITServerTimeoutArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerTimeoutOption, 0);
    int32_t xxJITServerSSLKeyArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerSSLKeyOption, 0);
    int32_t xxJITServerSSLCertArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerSSLCertOption, 0);
    int32_t xxJITServerSSLRootCertsArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerSSLRootCertsOption, 0);
+   int32_t xxJITServerCompressionArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerCompressionOption, 0);
+   int32_t xxDisableJITServerCompressionArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxDisableJITServerCompressionOption, 0);
+   int32_t xxJITServerCompressionThresholdArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerCompressionThresholdOption, 0);
+   int32_t xxJITServerShareROMClassesArgIndex = FIND_ARG_IN_VMARGS(EXACT_MATCH, xxJITServerShareROMClassesOption, 0);
+   int32_t xxDisableJITServerShareROMClassesArgIndex = FIND_ARG_IN_VMARGS(EXACT_MATCH, xxDisableJITServerShareROMClassesOption, 0);
+   int32_t xxJITServerPrefetchClassesArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerPrefetchClassesOption, 0);
+   int32_t xxJITServerUseAOTCacheArgIndex = FIND_ARG_IN_VMARGS(EXACT_MATCH, xxJITServerUseAOTCacheOption, 0);
+   int32_t xxDisableJITServerUseAOTCacheArgIndex = FIND_ARG_IN_VMARGS(EXACT_MATCH, xxDisableJITServerUseAOTCacheOption, 0);
+   int32_t xxJITServerAOTCacheNameArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerAOTCacheNameOption, 0);
+   int32_t xxJITServerAOTCacheMaxBytesArgIndex = FIND_ARG_IN_VMARGS(STARTSWITH_MATCH, xxJITServerAOTCacheMaxBytesOption, 0);
 
    if (xxJITServerPortArgIndex >= 0)
       {
@@ -1113,6 +1174,72 @@ static void JITServerParseCommonOptions(J9JavaVM *vm, TR::CompilationInfo *compI
          compInfo->getPersistentInfo()->setSocketTimeout(timeoutMs);
       }
 
+   // Compression of messages is negotiated per connection: the client requests it
+   // with -XX:+JITServerCompression and the server accepts unless -XX:-JITServerCompression is given
+   if (xxJITServerCompressionArgIndex > xxDisableJITServerCompressionArgIndex)
+      compInfo->getPersistentInfo()->setJITServerUseCompression(true);
+   else if (xxDisableJITServerCompressionArgIndex > xxJITServerCompressionArgIndex)
+      compInfo->getPersistentInfo()->setJITServerUseCompression(false);
+
+   if (xxJITServerCompressionThresholdArgIndex >= 0)
+      {
+      uint32_t threshold = 0;
+      IDATA ret = GET_INTEGER_VALUE(xxJITServerCompressionThresholdArgIndex, xxJITServerCompressionThresholdOption, threshold);
+      if (ret == OPTION_OK)
+         compInfo->getPersistentInfo()->setJITServerCompressionThreshold(threshold);
+      }
+
+   // Only meaningful at the server, where sharing is enabled by default
+   if (xxJITServerShareROMClassesArgIndex > xxDisableJITServerShareROMClassesArgIndex)
+      compInfo->getPersistentInfo()->setJITServerShareROMClasses(true);
+   else if (xxDisableJITServerShareROMClassesArgIndex > xxJITServerShareROMClassesArgIndex)
+      compInfo->getPersistentInfo()->setJITServerShareROMClasses(false);
+
+   // Only meaningful at the client; 0 disables sending classes ahead of the compilation
+   if (xxJITServerPrefetchClassesArgIndex >= 0)
+      {
+      uint32_t maxClasses = 0;
+      IDATA ret = GET_INTEGER_VALUE(xxJITServerPrefetchClassesArgIndex, xxJITServerPrefetchClassesOption, maxClasses);
+      if (ret == OPTION_OK)
+         compInfo->getPersistentInfo()->setJITServerMaxPrefetchedClasses(maxClasses);
+      }
+
+   // Disabled by default at both the client and the server
+   if (xxJITServerUseAOTCacheArgIndex > xxDisableJITServerUseAOTCacheArgIndex)
+      {
+      compInfo->getPersistentInfo()->setJITServerUseAOTCache(true);
+
+      // Clients that announce the same identity share the AOT bodies cached at the server
+      std::string identity;
+      if (xxJITServerAOTCacheNameArgIndex >= 0)
+         {
+         char *name = NULL;
+         GET_OPTION_VALUE(xxJITServerAOTCacheNameArgIndex, '=', &name);
+         identity = name;
+         }
+      identity.push_back('\0');
+      JavaVMInitArgs *vmArgs = vm->vmArgsArray->actualVMArgs;
+      for (jint i = 0; i < vmArgs->nOptions; ++i)
+         {
+         const char *option = vmArgs->options[i].optionString;
+         if (isJITServerAOTCacheRelevantOption(option))
+            {
+            identity += option;
+            identity.push_back('\n');
+            }
+         }
+      compInfo->getPersistentInfo()->setJITServerAOTCacheIdentity(identity);
+      }
+
+   // Only meaningful at the server; limits the memory used by all AOT caches together
+   if (xxJITServerAOTCacheMaxBytesArgIndex >= 0)
+      {
+      UDATA maxBytes = 0;
+      IDATA ret = GET_MEMORY_VALUE(xxJITServerAOTCacheMaxBytesArgIndex, xxJITServerAOTCacheMaxBytesOption, maxBytes);
+      if (ret == OPTION_OK)
+         compInfo->getPersistentInfo()->setJITServerAOTCacheMaxBytes(maxBytes);
+      }
+
    // key and cert have to be set as a pair at the server
    if ((xxJITServerSSLKeyArgIndex >= 0) && (xxJITServerSSLCertArgIndex >= 0))
       {
@@ -1999,6 +2126,9 @@ J9::Options::fePreProcess(void * base)
          // Increase the default timeout value for JITServer.
          // It can be overridden with -XX:JITServerTimeout= option in JITServerParseCommonOptions().
          compInfo->getPersistentInfo()->setSocketTimeout(30000);
+         // The server accepts compression requests from clients by default.
+         // It can be overridden with -XX:-JITServerCompression option in JITServerParseCommonOptions().
+         compInfo->getPersistentInfo()->setJITServerUseCompression(true);
          }
       else
          {
@@ -2071,6 +2201,12 @@ J9::Options::fePreProcess(void * base)
    self()->setOption(TR_EnableSymbolValidationManager);
 #endif
 
+   // Validate the class chain of a class once per run rather than once per
+   // AOT load that refers to it; the cached result is reset on redefinition
+   static char *disableClassChainValidationCaching = feGetEnv("TR_DisableClassChainValidationCaching");
+   if (!disableClassChainValidationCaching)
+      self()->setOption(TR_EnableClassChainValidationCaching);
+
    return true;
    }
 
@@ -2221,6 +2357,14 @@ J9::Options::fePostProcessJIT(void * base)
                                                           // negative when we multiply by loadFactor
    jitConfig->samplingFrequency = _samplingFrequency;
 
+   // The hot code cache is carved out of the code cache repository like any other cache
+   if (_hotCodeCacheKB < -1 || (_hotCodeCacheKB > 0 && (UDATA)_hotCodeCacheKB > jitConfig->codeCacheTotalKB))
+      {
+      j9tty_printf(PORTLIB, "<JIT: hotCodeCacheKB must be between -1 and the total code cache size (%u KB); using the default>\n",
+                   (uint32_t)jitConfig->codeCacheTotalKB);
+      _hotCodeCacheKB = -1;
+      }
+
    // grab vLogFileName from jitConfig and put into jitPrivateConfig, where it will be found henceforth
    TR_JitPrivateConfig *privateConfig = (TR_JitPrivateConfig*)jitConfig->privateConfig;
    privateConfig->vLogFileName = jitConfig->vLogFileName;
@@ -178,6 +178,9 @@ class OMR_EXTENSIBLE Options : public OMR::OptionsConnector
    static int32_t _iprofilerIntToTotalSampleRatio;
    static int32_t _iprofilerSamplesBeforeTurningOff;
    static int32_t _iprofilerNumOutstandingBuffers;
+   static int32_t _iprofilerNumHelperThreads; // -1 means chosen from the number of CPUs
+   static int32_t _iprofilerNumExtendedCallSiteSlots;
+   static int32_t _iprofilerSnapshotPeriod; // seconds
    static int32_t _iprofilerBufferMaxPercentageToDiscard;
    static int32_t _iProfilerBufferInterarrivalTimeToExitDeepIdle; // ms
    static int32_t _iprofilerBufferSize; //iprofilerbuffer size in kb
@@ -199,9 +202,12 @@ class OMR_EXTENSIBLE Options : public OMR::OptionsConnector
    static int32_t _profileAllTheTime;
    static int32_t _seriousCompFailureThreshold; // above this threshold we generate a trace point in the Snap file
    static bool _useCPUsToDetermineMaxNumberOfCompThreadsToActivate;
+   static int32_t _compQueueWaitTargetMs; // activate/suspend comp threads to keep the average queue wait near this; 0 disables
 
    static int32_t _numCodeCachesToCreateAtStartup;
    static int32_t getNumCodeCachesToCreateAtStartup() { return _numCodeCachesToCreateAtStartup; }
+   static int32_t _minFreeCodeCacheBlockToResumeCompilations; // bytes; smaller reclaimed blocks do not clear the code cache full flag
+   static int32_t _hotCodeCacheKB; // size of the code cache for hot and scorching bodies; 0 disables it, -1 means codeCacheKB
 
    static int32_t _dataCacheQuantumSize;
    static int32_t _dataCacheMinQuanta;
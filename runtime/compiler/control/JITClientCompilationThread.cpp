@@ -20,6 +20,8 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <algorithm>
+
 #include "codegen/CodeGenerator.hpp"
 #include "codegen/PicHelpers.hpp"
 #include "control/CompilationRuntime.hpp"
@@ -28,18 +30,21 @@
 #include "control/MethodToBeCompiled.hpp"
 #include "env/ClassTableCriticalSection.hpp"
 #include "env/J2IThunk.hpp"
+#include "env/J9SharedCache.hpp"
 #include "env/j9methodServer.hpp"
 #include "env/JITServerPersistentCHTable.hpp"
 #include "env/ut_j9jit.h"
 #include "env/VMAccessCriticalSection.hpp"
 #include "env/VMJ9.h"
 #include "env/VerboseLog.hpp"
+#include "ilgen/J9ByteCodeIterator.hpp"
 #include "net/ClientStream.hpp"
 #include "optimizer/J9TransformUtil.hpp"
 #include "runtime/CodeCacheExceptions.hpp"
 #include "runtime/J9VMAccess.hpp"
 #include "runtime/JITClientSession.hpp"
 #include "runtime/JITServerIProfiler.hpp"
+#include "runtime/JITServerROMClassCache.hpp"
 #include "runtime/RelocationTarget.hpp"
 #include "env/TypeLayout.hpp"
 #include "jitprotos.h"
@@ -132,12 +137,12 @@ handler_IProfiler_profilingSample(JITServer::ClientStream *client, TR_J9VM *fe,
          uint32_t canPersist = entry->canBeSerialized(comp->getPersistentInfo()); // This may lock the entry
          if (canPersist == IPBC_ENTRY_CAN_PERSIST)
             {
-            uint32_t bytes = entry->getBytesFootprint();
+            uint32_t bytes = entry->getSerializedBytesFootprint();
             std::string entryBytes(bytes, '\0');
             auto storage = (TR_IPBCDataStorageHeader*)&entryBytes[0];
             uintptr_t methodStartAddress = (uintptr_t)TR::Compiler->mtd.bytecodeStart(method);
             entry->serialize(methodStartAddress, storage, comp->getPersistentInfo());
-            client->write(JITServer::MessageType::IProfiler_profilingSample, entryBytes, false, usePersistentCache, isCompiled);
+            client->write(JITServer::MessageType::IProfiler_profilingSample, JITServer::StringRef(entryBytes), false, usePersistentCache, isCompiled);
             }
          else
             {
@@ -1161,9 +1166,22 @@ handleServerMessage(JITServer::ClientStream *client, TR_J9VM *fe, JITServer::Mes
          }
          break;
       case MessageType::ResolvedMethod_getRemoteROMClassAndMethods:
+         {
+         auto recv = client->getRecvData<J9Class *, bool>();
+         J9Class *clazz = std::get<0>(recv);
+         bool sendHashOnly = std::get<1>(recv);
+         client->write(response, JITServerHelpers::packRemoteROMClassInfo(clazz, fe->vmThread(), trMemory, true, sendHashOnly));
+            {
+            // The server caches every class it asks for; there is no need to send it ahead again
+            OMR::CriticalSection romClassCache(compInfo->getclassesCachedAtServerMonitor());
+            compInfo->getclassesCachedAtServer().insert(clazz);
+            }
+         }
+         break;
+      case MessageType::ResolvedMethod_getRemoteROMClass:
          {
          J9Class *clazz = std::get<0>(client->getRecvData<J9Class *>());
-         client->write(response, JITServerHelpers::packRemoteROMClassInfo(clazz, fe->vmThread(), trMemory, true));
+         client->write(response, JITServerHelpers::packROMClass(clazz->romClass, trMemory));
          }
          break;
       case MessageType::ResolvedMethod_isJNINative:
@@ -1533,7 +1551,7 @@ handleServerMessage(JITServer::ClientStream *client, TR_J9VM *fe, JITServer::Mes
             }
          int32_t len;
          char * data = utf8Data((J9UTF8*) ptr, len);
-         client->write(response, std::string(data, len));
+         client->write(response, JITServer::StringRef(data, len));
          }
          break;
       case MessageType::ClassInfo_getRemoteROMString:
@@ -1552,7 +1570,7 @@ handleServerMessage(JITServer::ClientStream *client, TR_J9VM *fe, JITServer::Mes
             }
          int32_t len;
          char * data = utf8Data((J9UTF8*) ptr, len);
-         client->write(response, std::string(data, len));
+         client->write(response, JITServer::StringRef(data, len));
          }
          break;
       case MessageType::ResolvedMethod_fieldOrStaticName:
@@ -3156,6 +3174,137 @@ remoteCompilationEnd(
    return relocatedMetaData;
    }
 
+// Predict which classes, besides the one declaring the method, the server will need
+// for this compilation: the already resolved classes referenced by the bytecodes of the
+// method (invoke targets, field owners, new/anewarray/checkcast/instanceof operands).
+// Those the server is not known to have cached are sent with the compilation request,
+// which saves the server one round-trip per class it would otherwise fetch on demand.
+static void
+collectClassesToPrefetch(TR::Compilation *comp, TR_ResolvedJ9Method *method, J9Class *compiledClass,
+                         TR::CompilationInfo *compInfo, std::vector<J9Class *> &classes,
+                         std::vector<JITServerHelpers::ClassInfoTuple> &classInfos)
+   {
+   uint32_t maxClasses = compInfo->getPersistentInfo()->getJITServerMaxPrefetchedClasses();
+   if (maxClasses == 0)
+      return;
+
+   J9RAMClassRef *ramClassRefs = (J9RAMClassRef *)method->cp();
+   J9ROMFieldRef *romFieldRefs = method->romCPBase();
+   TR_J9ByteCodeIterator bci(NULL, method, comp->fej9(), comp);
+   for (TR_J9ByteCode bc = bci.first(); bc != J9BCunknown && classes.size() < maxClasses; bc = bci.next())
+      {
+      int32_t classCPIndex = -1;
+      switch (bc)
+         {
+         case J9BCinvokevirtual:
+         case J9BCinvokespecial:
+         case J9BCinvokestatic:
+         case J9BCinvokeinterface:
+            classCPIndex = method->classCPIndexOfMethod(bci.next2Bytes());
+            break;
+         case J9BCinvokespecialsplit:
+            classCPIndex = method->classCPIndexOfMethod(bci.next2Bytes() | J9_SPECIAL_SPLIT_TABLE_INDEX_FLAG);
+            break;
+         case J9BCinvokestaticsplit:
+            classCPIndex = method->classCPIndexOfMethod(bci.next2Bytes() | J9_STATIC_SPLIT_TABLE_INDEX_FLAG);
+            break;
+         case J9BCgetfield:
+         case J9BCputfield:
+         case J9BCgetstatic:
+         case J9BCputstatic:
+            classCPIndex = romFieldRefs[bci.next2Bytes()].classRefCPIndex;
+            break;
+         case J9BCnew:
+         case J9BCanewarray:
+         case J9BCcheckcast:
+         case J9BCinstanceof:
+            classCPIndex = bci.next2Bytes();
+            break;
+         default:
+            break;
+         }
+      if (classCPIndex <= 0)
+         continue;
+
+      // Unresolved classes are left alone; resolving them here could have side effects
+      J9Class *clazz = ramClassRefs[classCPIndex].value;
+      if (!clazz || (clazz == compiledClass) || (std::find(classes.begin(), classes.end(), clazz) != classes.end()))
+         continue;
+         {
+         OMR::CriticalSection romClassCache(compInfo->getclassesCachedAtServerMonitor());
+         if (!compInfo->getclassesCachedAtServer().insert(clazz).second)
+            continue;
+         }
+      classes.push_back(clazz);
+      }
+
+   classInfos.reserve(classes.size());
+   for (J9Class *clazz : classes)
+      classInfos.push_back(JITServerHelpers::packRemoteROMClassInfo(clazz, comp->fej9vm()->vmThread(), comp->trMemory(), true));
+   }
+
+static void
+appendDigest(std::string &identity, const void *data, size_t size)
+   {
+   JITServerROMClassHash hash = JITServerROMClassHash::compute(data, size);
+   identity.append((const char *)&hash, sizeof(hash));
+   }
+
+// Relocation records refer to classes and methods by their offsets in the shared class cache,
+// so AOT bodies cached at the server can only be reused by clients whose caches have the same
+// content. Records stored by one client after startup are not in the caches of other clients,
+// so only read-only caches can be identified: layers below the top are always read-only, and
+// the top layer is read-only if the cache was opened with -Xshareclasses:readonly.
+// Each layer is identified by its layout and by digests of its class and metadata sections.
+// An empty identity means the server AOT cache cannot be used.
+static std::string
+computeSharedCacheIdentity(J9JavaVM *vm, TR_J9VMBase *fej9)
+   {
+   std::string identity;
+   TR_J9SharedCache *sharedCache = fej9->sharedCache();
+   if (!sharedCache || !sharedCache->getCacheDescriptorList() || !vm->sharedClassConfig ||
+       !J9_ARE_ALL_BITS_SET(vm->sharedClassConfig->runtimeFlags, J9SHR_RUNTIMEFLAG_ENABLE_READONLY))
+      return identity;
+
+   if (vm->sharedCacheAPI && vm->sharedCacheAPI->cacheName)
+      identity.append(vm->sharedCacheAPI->cacheName);
+   identity.push_back('\0');
+
+   J9SharedClassCacheDescriptor *head = sharedCache->getCacheDescriptorList();
+   J9SharedClassCacheDescriptor *curCache = head;
+   do
+      {
+      J9SharedCacheHeader *header = curCache->cacheStartAddress;
+      uint8_t *base = (uint8_t *)header;
+      uintptr_t layer[] =
+         {
+         curCache->cacheSizeBytes,
+         (uintptr_t)curCache->romclassStartAddress - (uintptr_t)header,
+         (uintptr_t)curCache->metadataStartAddress - (uintptr_t)header,
+         header->segmentSRP,
+         header->updateSRP
+         };
+      identity.append((const char *)layer, sizeof(layer));
+      appendDigest(identity, base + header->readWriteBytes, header->segmentSRP - header->readWriteBytes);
+      appendDigest(identity, base + header->updateSRP, header->totalBytes - header->debugRegionSize - header->updateSRP);
+      curCache = curCache->next;
+      }
+   while (curCache != head);
+
+   // Digests are invalid (all zeroes) if OpenSSL could not be loaded
+   if (!JITServerROMClassHash::compute(identity.data(), identity.size()).isValid())
+      identity.clear();
+   return identity;
+   }
+
+// The cache is read-only, so its identity is computed once by the first AOT compilation
+static const std::string &
+sharedCacheIdentity(J9JavaVM *vm, TR_J9VMBase *fej9)
+   {
+   static const std::string identity = computeSharedCacheIdentity(vm, fej9);
+   return identity;
+   }
+
 TR_MethodMetaData *
 remoteCompile(
    J9VMThread * vmThread,
@@ -3252,7 +3401,23 @@ remoteCompile(
       }
 
    auto classInfoTuple = JITServerHelpers::packRemoteROMClassInfo(clazz, compiler->fej9vm()->vmThread(), compiler->trMemory(), serializeClass);
+   // Send ahead the classes the server is expected to ask for; must be done with VM access in hand
+   std::vector<J9Class *> prefetchedClasses;
+   std::vector<JITServerHelpers::ClassInfoTuple> prefetchedClassInfos;
+   if (details.isOrdinaryMethod())
+      collectClassesToPrefetch(compiler, static_cast<TR_ResolvedJ9Method *>(compilee), clazz, compInfo, prefetchedClasses, prefetchedClassInfos);
    std::string optionsStr = TR::Options::packOptions(compiler->getOptions());
+   // An empty identity tells the server not to use its AOT cache for this request.
+   // Cached bodies come without the symbol validation map of the compilation, so
+   // they cannot be used when the symbol validation manager is enabled.
+   std::string aotCacheIdentity;
+   if (useAotCompilation && compiler->getPersistentInfo()->getJITServerUseAOTCache() &&
+       !compiler->getOption(TR_UseSymbolValidationManager))
+      {
+      const std::string &sccIdentity = sharedCacheIdentity(compInfo->getJITConfig()->javaVM, compiler->fej9());
+      if (!sccIdentity.empty())
+         aotCacheIdentity = compiler->getPersistentInfo()->getJITServerAOTCacheIdentity() + sccIdentity;
+      }
    std::string recompMethodInfoStr = compiler->isRecompilationEnabled() ? std::string((char *) compiler->getRecompilationInfo()->getMethodInfo(), sizeof(TR_PersistentMethodInfo)) : std::string();
 
    // TODO: make this a synchronized region to avoid bad_alloc exceptions
@@ -3300,10 +3465,12 @@ remoteCompile(
 
       Trc_JITServerRemoteCompileRequest(vmThread, seqNo, compiler->signature(), compiler->getHotnessName());
 
+      client->setCompilationRequestPriority(compInfoPT->getMethodBeingCompiled()->_priority);
       client->buildCompileRequest(compiler->getPersistentInfo()->getClientUID(), seqNo, lastCriticalSeqNo, romMethodOffset, method,
                                   clazz, *compInfoPT->getMethodBeingCompiled()->_optimizationPlan, detailsStr,
                                   details.getType(), unloadedClasses, illegalModificationList, classInfoTuple, optionsStr, recompMethodInfoStr,
-                                  chtableUpdates.first, chtableUpdates.second, useAotCompilation, TR::Compiler->vm.isVMInStartupPhase(compInfoPT->getJitConfig()));
+                                  chtableUpdates.first, chtableUpdates.second, useAotCompilation, TR::Compiler->vm.isVMInStartupPhase(compInfoPT->getJitConfig()),
+                                  prefetchedClasses, prefetchedClassInfos, aotCacheIdentity);
       JITServer::MessageType response;
       while(!handleServerMessage(client, compiler->fej9vm(), response));
 
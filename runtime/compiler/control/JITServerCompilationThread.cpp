@@ -40,6 +40,15 @@
 #include "jitprotos.h"
 #include "vmaccess.h"
 
+static bool
+serverHasLowPhysicalMemory(TR::CompilationInfo *compInfo)
+   {
+   bool incompleteInfo;
+   uint64_t freePhysicalMemorySizeB = compInfo->computeAndCacheFreePhysicalMemory(incompleteInfo);
+   return (freePhysicalMemorySizeB != OMRPORT_MEMINFO_NOT_AVAILABLE &&
+       freePhysicalMemorySizeB <= (uint64_t)TR::Options::getSafeReservePhysicalMemoryValue() + 4 * TR::Options::getScratchSpaceLowerBound());
+   }
+
 /**
  * @brief Method executed by JITServer to process the end of a compilation.
  */
@@ -105,10 +114,7 @@ outOfProcessCompilationEnd(
    auto resolvedMirrorMethodsPersistIPInfo = compInfoPT->getCachedResolvedMirrorMethodsPersistIPInfo();
 
    // If the server is running low on memory, tell clients to reduce the number of active compilation threads
-   bool incompleteInfo;
-   uint64_t freePhysicalMemorySizeB = compInfoPT->getCompilationInfo()->computeAndCacheFreePhysicalMemory(incompleteInfo);
-   bool serverHasLowMemory = (freePhysicalMemorySizeB != OMRPORT_MEMINFO_NOT_AVAILABLE &&
-       freePhysicalMemorySizeB <= (uint64_t)TR::Options::getSafeReservePhysicalMemoryValue() + 4 * TR::Options::getScratchSpaceLowerBound());
+   bool serverHasLowMemory = serverHasLowPhysicalMemory(compInfoPT->getCompilationInfo());
 
    entry->_stream->finishCompilation(codeCacheStr, dataCacheStr, chTableData,
                                      std::vector<TR_OpaqueClassBlock*>(classesThatShouldNotBeNewlyExtended->begin(), classesThatShouldNotBeNewlyExtended->end()),
@@ -120,10 +126,18 @@ outOfProcessCompilationEnd(
                                      );
    compInfoPT->clearPerCompilationCaches();
 
+   // Keep the body for identical clients unless it depends on runtime assumptions registered for this client.
+   // CHTable data is not needed by AOT bodies and is not cached. The symbol validation map holds client
+   // pointers, so bodies compiled with the symbol validation manager are not cached either.
+   if (compInfoPT->getAOTCache() && serializedRuntimeAssumptions.empty() && !serverHasLowMemory &&
+       !comp->getOption(TR_UseSymbolValidationManager))
+      compInfoPT->getAOTCache()->store(compInfoPT->getAOTCacheKey(), codeCacheStr, dataCacheStr);
+
    if (TR::Options::getVerboseOption(TR_VerboseJITServer))
       {
-      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "compThreadID=%d has successfully compiled %s",
-         compInfoPT->getCompThreadId(), compInfoPT->getCompilation()->signature());
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "compThreadID=%d has successfully compiled %s roundTrips=%u roundTripTime=%llu us",
+         compInfoPT->getCompThreadId(), compInfoPT->getCompilation()->signature(),
+         entry->_stream->getNumRoundTrips(), (unsigned long long)(entry->_stream->getRoundTripTimeNs() / 1000));
       }
 
    Trc_JITServerCompileEnd(compInfoPT->getCompilationThread(), compInfoPT->getCompThreadId(),
@@ -141,7 +155,9 @@ TR::CompilationInfoPerThreadRemote::CompilationInfoPerThreadRemote(TR::Compilati
    _classOfStaticMap(NULL),
    _fieldAttributesCache(NULL),
    _staticAttributesCache(NULL),
-   _isUnresolvedStrCache(NULL)
+   _isUnresolvedStrCache(NULL),
+   _aotCache(NULL),
+   _aotCacheKey()
    {}
 
 /**
@@ -316,9 +332,11 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
    entry._compInfoPT = this; // Create the reverse link
    // Update the last time the compilation thread had to do something.
    compInfo->setLastReqStartTime(compInfo->getPersistentInfo()->getElapsedTime());
+   uint64_t queueWaitMs = compInfo->getPersistentInfo()->getElapsedTime() - entry._entryTime;
    clearPerCompilationCaches();
 
    _recompilationMethodInfo = NULL;
+   _aotCache = NULL;
    // Release compMonitor before doing the blocking read
    compInfo->releaseCompMonitor(compThread);
 
@@ -343,7 +361,8 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
       auto req = stream->readCompileRequest<uint64_t, uint32_t, uint32_t, uint32_t, J9Method *, J9Class*,
          TR_OptimizationPlan, std::string, J9::IlGeneratorMethodDetailsType,
          std::vector<TR_OpaqueClassBlock*>, std::vector<TR_OpaqueClassBlock*>, 
-         JITServerHelpers::ClassInfoTuple, std::string, std::string, std::string, std::string, bool, bool>();
+         JITServerHelpers::ClassInfoTuple, std::string, std::string, std::string, std::string, bool, bool,
+         std::vector<J9Class *>, std::vector<JITServerHelpers::ClassInfoTuple>, std::string>();
 
       clientId                           = std::get<0>(req);
       seqNo                              = std::get<1>(req); // Sequence number at the client
@@ -362,6 +381,9 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
       const std::string &chtableUnloads  = std::get<14>(req);
       const std::string &chtableMods     = std::get<15>(req);
       useAotCompilation                  = std::get<16>(req);
+      auto &prefetchedClasses            = std::get<18>(req);
+      auto &prefetchedClassInfoTuples    = std::get<19>(req);
+      const std::string &aotCacheIdentity = std::get<20>(req);
 
       isCriticalRequest = !chtableMods.empty() || !chtableUnloads.empty() || !illegalModificationList.empty() || !unloadedClasses.empty();
 
@@ -398,6 +420,7 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
 
       setClientData(clientSession); // Cache the session data into CompilationInfoPerThreadRemote object
       clientSession->setIsInStartupPhase(std::get<17>(req));
+      clientSession->recordQueueWait(queueWaitMs);
       } // End critical section
 
      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
@@ -578,10 +601,12 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
             // It could be a renewed connection, so that's a new server because old one was shutdown
             // When the server receives an empty ROM class it would check if it actually has this class cached,
             // And if it it's not cached, send a request to the client
-            romClass = JITServerHelpers::getRemoteROMClass(clazz, stream, compInfo->persistentMemory(), &classInfoTuple);
+            romClass = JITServerHelpers::getRemoteROMClass(clazz, clientSession, stream, compInfo->persistentMemory(), &classInfoTuple);
             }
-         JITServerHelpers::cacheRemoteROMClass(getClientData(), clazz, romClass, &classInfoTuple);
+         romClass = JITServerHelpers::cacheRemoteROMClass(getClientData(), clazz, romClass, &classInfoTuple);
          }
+      // Cache the classes that the client expects this compilation to need
+      JITServerHelpers::cachePrefetchedClasses(clientSession, prefetchedClasses, prefetchedClassInfoTuples, compInfo->persistentMemory());
 
       J9ROMMethod *romMethod = (J9ROMMethod*)((uint8_t*)romClass + romMethodOffset);
 
@@ -595,6 +620,21 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
       TR::IlGeneratorMethodDetails serverDetailsStorage;
       TR::IlGeneratorMethodDetails *serverDetails = TR::IlGeneratorMethodDetails::clone(serverDetailsStorage, *clientDetails, detailsType);
 
+      // AOT bodies of ordinary methods can be reused by clients that announce the same cache identity
+      // and that generate the same code: same compressed refs shift and same processor features
+      auto aotCacheMap = compInfo->getJITServerAOTCacheMap();
+      if (aotCacheMap && useAotCompilation && !aotCacheIdentity.empty() && serverDetails->isOrdinaryMethod())
+         {
+         auto vmInfo = clientSession->getOrCacheVMInfo(stream);
+         std::string identity(aotCacheIdentity);
+         identity.append((const char *)&vmInfo->_compressedReferenceShift, sizeof(vmInfo->_compressedReferenceShift));
+         identity.append((const char *)&vmInfo->_processorDescription, sizeof(vmInfo->_processorDescription));
+         _aotCache = aotCacheMap->get(identity);
+         _aotCacheKey._romClassHash = JITServerROMClassHash::compute(romClass, romClass->romSize);
+         _aotCacheKey._romMethodOffset = romMethodOffset;
+         _aotCacheKey._optLevel = clientOptPlan.getOptLevel();
+         }
+
       // All entries have the same priority for now. In the future we may want to give higher priority to sync requests
       // Also, oldStartPC is always NULL for JITServer
       entry._freeTag = ENTRY_IN_POOL_FREE; // Pretend we just got it from the pool because we need to initialize it again
@@ -828,7 +868,15 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
    stream->setClientData(clientSession);
    getClientData()->readAcquireClassUnloadRWMutex();
 
-   void *startPC = compile(compThread, &entry, scratchSegmentProvider);
+   void *startPC = NULL;
+   if (_aotCache && sendCachedAOTMethod(entry))
+      {
+      // Leave with the same monitors compile() returns with
+      compInfo->acquireCompMonitor(compThread);
+      entry.acquireSlotMonitor(compThread);
+      }
+   else
+      startPC = compile(compThread, &entry, scratchSegmentProvider);
 
    getClientData()->readReleaseClassUnloadRWMutex();
    stream->setClientData(NULL);
@@ -941,6 +989,39 @@ TR::CompilationInfoPerThreadRemote::processEntry(TR_MethodToBeCompiled &entry, J
       }
    }
 
+/**
+ * @brief Method executed by JITServer to answer an AOT compilation request with the body
+ *        cached for an identical client instead of compiling the method again.
+ *        Must be called with VM access in hand; VM access is released while sending the body.
+ *
+ * @param entry the request being processed
+ * @return true if the request was answered, false if the method is not in the cache
+ */
+bool
+TR::CompilationInfoPerThreadRemote::sendCachedAOTMethod(TR_MethodToBeCompiled &entry)
+   {
+   std::string codeCacheStr;
+   std::string dataCacheStr;
+   if (!_aotCache->get(_aotCacheKey, codeCacheStr, dataCacheStr))
+      return false;
+
+   J9VMThread *compThread = getCompilationThread();
+   releaseVMAccess(compThread);
+   // Bodies compiled with the symbol validation manager are never cached, so no symbol validation map is sent
+   entry._stream->finishCompilation(codeCacheStr, dataCacheStr, CHTableCommitData(), std::vector<TR_OpaqueClassBlock*>(),
+                                    std::string(), std::string(), std::vector<TR_ResolvedJ9Method*>(),
+                                    *entry._optimizationPlan, std::vector<SerializedRuntimeAssumption>(),
+                                    serverHasLowPhysicalMemory(getCompilationInfo()));
+   acquireVMAccessNoSuspend(compThread);
+   entry._compErrCode = compilationOK;
+
+   if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "compThreadID=%d sent cached AOT body for clientUID=%llu romMethodOffset=%u optLevel=%d from cache \"%s\"",
+         getCompThreadId(), (unsigned long long)getClientData()->getClientUID(), _aotCacheKey._romMethodOffset,
+         _aotCacheKey._optLevel, _aotCache->name().c_str());
+   return true;
+   }
+
 /**
  * @brief Method executed by JITServer to store bytecode iprofiler info to heap memory (instead of to persistent memory)
  *
@@ -26,6 +26,7 @@
 #include "control/CompilationThread.hpp"
 #include "env/j9methodServer.hpp"
 #include "runtime/JITClientSession.hpp"
+#include "runtime/JITServerAOTCache.hpp"
 
 class TR_IPBytecodeHashTableEntry;
 
@@ -78,6 +79,10 @@ class CompilationInfoPerThreadRemote : public TR::CompilationInfoPerThread
    void cacheIsUnresolvedStr(TR_OpaqueClassBlock *ramClass, int32_t cpIndex, const TR_IsUnresolvedString &stringAttrs);
    bool getCachedIsUnresolvedStr(TR_OpaqueClassBlock *ramClass, int32_t cpIndex, TR_IsUnresolvedString &stringAttrs);
 
+   JITServerAOTCache *getAOTCache() const { return _aotCache; }
+   const JITServerAOTCacheKey &getAOTCacheKey() const { return _aotCacheKey; }
+   bool sendCachedAOTMethod(TR_MethodToBeCompiled &entry);
+
    void clearPerCompilationCaches();
    void deleteClientSessionData(uint64_t clientId, TR::CompilationInfo* compInfo, J9VMThread* compThread);
    virtual void freeAllResources() override;
@@ -149,6 +154,8 @@ class CompilationInfoPerThreadRemote : public TR::CompilationInfoPerThread
    FieldOrStaticAttrTable_t *_fieldAttributesCache;
    FieldOrStaticAttrTable_t *_staticAttributesCache;
    UnorderedMap<std::pair<TR_OpaqueClassBlock *, int32_t>, TR_IsUnresolvedString> *_isUnresolvedStrCache;
+   JITServerAOTCache *_aotCache; // AOT cache shared with identical clients; NULL if the current request cannot use it
+   JITServerAOTCacheKey _aotCacheKey; // identity of the method being compiled in _aotCache
    }; // class CompilationInfoPerThreadRemote
 } // namespace TR
 
@@ -22,12 +22,15 @@
 
 #include "control/JITServerHelpers.hpp"
 
+#include <algorithm>
 #include "control/CompilationRuntime.hpp"
 #include "control/JITServerCompilationThread.hpp"
 #include "control/MethodToBeCompiled.hpp"
 #include "infra/CriticalSection.hpp"
 #include "infra/Statistics.hpp"
 #include "net/CommunicationStream.hpp"
+#include "net/ServerStream.hpp"
+#include "runtime/JITServerAOTCache.hpp"
 #include "OMR/Bytes.hpp"// for OMR::alignNoCheck()
 
 
@@ -75,8 +78,8 @@ packUTF8(uint8_t *curPos, const J9UTF8 *origStr, const J9ROMClass *origRomClass,
 // Some of the name and signature strings are interned and stored outside
 // of the ROMClass body. Such strings are appended to the end of the cloned
 // ROMClass body and the self referential pointers to them are updated.
-static std::string
-packROMClass(J9ROMClass *origRomClass, TR_Memory *trMemory)
+std::string
+JITServerHelpers::packROMClass(J9ROMClass *origRomClass, TR_Memory *trMemory)
    {
    size_t totalSize = origRomClass->romSize;
    J9UTF8 *className = J9ROMCLASS_CLASSNAME(origRomClass);
@@ -196,6 +199,118 @@ JITServerHelpers::printJITServerMsgStats(J9JITConfig *jitConfig, TR::Compilation
       j9tty_printf(PORTLIB, "Total number of messages: %u\n", totalMsgCount);
 #endif // defined(MESSAGE_SIZE_STATS)
       }
+
+   // Compression statistics are collected by both ends of a connection
+   bool printedCompressionHeader = false;
+   for (int i = 0; i < JITServer::MessageType_ARRAYSIZE; ++i)
+      {
+      const JITServer::CommunicationStream::CompressionStats &stats = JITServer::CommunicationStream::compressionStats[i];
+      if (stats._numCompressed == 0 && stats._numDecompressed == 0)
+         continue;
+      if (!printedCompressionHeader)
+         {
+         j9tty_printf(PORTLIB, "JITServer Message Compression Statistics:\n");
+         j9tty_printf(PORTLIB, "Type# #compressed\tBytesIn\t\tBytesOut\tRatio\tCompressCPU(us)\t#decompressed\tDecompressCPU(us)\tTypeName\n");
+         printedCompressionHeader = true;
+         }
+      j9tty_printf(PORTLIB, "#%04d %11u\t%llu\t\t%llu\t\t%f\t%llu\t\t%13u\t%llu\t\t\t%s\n", i,
+                   stats._numCompressed, stats._uncompressedBytes, stats._compressedBytes,
+                   stats._compressedBytes ? stats._uncompressedBytes / (double)stats._compressedBytes : 0.0,
+                   stats._compressionTimeNs / 1000, stats._numDecompressed, stats._decompressionTimeNs / 1000,
+                   JITServer::messageNames[i]);
+      }
+
+   // Volume and latency statistics are always collected. The server times round trips
+   // of its queries, the client times how long it takes to answer them
+   bool isServer = compInfo->getPersistentInfo()->getRemoteCompilationMode() == JITServer::SERVER;
+   typedef JITServer::CommunicationStream::MessageStats MessageStats;
+   j9tty_printf(PORTLIB, "JITServer Message Volume and Latency Statistics (%s):\n", isServer ? "round trip" : "time to answer");
+   j9tty_printf(PORTLIB, "Type# #sent\tBytesSent\t#received\tBytesReceived\t#timed\tAvg(us)\tMax(us)\t%s", isServer ? "AvgWait(us)\t" : "");
+   for (int b = 0; b < MessageStats::NUM_LATENCY_BUCKETS - 1; ++b)
+      j9tty_printf(PORTLIB, "<%lluus\t", (unsigned long long)MessageStats::latencyBucketLimitUs(b));
+   j9tty_printf(PORTLIB, ">=%lluus\tTypeName\n", (unsigned long long)MessageStats::latencyBucketLimitUs(MessageStats::NUM_LATENCY_BUCKETS - 2));
+   for (int i = 0; i < JITServer::MessageType_ARRAYSIZE; ++i)
+      {
+      const MessageStats &stats = JITServer::CommunicationStream::messageStats[i];
+      if (stats._numSent == 0 && stats._numReceived == 0)
+         continue;
+      j9tty_printf(PORTLIB, "#%04d %u\t%llu\t\t%u\t\t%llu\t\t%u\t%llu\t%llu\t", i,
+                   stats._numSent, (unsigned long long)stats._bytesSent, stats._numReceived, (unsigned long long)stats._bytesReceived,
+                   stats._numTimed, (unsigned long long)(stats._numTimed ? stats._totalTimeNs / stats._numTimed / 1000 : 0),
+                   (unsigned long long)(stats._maxTimeNs / 1000));
+      if (isServer)
+         j9tty_printf(PORTLIB, "%llu\t\t", (unsigned long long)(stats._numTimed ? stats._waitTimeNs / stats._numTimed / 1000 : 0));
+      for (int b = 0; b < MessageStats::NUM_LATENCY_BUCKETS; ++b)
+         j9tty_printf(PORTLIB, "%u\t", stats._latencyHistogram[b]);
+      j9tty_printf(PORTLIB, "%s\n", JITServer::messageNames[i]);
+      }
+
+   if (isServer)
+      {
+      const JITServer::ServerStream::CompilationRoundTripStats &stats = JITServer::ServerStream::compilationRoundTripStats;
+      j9tty_printf(PORTLIB, "Compilations: %u round trips: %llu (avg %f, max %u) round-trip time: %llu ms (avg %f ms)\n",
+                   stats._numCompilations, (unsigned long long)stats._numRoundTrips,
+                   stats._numCompilations ? stats._numRoundTrips / (double)stats._numCompilations : 0.0, stats._maxRoundTrips,
+                   (unsigned long long)(stats._roundTripTimeNs / 1000000),
+                   stats._numCompilations ? stats._roundTripTimeNs / 1e6 / stats._numCompilations : 0.0);
+      j9tty_printf(PORTLIB, "Round trips per compilation:");
+      for (int b = 0; b < JITServer::ServerStream::CompilationRoundTripStats::NUM_BUCKETS; ++b)
+         {
+         if (b == 0)
+            j9tty_printf(PORTLIB, " 0:%u", stats._histogram[b]);
+         else if (b == JITServer::ServerStream::CompilationRoundTripStats::NUM_BUCKETS - 1)
+            j9tty_printf(PORTLIB, " >=%u:%u", 1u << (b - 1), stats._histogram[b]);
+         else
+            j9tty_printf(PORTLIB, " <%u:%u", 1u << b, stats._histogram[b]);
+         }
+      j9tty_printf(PORTLIB, "\n");
+      }
+   }
+
+void
+JITServerHelpers::printJITServerMsgLatencySummary(TR::CompilationInfo *compInfo)
+   {
+   static const int NUM_TOP_TYPES = 5;
+   typedef JITServer::CommunicationStream::MessageStats MessageStats;
+   // Select the message types with the largest total time
+   int topTypes[NUM_TOP_TYPES];
+   int numTopTypes = 0;
+   for (int i = 0; i < JITServer::MessageType_ARRAYSIZE; ++i)
+      {
+      uint64_t totalTimeNs = JITServer::CommunicationStream::messageStats[i]._totalTimeNs;
+      if (totalTimeNs == 0)
+         continue;
+      int pos = numTopTypes;
+      while (pos > 0 && JITServer::CommunicationStream::messageStats[topTypes[pos - 1]]._totalTimeNs < totalTimeNs)
+         pos--;
+      if (pos >= NUM_TOP_TYPES)
+         continue;
+      int last = std::min(numTopTypes, NUM_TOP_TYPES - 1);
+      for (int j = last; j > pos; --j)
+         topTypes[j] = topTypes[j - 1];
+      topTypes[pos] = i;
+      numTopTypes = std::min(numTopTypes + 1, NUM_TOP_TYPES);
+      }
+
+   bool isServer = compInfo->getPersistentInfo()->getRemoteCompilationMode() == JITServer::SERVER;
+   if (isServer)
+      {
+      const JITServer::ServerStream::CompilationRoundTripStats &stats = JITServer::ServerStream::compilationRoundTripStats;
+      TR_VerboseLog::writeLine(TR_Vlog_JITServer, "Compilations: %u avg round trips per compilation: %.1f avg round-trip time per compilation: %.3f ms",
+                               stats._numCompilations, stats._numCompilations ? stats._numRoundTrips / (double)stats._numCompilations : 0.0,
+                               stats._numCompilations ? stats._roundTripTimeNs / 1e6 / stats._numCompilations : 0.0);
+      }
+   for (int i = 0; i < numTopTypes; ++i)
+      {
+      const MessageStats &stats = JITServer::CommunicationStream::messageStats[topTypes[i]];
+      TR_VerboseLog::writeLine(TR_Vlog_JITServer, "%s: count=%u totalTime=%llu ms avgTime=%llu us maxTime=%llu us avgWait=%llu us bytesSent=%llu bytesReceived=%llu",
+                               JITServer::messageNames[topTypes[i]], stats._numTimed,
+                               (unsigned long long)(stats._totalTimeNs / 1000000),
+                               (unsigned long long)(stats._numTimed ? stats._totalTimeNs / stats._numTimed / 1000 : 0),
+                               (unsigned long long)(stats._maxTimeNs / 1000),
+                               (unsigned long long)(stats._numTimed ? stats._waitTimeNs / stats._numTimed / 1000 : 0),
+                               (unsigned long long)stats._bytesSent, (unsigned long long)stats._bytesReceived);
+      }
    }
 
 void
@@ -239,10 +354,14 @@ JITServerHelpers::printJITServerCacheStats(J9JITConfig *jitConfig, TR::Compilati
       {
       auto clientSessionHT = compInfo->getClientSessionHT();
       clientSessionHT->printStats();
+      if (auto sharedROMClassCache = compInfo->getJITServerSharedROMClassCache())
+         sharedROMClassCache->printStats();
+      if (auto aotCacheMap = compInfo->getJITServerAOTCacheMap())
+         aotCacheMap->printStats();
       }
    }
 
-void 
+J9ROMClass *
 JITServerHelpers::cacheRemoteROMClass(ClientSessionData *clientSessionData, J9Class *clazz, J9ROMClass *romClass, ClassInfoTuple *classInfoTuple)
    {
    ClientSessionData::ClassInfo classInfo;
@@ -251,7 +370,11 @@ JITServerHelpers::cacheRemoteROMClass(ClientSessionData *clientSessionData, J9Cl
    if (it == clientSessionData->getROMClassMap().end())
       {
       JITServerHelpers::cacheRemoteROMClass(clientSessionData, clazz, romClass, classInfoTuple, classInfo);
+      return romClass;
       }
+   // Another thread cached this class in the meantime
+   JITServerHelpers::freeRemoteROMClass(romClass);
+   return it->second._romClass;
    }
 
 void
@@ -290,6 +413,7 @@ JITServerHelpers::cacheRemoteROMClass(ClientSessionData *clientSessionData, J9Cl
 
    uint32_t numMethods = romClass->romMethodCount;
    J9ROMMethod *romMethod = J9ROMCLASS_ROMMETHODS(romClass);
+   JITServerRWMutex::WriteCriticalSection cacheJ9Methods(clientSessionData->getJ9MethodMapRWMutex());
    for (uint32_t i = 0; i < numMethods; i++)
       {
       clientSessionData->getJ9MethodMap().insert({&methods[i],
@@ -303,11 +427,55 @@ JITServerHelpers::getRemoteROMClassIfCached(ClientSessionData *clientSessionData
    {
    OMR::CriticalSection getRemoteROMClassIfCached(clientSessionData->getROMMapMonitor());
    auto it = clientSessionData->getROMClassMap().find(clazz);
-   return (it == clientSessionData->getROMClassMap().end()) ? NULL : it->second._romClass;
+   if (it == clientSessionData->getROMClassMap().end())
+      return NULL;
+   clientSessionData->recordClassInfoUse(it->second);
+   return it->second._romClass;
+   }
+
+// Classes that this or another compilation cached in the meantime are dropped;
+// those cached here are marked as prefetched until a compilation looks them up.
+void
+JITServerHelpers::cachePrefetchedClasses(ClientSessionData *clientSessionData, const std::vector<J9Class *> &classes,
+                                         std::vector<ClassInfoTuple> &classInfoTuples, TR_PersistentMemory *trMemory)
+   {
+   TR_ASSERT(classes.size() == classInfoTuples.size(), "Mismatched prefetched class lists");
+      {
+      OMR::CriticalSection recordCompilationRequest(clientSessionData->getROMMapMonitor());
+      clientSessionData->recordCompilationRequest();
+      }
+   for (size_t i = 0; i < classes.size(); ++i)
+      {
+      J9Class *clazz = classes[i];
+      ClassInfoTuple &classInfoTuple = classInfoTuples[i];
+      const std::string &romClassStr = std::get<0>(classInfoTuple);
+      if (romClassStr.empty())
+         continue;
+         {
+         OMR::CriticalSection isClassCached(clientSessionData->getROMMapMonitor());
+         if (clientSessionData->getROMClassMap().find(clazz) != clientSessionData->getROMClassMap().end())
+            continue;
+         }
+      // Build the ROM class outside of the critical section
+      J9ROMClass *romClass = romClassFromString(romClassStr, trMemory);
+
+      OMR::CriticalSection cachePrefetchedClass(clientSessionData->getROMMapMonitor());
+      if (clientSessionData->getROMClassMap().find(clazz) == clientSessionData->getROMClassMap().end())
+         {
+         ClientSessionData::ClassInfo classInfo;
+         classInfo._prefetched = true;
+         cacheRemoteROMClass(clientSessionData, clazz, romClass, &classInfoTuple, classInfo);
+         clientSessionData->recordPrefetchedClass();
+         }
+      else
+         {
+         freeRemoteROMClass(romClass);
+         }
+      }
    }
 
 JITServerHelpers::ClassInfoTuple
-JITServerHelpers::packRemoteROMClassInfo(J9Class *clazz, J9VMThread *vmThread, TR_Memory *trMemory, bool serializeClass)
+JITServerHelpers::packRemoteROMClassInfo(J9Class *clazz, J9VMThread *vmThread, TR_Memory *trMemory, bool serializeClass, bool sendHashOnly)
    {
    // Always use the base VM here.
    // If this method is called inside AOT compilation, TR_J9SharedCacheVM will
@@ -349,16 +517,36 @@ JITServerHelpers::packRemoteROMClassInfo(J9Class *clazz, J9VMThread *vmThread, T
    uintptr_t classChainOffsetOfIdentifyingLoaderForClazz = fe->sharedCache() ? 
       fe->sharedCache()->getClassChainOffsetOfIdentifyingLoaderForClazzInSharedCacheNoFail((TR_OpaqueClassBlock *)clazz) : 0;
 
-   return std::make_tuple(serializeClass ? packROMClass(clazz->romClass, trMemory) : std::string(), methodsOfClass, baseClass, numDims, parentClass,
+   // A server that already holds an identical ROM class (e.g. received from another client)
+   // only needs its digest; it will ask for the content separately if the digest is unknown.
+   // The full content is sent if the digest cannot be computed.
+   std::string romClassStr;
+   JITServerROMClassHash romClassHash = {};
+   if (serializeClass)
+      {
+      romClassStr = packROMClass(clazz->romClass, trMemory);
+      if (sendHashOnly)
+         {
+         romClassHash = JITServerROMClassHash::compute(romClassStr.data(), romClassStr.size());
+         if (romClassHash.isValid())
+            romClassStr.clear();
+         }
+      }
+
+   return std::make_tuple(romClassStr, methodsOfClass, baseClass, numDims, parentClass,
                           TR::Compiler->cls.getITable((TR_OpaqueClassBlock *) clazz), methodTracingInfo,
                           classHasFinalFields, classDepthAndFlags, classInitialized, byteOffsetToLockword,
                           leafComponentClass, classLoader, hostClass, componentClass, arrayClass, totalInstanceSize,
-                          clazz->romClass, cp, classFlags, classChainOffsetOfIdentifyingLoaderForClazz, origROMMethods);
+                          clazz->romClass, cp, classFlags, classChainOffsetOfIdentifyingLoaderForClazz, origROMMethods,
+                          romClassHash);
    }
 
 J9ROMClass *
 JITServerHelpers::romClassFromString(const std::string &romClassStr, TR_PersistentMemory *trMemory)
    {
+   if (auto sharedROMClassCache = TR::CompilationInfo::get()->getJITServerSharedROMClassCache())
+      return sharedROMClassCache->getOrCreate(romClassStr);
+
    auto romClass = (J9ROMClass *)(trMemory->allocatePersistentMemory(romClassStr.size(), TR_Memory::ROMClass));
    if (!romClass)
       throw std::bad_alloc();
@@ -366,22 +554,46 @@ JITServerHelpers::romClassFromString(const std::string &romClassStr, TR_Persiste
    return romClass;
    }
 
+void
+JITServerHelpers::freeRemoteROMClass(J9ROMClass *romClass)
+   {
+   if (auto sharedROMClassCache = TR::CompilationInfo::get()->getJITServerSharedROMClassCache())
+      sharedROMClassCache->release(romClass);
+   else
+      TR_Memory::jitPersistentFree(romClass);
+   }
+
 J9ROMClass *
-JITServerHelpers::getRemoteROMClass(J9Class *clazz, JITServer::ServerStream *stream, TR_Memory *trMemory, ClassInfoTuple *classInfoTuple)
+JITServerHelpers::getRemoteROMClass(J9Class *clazz, ClientSessionData *clientSessionData, JITServer::ServerStream *stream, TR_Memory *trMemory, ClassInfoTuple *classInfoTuple)
    {
-   stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMClassAndMethods, clazz);
-   const auto &recv = stream->read<ClassInfoTuple>();
-   *classInfoTuple = std::get<0>(recv);
-   return romClassFromString(std::get<0>(*classInfoTuple), trMemory->trPersistentMemory());
+   return getRemoteROMClass(clazz, clientSessionData, stream, trMemory->trPersistentMemory(), classInfoTuple);
    }
 
+// Requests the class information from the client. When the ROM class is likely to
+// be already cached at the server (received from another client), the client
+// sends only its hash and the content is requested separately if the lookup fails.
 J9ROMClass *
-JITServerHelpers::getRemoteROMClass(J9Class *clazz, JITServer::ServerStream *stream, TR_PersistentMemory *trMemory, ClassInfoTuple *classInfoTuple)
+JITServerHelpers::getRemoteROMClass(J9Class *clazz, ClientSessionData *clientSessionData, JITServer::ServerStream *stream, TR_PersistentMemory *trMemory, ClassInfoTuple *classInfoTuple)
    {
-   stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMClassAndMethods, clazz);
+   auto sharedROMClassCache = TR::CompilationInfo::get()->getJITServerSharedROMClassCache();
+   bool sendHashOnly = sharedROMClassCache && clientSessionData->shouldRequestROMClassHashOnly();
+   stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMClassAndMethods, clazz, sendHashOnly);
    const auto &recv = stream->read<ClassInfoTuple>();
    *classInfoTuple = std::get<0>(recv);
-   return romClassFromString(std::get<0>(*classInfoTuple), trMemory);
+
+   auto &romClassStr = std::get<0>(*classInfoTuple);
+   const JITServerROMClassHash &romClassHash = std::get<22>(*classInfoTuple);
+   if (romClassStr.empty() && romClassHash.isValid())
+      {
+      J9ROMClass *romClass = sharedROMClassCache->get(romClassHash);
+      clientSessionData->recordROMClassHashLookup(romClass != NULL);
+      if (romClass)
+         return romClass;
+
+      stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMClass, clazz);
+      romClassStr = std::get<0>(stream->read<std::string>());
+      }
+   return romClassFromString(romClassStr, trMemory);
    }
 
 // Return true if able to get data from cache, return false otherwise.
@@ -399,25 +611,24 @@ JITServerHelpers::getAndCacheRAMClassInfo(J9Class *clazz, ClientSessionData *cli
       auto it = clientSessionData->getROMClassMap().find((J9Class*)clazz);
       if (it != clientSessionData->getROMClassMap().end())
          {
+         clientSessionData->recordClassInfoUse(it->second);
          JITServerHelpers::getROMClassData(it->second, dataType, data);
          return true;
          }
       }
 
-   stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMClassAndMethods, clazz);
-   const auto &recv = stream->read<ClassInfoTuple>();
-   classInfoTuple = std::get<0>(recv);
+   auto romClass = getRemoteROMClass(clazz, clientSessionData, stream, TR::comp()->trMemory(), &classInfoTuple);
 
    OMR::CriticalSection cacheRemoteROMClass(clientSessionData->getROMMapMonitor());
    auto it = clientSessionData->getROMClassMap().find(clazz);
    if (it == clientSessionData->getROMClassMap().end())
       {
-      auto romClass = romClassFromString(std::get<0>(classInfoTuple), TR::comp()->trMemory()->trPersistentMemory());
       JITServerHelpers::cacheRemoteROMClass(clientSessionData, clazz, romClass, &classInfoTuple, classInfo);
       JITServerHelpers::getROMClassData(classInfo, dataType, data);
       }
    else
       {
+      freeRemoteROMClass(romClass);
       JITServerHelpers::getROMClassData(it->second, dataType, data);
       }
    return false;
@@ -438,26 +649,25 @@ JITServerHelpers::getAndCacheRAMClassInfo(J9Class *clazz, ClientSessionData *cli
       auto it = clientSessionData->getROMClassMap().find((J9Class*)clazz);
       if (it != clientSessionData->getROMClassMap().end())
          {
+         clientSessionData->recordClassInfoUse(it->second);
          JITServerHelpers::getROMClassData(it->second, dataType1, data1);
          JITServerHelpers::getROMClassData(it->second, dataType2, data2);
          return true;
          }
       }
-   stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMClassAndMethods, clazz);
-   const auto &recv = stream->read<ClassInfoTuple>();
-   classInfoTuple = std::get<0>(recv);
+   auto romClass = getRemoteROMClass(clazz, clientSessionData, stream, TR::comp()->trMemory(), &classInfoTuple);
 
    OMR::CriticalSection cacheRemoteROMClass(clientSessionData->getROMMapMonitor());
    auto it = clientSessionData->getROMClassMap().find(clazz);
    if (it == clientSessionData->getROMClassMap().end())
       {
-      auto romClass = romClassFromString(std::get<0>(classInfoTuple), TR::comp()->trMemory()->trPersistentMemory());
       JITServerHelpers::cacheRemoteROMClass(clientSessionData, clazz, romClass, &classInfoTuple, classInfo);
       JITServerHelpers::getROMClassData(classInfo, dataType1, data1);
       JITServerHelpers::getROMClassData(classInfo, dataType2, data2);
       }
    else
       {
+      freeRemoteROMClass(romClass);
       JITServerHelpers::getROMClassData(it->second, dataType1, data1);
       JITServerHelpers::getROMClassData(it->second, dataType2, data2);
       }
@@ -586,7 +796,7 @@ JITServerHelpers::romMethodOfRamMethod(J9Method* method)
 
    // Check if the method is already cached.
       {
-      OMR::CriticalSection romCache(clientData->getROMMapMonitor());
+      JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(clientData->getJ9MethodMapRWMutex());
       auto &map = clientData->getJ9MethodMap();
       auto it = map.find((J9Method*) method);
       if (it != map.end())
@@ -601,7 +811,7 @@ JITServerHelpers::romMethodOfRamMethod(J9Method* method)
       J9Class *clazz = (J9Class*) std::get<0>(stream->read<TR_OpaqueClassBlock *>());
       TR::compInfoPT->getAndCacheRemoteROMClass(clazz);
          {
-         OMR::CriticalSection romCache(clientData->getROMMapMonitor());
+         JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(clientData->getJ9MethodMapRWMutex());
          auto &map = clientData->getJ9MethodMap();
          auto it = map.find((J9Method *) method);
          if (it != map.end())
@@ -667,20 +877,19 @@ uintptr_t
 JITServerHelpers::getRemoteClassDepthAndFlagsWhenROMClassNotCached(J9Class *clazz, ClientSessionData *clientSessionData, JITServer::ServerStream *stream)
 {
    ClientSessionData::ClassInfo classInfo;
-   stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMClassAndMethods, clazz);
-   const auto &recv = stream->read<JITServerHelpers::ClassInfoTuple>();
-   JITServerHelpers::ClassInfoTuple classInfoTuple = std::get<0>(recv);
+   JITServerHelpers::ClassInfoTuple classInfoTuple;
+   auto romClass = JITServerHelpers::getRemoteROMClass(clazz, clientSessionData, stream, TR::comp()->trMemory(), &classInfoTuple);
 
    OMR::CriticalSection cacheRemoteROMClass(clientSessionData->getROMMapMonitor());
    auto it = clientSessionData->getROMClassMap().find(clazz);
    if (it == clientSessionData->getROMClassMap().end())
       {
-      auto romClass = JITServerHelpers::romClassFromString(std::get<0>(classInfoTuple), TR::comp()->trMemory()->trPersistentMemory());
       JITServerHelpers::cacheRemoteROMClass(clientSessionData, clazz, romClass, &classInfoTuple, classInfo);
       return classInfo._classDepthAndFlags;
       }
    else
       {
+      JITServerHelpers::freeRemoteROMClass(romClass);
       return it->second._classDepthAndFlags;
       }
 }
@@ -25,6 +25,7 @@
 
 #include "net/MessageTypes.hpp"
 #include "runtime/JITClientSession.hpp"
+#include "runtime/JITServerROMClassCache.hpp"
 
 class JITServerHelpers
    {
@@ -68,16 +69,25 @@ class JITServerHelpers
       TR_OpaqueClassBlock *, TR_OpaqueClassBlock *,                  // 14: _componentClass         15: _arrayClass
       uintptr_t, J9ROMClass *,                                       // 16: _totalInstanceSize      17: _remoteRomClass
       uintptr_t, uintptr_t,                                          // 18: _constantPool           19: _classFlags
-      uintptr_t, std::vector<J9ROMMethod *>                          // 20: _classChainOffsetOfIdentifyingLoaderForClazz 21. _origROMMethods
+      uintptr_t, std::vector<J9ROMMethod *>,                         // 20: _classChainOffsetOfIdentifyingLoaderForClazz 21. _origROMMethods
+      JITServerROMClassHash                                          // 22: hash of the packed ROM class when it is not serialized
       >;
 
-   static ClassInfoTuple packRemoteROMClassInfo(J9Class *clazz, J9VMThread *vmThread, TR_Memory *trMemory, bool serializeClass);
-   static void cacheRemoteROMClass(ClientSessionData *clientSessionData, J9Class *clazz, J9ROMClass *romClass, ClassInfoTuple *classInfoTuple);
+   static ClassInfoTuple packRemoteROMClassInfo(J9Class *clazz, J9VMThread *vmThread, TR_Memory *trMemory, bool serializeClass, bool sendHashOnly = false);
+   static std::string packROMClass(J9ROMClass *romClass, TR_Memory *trMemory);
+   // Returns the ROM class cached for clazz, which is not romClass if another thread cached it first
+   static J9ROMClass *cacheRemoteROMClass(ClientSessionData *clientSessionData, J9Class *clazz, J9ROMClass *romClass, ClassInfoTuple *classInfoTuple);
    static void cacheRemoteROMClass(ClientSessionData *clientSessionData, J9Class *clazz, J9ROMClass *romClass, ClassInfoTuple *classInfoTuple, ClientSessionData::ClassInfo &classInfo);
    static J9ROMClass *getRemoteROMClassIfCached(ClientSessionData *clientSessionData, J9Class *clazz);
-   static J9ROMClass *getRemoteROMClass(J9Class *, JITServer::ServerStream *stream, TR_Memory *trMemory, ClassInfoTuple *classInfoTuple);
-   static J9ROMClass *getRemoteROMClass(J9Class *, JITServer::ServerStream *stream, TR_PersistentMemory *trMemory, ClassInfoTuple *classInfoTuple);
+   // Cache the classes sent by the client along with a compilation request
+   static void cachePrefetchedClasses(ClientSessionData *clientSessionData, const std::vector<J9Class *> &classes,
+                                      std::vector<ClassInfoTuple> &classInfoTuples, TR_PersistentMemory *trMemory);
+   static J9ROMClass *getRemoteROMClass(J9Class *, ClientSessionData *clientSessionData, JITServer::ServerStream *stream, TR_Memory *trMemory, ClassInfoTuple *classInfoTuple);
+   static J9ROMClass *getRemoteROMClass(J9Class *, ClientSessionData *clientSessionData, JITServer::ServerStream *stream, TR_PersistentMemory *trMemory, ClassInfoTuple *classInfoTuple);
+   // ROM classes created by the following routine are shared between client sessions
+   // when the shared ROM class cache is enabled and must be freed with freeRemoteROMClass()
    static J9ROMClass *romClassFromString(const std::string &romClassStr, TR_PersistentMemory *trMemory);
+   static void freeRemoteROMClass(J9ROMClass *romClass);
    static bool getAndCacheRAMClassInfo(J9Class *clazz, ClientSessionData *clientSessionData, JITServer::ServerStream *stream, ClassInfoDataType dataType, void *data);
    static bool getAndCacheRAMClassInfo(J9Class *clazz, ClientSessionData *clientSessionData, JITServer::ServerStream *stream, ClassInfoDataType dataType1, void *data1,
                                        ClassInfoDataType dataType2, void *data2);
@@ -95,6 +105,8 @@ class JITServerHelpers
    static bool isServerAvailable() { return _serverAvailable; }
 
    static void printJITServerMsgStats(J9JITConfig *, TR::CompilationInfo *);
+   // Summary of the message types that account for most of the messaging time, written to the vlog
+   static void printJITServerMsgLatencySummary(TR::CompilationInfo *);
    static void printJITServerCHTableStats(J9JITConfig *, TR::CompilationInfo *);
    static void printJITServerCacheStats(J9JITConfig *, TR::CompilationInfo *);
 
@@ -57,6 +57,10 @@ void TR_MethodToBeCompiled::initialize(TR::IlGeneratorMethodDetails & details, v
    _methodDetails = TR::IlGeneratorMethodDetails::clone(_methodDetailsStorage, details);
    _optimizationPlan = optimizationPlan;
    _next = NULL;
+   _prev = NULL;
+   _nextInQueueIndex = NULL;
+   _queueIndexKey = NULL;
+   _hasQueuePriorityTail = false;
    _oldStartPC = oldStartPC;
    _newStartPC = NULL;
    _priority = p;
@@ -90,6 +94,8 @@ void TR_MethodToBeCompiled::initialize(TR::IlGeneratorMethodDetails & details, v
    _clientOptions = NULL;
    _clientOptionsSize = 0;
    _origOptLevel = unknownHotness;
+   _nextArrived = NULL;
+   _prevArrived = NULL;
 #endif /* defined(J9VM_OPT_JITSERVER) */
 
    TR_ASSERT_FATAL(_freeTag & ENTRY_IN_POOL_FREE, "initializing an entry which is not free");
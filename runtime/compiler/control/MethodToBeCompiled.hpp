@@ -81,6 +81,11 @@ struct TR_MethodToBeCompiled
 #endif /* defined(J9VM_OPT_JITSERVER) */
 
    TR_MethodToBeCompiled *_next;
+   // Links below are maintained by CompilationInfo::queueEntry/dequeueEntry and are
+   // only meaningful while the entry is in the main compilation queue
+   TR_MethodToBeCompiled *_prev;
+   TR_MethodToBeCompiled *_nextInQueueIndex; // next entry in the same bucket of the queue index
+   J9Method              *_queueIndexKey; // method the entry is indexed by; NULL if not indexed
    TR::IlGeneratorMethodDetails _methodDetailsStorage;
    TR::IlGeneratorMethodDetails *_methodDetails;
    void                  *_oldStartPC;
@@ -133,12 +138,16 @@ struct TR_MethodToBeCompiled
    uint8_t                _weight; // Up to 256 levels of weight
    bool                   _hasIncrementedNumCompThreadsCompilingHotterMethods;
    uint8_t                _jitStateWhenQueued;
+   bool                   _hasQueuePriorityTail; // entry is accounted for in the priority tail table of the queue
 #if defined(J9VM_OPT_JITSERVER)
    bool                   _remoteCompReq; // Comp request should be sent remotely to JITServer
    JITServer::ServerStream  *_stream; // A non-NULL field denotes an out-of-process compilation request
    char                  *_clientOptions;
    size_t                 _clientOptionsSize;
    TR_Hotness             _origOptLevel; //  Cache original optLevel when transforming a remote sync compilation to a local cheap one
+   // Server: queued out-of-process requests in arrival order; maintained by CompilationInfo::queueEntry/dequeueEntry
+   TR_MethodToBeCompiled *_nextArrived;
+   TR_MethodToBeCompiled *_prevArrived;
 #endif /* defined(J9VM_OPT_JITSERVER) */
    }; // TR_MethodToBeCompiled
 
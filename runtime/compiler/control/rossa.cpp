@@ -113,6 +113,8 @@
 #include "net/ClientStream.hpp"
 #include "net/LoadSSLLibs.hpp"
 #include "runtime/JITClientSession.hpp"
+#include "runtime/JITServerROMClassCache.hpp"
+#include "runtime/JITServerAOTCache.hpp"
 #include "runtime/Listener.hpp"
 #include "runtime/JITServerStatisticsThread.hpp"
 #include "runtime/JITServerIProfiler.hpp"
@@ -1682,6 +1684,37 @@ onLoadInternal(
       // Allocate the hashtable that holds information about clients
       compInfo->setClientSessionHT(ClientSessionHT::allocate());
 
+      // Both caches identify ROM classes by a SHA-256 digest computed with OpenSSL
+      if ((compInfo->getPersistentInfo()->getJITServerShareROMClasses() ||
+           compInfo->getPersistentInfo()->getJITServerUseAOTCache()) &&
+          !JITServerROMClassHash::init())
+         {
+         if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+            TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "OpenSSL digests not available; disabling shared ROM class cache and AOT cache");
+         compInfo->getPersistentInfo()->setJITServerShareROMClasses(false);
+         compInfo->getPersistentInfo()->setJITServerUseAOTCache(false);
+         }
+
+      if (compInfo->getPersistentInfo()->getJITServerShareROMClasses())
+         {
+         compInfo->setJITServerSharedROMClassCache(new (PERSISTENT_NEW) JITServerSharedROMClassCache());
+         if (!compInfo->getJITServerSharedROMClassCache())
+            {
+            j9tty_printf(PORTLIB, "JITServer shared ROM class cache not allocated, abort.\n");
+            return -1;
+            }
+         }
+
+      if (compInfo->getPersistentInfo()->getJITServerUseAOTCache())
+         {
+         compInfo->setJITServerAOTCacheMap(new (PERSISTENT_NEW) JITServerAOTCacheMap(compInfo->getPersistentInfo()->getJITServerAOTCacheMaxBytes()));
+         if (!compInfo->getJITServerAOTCacheMap())
+            {
+            j9tty_printf(PORTLIB, "JITServer AOT cache map not allocated, abort.\n");
+            return -1;
+            }
+         }
+
       ((TR_JitPrivateConfig*)(jitConfig->privateConfig))->listener = TR_Listener::allocate();
       if (!((TR_JitPrivateConfig*)(jitConfig->privateConfig))->listener)
          {
@@ -1719,6 +1752,9 @@ onLoadInternal(
       if (JITServer::ClientStream::static_init(compInfo->getPersistentInfo()) != 0)
          return -1;
 
+      // Without OpenSSL digests the client sends full ROM classes to the server
+      JITServerROMClassHash::init();
+
       JITServer::CommunicationStream::initConfigurationFlags();
       }
 #endif // J9VM_OPT_JITSERVER
@@ -23,6 +23,8 @@
 #include "control/CompilationRuntime.hpp"
 
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 #include "jni.h"
 #include "j9.h"
 #include "j9port.h"
@@ -30,6 +32,7 @@
 #include "control/Options_inlines.hpp"
 #include "env/CpuUtilization.hpp"
 #include "env/VerboseLog.hpp"
+#include "infra/Assert.hpp"
 
 /*
  * Relevant port library API:
@@ -381,6 +384,90 @@ double TR_CpuEntitlement::computeGuestCpuEntitlement() const
       return 0.0;
    }
 
+// Keys of the cgroup CPU metrics reported by the port library
+static const char * const CGROUP_CPU_QUOTA_METRIC = "CPU Quota"; // cgroup v1 cpu.cfs_quota_us
+static const char * const CGROUP_CPU_PERIOD_METRIC = "CPU Period"; // cgroup v1 cpu.cfs_period_us
+static const char * const CGROUP_CPU_MAX_METRIC = "CPU Quota and Period"; // cgroup v2 cpu.max
+
+void TR_CpuEntitlement::applyCgroupCpuMetric(const char *metricKey, const char *value, int64_t &quota, int64_t &period)
+   {
+   // The quota is negative (cgroup v1) or not a number (cgroup v2 "max") when there is no limit
+   char *end = NULL;
+   int64_t number = strtoll(value, &end, 10);
+   if (end == value)
+      return;
+   if (!strcmp(metricKey, CGROUP_CPU_QUOTA_METRIC))
+      {
+      quota = number;
+      }
+   else if (!strcmp(metricKey, CGROUP_CPU_PERIOD_METRIC))
+      {
+      period = number;
+      }
+   else if (!strcmp(metricKey, CGROUP_CPU_MAX_METRIC))
+      {
+      // cgroup v2 reports the quota and the period together, as "quota period"
+      quota = number;
+      int64_t periodValue = strtoll(end, &end, 10);
+      if (periodValue > 0)
+         period = periodValue;
+      }
+   }
+
+#if defined(DEBUG)
+void TR_CpuEntitlement::checkCgroupCpuMetricParsing()
+   {
+   int64_t quota = -1;
+   int64_t period = 0;
+   applyCgroupCpuMetric(CGROUP_CPU_QUOTA_METRIC, "50000", quota, period);
+   applyCgroupCpuMetric(CGROUP_CPU_PERIOD_METRIC, "100000", quota, period);
+   // Counters of cpu.stat must not be taken for the quota or the period
+   applyCgroupCpuMetric("Period intervals elapsed count", "123456", quota, period);
+   applyCgroupCpuMetric("Throttled count", "42", quota, period);
+   TR_ASSERT_FATAL((quota == 50000) && (period == 100000), "Wrong cgroup v1 CPU quota %lld or period %lld", (long long)quota, (long long)period);
+
+   quota = -1;
+   period = 0;
+   applyCgroupCpuMetric(CGROUP_CPU_MAX_METRIC, "200000 100000", quota, period);
+   applyCgroupCpuMetric("Period intervals elapsed count", "123456", quota, period);
+   TR_ASSERT_FATAL((quota == 200000) && (period == 100000), "Wrong cgroup v2 CPU quota %lld or period %lld", (long long)quota, (long long)period);
+
+   quota = -1;
+   period = 0;
+   applyCgroupCpuMetric(CGROUP_CPU_MAX_METRIC, "max 100000", quota, period);
+   TR_ASSERT_FATAL(quota < 0, "Unlimited cgroup v2 CPU quota read as %lld", (long long)quota);
+   }
+#endif /* defined(DEBUG) */
+
+// Read the CPU bandwidth limit of the cgroup the JVM runs in through the port library cgroup metrics.
+// Returns the limit in percentage points of a CPU, or 0 if there is no limit or it cannot be read
+double TR_CpuEntitlement::computeCgroupCpuEntitlement() const
+   {
+   OMRPORT_ACCESS_FROM_J9PORT(_jitConfig->javaVM->portLibrary);
+   if (OMR_CGROUP_SUBSYSTEM_CPU != omrsysinfo_cgroup_are_subsystems_enabled(OMR_CGROUP_SUBSYSTEM_CPU))
+      return 0.0;
+
+   int64_t quota = -1;
+   int64_t period = 0;
+   OMRCgroupMetricIteratorState state = {0};
+   if (0 == omrsysinfo_cgroup_subsystem_iterator_init(OMR_CGROUP_SUBSYSTEM_CPU, &state))
+      {
+      while (0 != omrsysinfo_cgroup_subsystem_iterator_hasNext(&state))
+         {
+         const char *metricKey = NULL;
+         OMRCgroupMetricElement element = {0};
+         if (0 != omrsysinfo_cgroup_subsystem_iterator_metricKey(&state, &metricKey) ||
+             0 != omrsysinfo_cgroup_subsystem_iterator_next(&state, &element))
+            continue;
+         applyCgroupCpuMetric(metricKey, element.value, quota, period);
+         }
+      omrsysinfo_cgroup_subsystem_iterator_destroy(&state);
+      }
+   if (quota > 0 && period > 0)
+      return (double)quota * 100 / period;
+   return 0.0;
+   }
+
 void TR_CpuEntitlement::computeAndCacheCpuEntitlement()
    {
    PORT_ACCESS_FROM_JITCONFIG(_jitConfig);
@@ -401,5 +488,16 @@ void TR_CpuEntitlement::computeAndCacheCpuEntitlement()
       {
       _jvmCpuEntitlement = numTargetCpuEntitlement;
       }
+
+   // A container CPU quota may allow fewer CPUs than the JVM can run on
+   _cgroupCpuEntitlement = computeCgroupCpuEntitlement();
+   if (_cgroupCpuEntitlement > 0 && _cgroupCpuEntitlement < _jvmCpuEntitlement)
+      _jvmCpuEntitlement = _cgroupCpuEntitlement;
+
+   _numEntitledCpu = (uint32_t)((_jvmCpuEntitlement + 99) / 100);
+   if (_numEntitledCpu == 0)
+      _numEntitledCpu = 1;
+   if (_numEntitledCpu > _numTargetCpu)
+      _numEntitledCpu = _numTargetCpu;
    }
 
@@ -201,20 +201,37 @@ public:
        */
       _hypervisorPresent = TR_no;
       _jitConfig = jitConfig;
+#if defined(DEBUG)
+      checkCgroupCpuMetricParsing();
+#endif
       computeAndCacheCpuEntitlement();
       }
    bool isHypervisorPresent();
    void computeAndCacheCpuEntitlement(); // used during bootstrap and periodically in samplerThreadProc
    uint32_t getNumTargetCPUs()     const { return _numTargetCpu; }  // num CPUs the JVM is pinned to. Guaranteed >= 1
    double getGuestCpuEntitlement() const { return _guestCpuEntitlement; } // as given by the hypervisor; 0 if error or no hypervisor
-   double getJvmCpuEntitlement()   const { return _jvmCpuEntitlement; } // smallest of _numTargetCpu and _guestCpuEntitlement
+   double getJvmCpuEntitlement()   const { return _jvmCpuEntitlement; } // smallest of _numTargetCpu, _guestCpuEntitlement and _cgroupCpuEntitlement
+   double getCgroupCpuEntitlement() const { return _cgroupCpuEntitlement; } // from the cgroup CPU quota; 0 if there is no quota
+   // Number of CPUs the JVM can keep busy: _numTargetCpu capped by the rounded up CPU entitlement. Guaranteed >= 1
+   uint32_t getNumEntitledCPUs()   const { return _numEntitledCpu; }
+
+   // Apply one metric of the cgroup CPU subsystem, as named by the port library, to the quota and
+   // period read so far. Only the exact quota and period keys are used; other metrics of the subsystem,
+   // like the "Period intervals elapsed count" counter of cpu.stat, are ignored
+   static void applyCgroupCpuMetric(const char *metricKey, const char *value, int64_t &quota, int64_t &period);
 
 private:
    double computeGuestCpuEntitlement() const; // this does not check for isHypervisorPresent, so don't call it directly
+   double computeCgroupCpuEntitlement() const;
+#if defined(DEBUG)
+   static void checkCgroupCpuMetricParsing();
+#endif
 
    TR_YesNoMaybe _hypervisorPresent;
    uint32_t      _numTargetCpu;
+   uint32_t      _numEntitledCpu;
    double        _guestCpuEntitlement;
+   double        _cgroupCpuEntitlement;
    double        _jvmCpuEntitlement;
    J9JITConfig * _jitConfig;
    };
@@ -135,6 +135,12 @@ class PersistentInfo : public OMR::PersistentInfoConnector
          _JITServerPort(38400),
          _socketTimeoutMs(2000),
          _clientUID(0),
+         _JITServerUseCompression(false),
+         _JITServerCompressionThreshold(4096),
+         _JITServerShareROMClasses(true),
+         _JITServerMaxPrefetchedClasses(16),
+         _JITServerUseAOTCache(false),
+         _JITServerAOTCacheMaxBytes(300 * 1024 * 1024),
 #endif /* defined(J9VM_OPT_JITSERVER) */
       OMR::PersistentInfoConnector(pm)
       {}
@@ -307,6 +313,20 @@ class PersistentInfo : public OMR::PersistentInfoConnector
    void setJITServerPort(uint32_t port) { _JITServerPort = port; }
    uint64_t getClientUID() const { return _clientUID; }
    void setClientUID(uint64_t val) { _clientUID = val; }
+   bool getJITServerUseCompression() const { return _JITServerUseCompression; }
+   void setJITServerUseCompression(bool b) { _JITServerUseCompression = b; }
+   uint32_t getJITServerCompressionThreshold() const { return _JITServerCompressionThreshold; }
+   void setJITServerCompressionThreshold(uint32_t t) { _JITServerCompressionThreshold = t; }
+   bool getJITServerShareROMClasses() const { return _JITServerShareROMClasses; }
+   void setJITServerShareROMClasses(bool b) { _JITServerShareROMClasses = b; }
+   uint32_t getJITServerMaxPrefetchedClasses() const { return _JITServerMaxPrefetchedClasses; }
+   void setJITServerMaxPrefetchedClasses(uint32_t n) { _JITServerMaxPrefetchedClasses = n; }
+   bool getJITServerUseAOTCache() const { return _JITServerUseAOTCache; }
+   void setJITServerUseAOTCache(bool b) { _JITServerUseAOTCache = b; }
+   const std::string &getJITServerAOTCacheIdentity() const { return _JITServerAOTCacheIdentity; }
+   void setJITServerAOTCacheIdentity(const std::string &identity) { _JITServerAOTCacheIdentity = identity; }
+   size_t getJITServerAOTCacheMaxBytes() const { return _JITServerAOTCacheMaxBytes; }
+   void setJITServerAOTCacheMaxBytes(size_t bytes) { _JITServerAOTCacheMaxBytes = bytes; }
 #endif /* defined(J9VM_OPT_JITSERVER) */
 
    private:
@@ -397,6 +417,13 @@ class PersistentInfo : public OMR::PersistentInfoConnector
    uint32_t    _JITServerPort;
    uint32_t    _socketTimeoutMs; // timeout for communication sockets used in out-of-process JIT compilation
    uint64_t    _clientUID;
+   bool        _JITServerUseCompression; // client: request compressed messages; server: accept requests for compression
+   uint32_t    _JITServerCompressionThreshold; // messages smaller than this (bytes) are never compressed
+   bool        _JITServerShareROMClasses; // server: deduplicate ROM classes cached for different clients
+   uint32_t    _JITServerMaxPrefetchedClasses; // client: max number of classes sent ahead with a compilation request
+   bool        _JITServerUseAOTCache; // client: request cached AOT bodies; server: keep AOT bodies for reuse by identical clients
+   std::string _JITServerAOTCacheIdentity; // client: cache name, '\0', and the options that change the generated code
+   size_t      _JITServerAOTCacheMaxBytes; // server: bodies are no longer stored once all AOT caches reach this size
 #endif /* defined(J9VM_OPT_JITSERVER) */
    };
 
@@ -113,7 +113,8 @@ TR_J9SharedCache::getCachedCCVResult(TR_OpaqueClassBlock *clazz)
       TR::ClassTableCriticalSection cacheResult(_fe);
       TR_PersistentCHTable *table = _compInfo->getPersistentInfo()->getPersistentCHTable();
       TR_PersistentClassInfo *classInfo = table->findClassInfo(clazz);
-      return classInfo->getCCVResult();
+      if (classInfo)
+         return classInfo->getCCVResult();
       }
    return CCVResult::notYetValidated;
    }
@@ -126,8 +127,11 @@ TR_J9SharedCache::cacheCCVResult(TR_OpaqueClassBlock *clazz, CCVResult result)
       TR::ClassTableCriticalSection cacheResult(_fe);
       TR_PersistentCHTable *table = _compInfo->getPersistentInfo()->getPersistentCHTable();
       TR_PersistentClassInfo *classInfo = table->findClassInfo(clazz);
-      classInfo->setCCVResult(result);
-      return true;
+      if (classInfo)
+         {
+         classInfo->setCCVResult(result);
+         return true;
+         }
       }
    return false;
    }
@@ -20,6 +20,7 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <algorithm>
 #include "JITServerPersistentCHTable.hpp"
 #include "compile/Compilation.hpp"
 #include "control/CompilationRuntime.hpp"
@@ -135,6 +136,7 @@ void
 JITServerPersistentCHTable::commitModifications(const std::string &rawData)
    {
    std::unordered_map<TR_OpaqueClassBlock*, std::pair<FlatPersistentClassInfo*, TR_PersistentClassInfo*>> infoMap;
+   std::vector<std::pair<FlatPersistentClassInfo*, TR_PersistentClassInfo*>> addedSubClasses;
 
    // First, process all TR_PersistentClassInfo entries that have been
    // modified at the client without worrying about subclasses
@@ -144,9 +146,19 @@ JITServerPersistentCHTable::commitModifications(const std::string &rawData)
       {
       TR_ASSERT(bytesRead < rawData.length(), "Corrupt CHTable!!");
       FlatPersistentClassInfo *info = (FlatPersistentClassInfo*)&rawData[bytesRead];
-      TR_OpaqueClassBlock *classId = (TR_OpaqueClassBlock *) (((uintptr_t) info->_classId) & ~(uintptr_t)1);
+      TR_OpaqueClassBlock *classId = info->getClassId();
       TR_ASSERT(classId, "Class cannot be null (on server)");
       TR_PersistentClassInfo* clazz = findClassInfo(classId);
+      if (info->hasAddedSubClassesOnly())
+         {
+         // The class was sent earlier; only its new subclasses are listed
+         if (clazz)
+            addedSubClasses.push_back({info, clazz});
+         else
+            fprintf(stderr, "CHTable WARNING: classInfo for %p is null, ignoring its added subclasses\n", classId);
+         bytesRead += sizeof(FlatPersistentClassInfo) + info->_numSubClasses * sizeof(TR_OpaqueClassBlock*);
+         continue;
+         }
       if (!clazz)
          {
          clazz = new (PERSISTENT_NEW) TR_PersistentClassInfo(NULL);
@@ -176,6 +188,30 @@ JITServerPersistentCHTable::commitModifications(const std::string &rawData)
             fprintf(stderr, "CHTable WARNING: classInfo for subclass %p of %p is null, ignoring\n", flat->_subClasses[i], flat->_classId);
          }
       }
+
+   // Append added subclasses. The subclass may already be listed if the server
+   // got the whole hierarchy after the client recorded the addition.
+   for (auto it : addedSubClasses)
+      {
+      auto flat = it.first;
+      auto persist = it.second;
+      for (size_t i = 0; i < flat->_numSubClasses; i++)
+         {
+         auto classInfo = findClassInfo(flat->_subClasses[i]);
+         TR_ASSERT_FATAL(classInfo, "subclass info cannot be null: ensure subclasses are loaded before superclass");
+         if (!classInfo)
+            {
+            fprintf(stderr, "CHTable WARNING: classInfo for subclass %p of %p is null, ignoring\n", flat->_subClasses[i], flat->getClassId());
+            continue;
+            }
+         bool found = false;
+         for (TR_SubClass *sc = persist->getFirstSubclass(); sc && !found; sc = sc->getNext())
+            found = (sc->getClassInfo() == classInfo);
+         if (!found)
+            persist->addSubClass(classInfo);
+         }
+      count++;
+      }
    CHTABLE_UPDATE_COUNTER(_numClassesUpdated, count);
    }
 
@@ -260,6 +296,27 @@ JITClientPersistentCHTable::serializeModifications()
       numBytes += size;
       }
 
+   // Subclass additions are redundant for classes that are sent whole, and
+   // must be dropped for classes that have been unloaded since
+   auto addedEnd = std::remove_if(_addedSubClasses.begin(), _addedSubClasses.end(),
+      [this](const std::pair<TR_OpaqueClassBlock*, TR_OpaqueClassBlock*> &added)
+         {
+         return _dirty.count(added.first) || !findClassInfo(added.first) || !findClassInfo(added.second);
+         });
+   _addedSubClasses.erase(addedEnd, _addedSubClasses.end());
+   std::sort(_addedSubClasses.begin(), _addedSubClasses.end());
+   size_t numAddedSubClassEntries = 0;
+   for (size_t i = 0; i < _addedSubClasses.size(); i++)
+      {
+      TR_OpaqueClassBlock *superClass = _addedSubClasses[i].first;
+      if (i == 0 || superClass != _addedSubClasses[i-1].first)
+         {
+         numBytes += sizeof(FlatPersistentClassInfo);
+         numAddedSubClassEntries++;
+         }
+      numBytes += sizeof(TR_OpaqueClassBlock*);
+      }
+
    std::string data(numBytes, '\0');
 
    size_t bytesWritten = 0;
@@ -272,9 +329,26 @@ JITClientPersistentCHTable::serializeModifications()
       bytesWritten += FlatPersistentClassInfo::serializeClass(clazz, info);
       count++;
       }
-   CHTABLE_UPDATE_COUNTER(_numClassesUpdated, count);
+
+   FlatPersistentClassInfo *info = NULL;
+   for (size_t i = 0; i < _addedSubClasses.size(); i++)
+      {
+      TR_OpaqueClassBlock *superClass = _addedSubClasses[i].first;
+      if (i == 0 || superClass != _addedSubClasses[i-1].first)
+         {
+         info = (FlatPersistentClassInfo*)&data[bytesWritten];
+         info->_classId = (TR_OpaqueClassBlock *)((uintptr_t)superClass | FlatPersistentClassInfo::ADDED_SUBCLASSES_ONLY);
+         info->_numSubClasses = 0;
+         bytesWritten += sizeof(FlatPersistentClassInfo);
+         }
+      info->_subClasses[info->_numSubClasses++] = _addedSubClasses[i].second;
+      bytesWritten += sizeof(TR_OpaqueClassBlock*);
+      }
+   TR_ASSERT(bytesWritten == numBytes, "CHTable update size mismatch");
+   CHTABLE_UPDATE_COUNTER(_numClassesUpdated, count + numAddedSubClassEntries);
 
    _dirty.clear();
+   _addedSubClasses.clear();
    return data;
    }
 
@@ -401,6 +475,7 @@ JITClientPersistentCHTable::JITClientPersistentCHTable(TR_PersistentMemory *trMe
    : TR_PersistentCHTable(trMemory)
    , _dirty(decltype(_dirty)::allocator_type(TR::Compiler->persistentAllocator()))
    , _remove(decltype(_remove)::allocator_type(TR::Compiler->persistentAllocator()))
+   , _addedSubClasses(decltype(_addedSubClasses)::allocator_type(TR::Compiler->persistentAllocator()))
    {
    }
 
@@ -508,6 +583,13 @@ JITClientPersistentCHTable::markDirty(TR_OpaqueClassBlock *clazz)
    _remove.erase(clazz);
    }
 
+void
+JITClientPersistentCHTable::markSubClassAdded(TR_OpaqueClassBlock *superClass, TR_PersistentClassInfo *subClass)
+   {
+   if (!_dirty.count(superClass))
+      _addedSubClasses.push_back({superClass, subClass->getClassId()});
+   }
+
 size_t
 JITClientPersistentCHTable::collectEntireHierarchy(std::vector<TR_PersistentClassInfo*> &out) const
    {
@@ -563,7 +645,7 @@ void TR_JITClientPersistentClassInfo::setFieldInfo(TR_PersistentClassInfoForFiel
 
 TR_SubClass *TR_JITClientPersistentClassInfo::addSubClass(TR_PersistentClassInfo *subClass)
    {
-   TR_JITClientPersistentClassInfo::_chTable->markDirty(getClassId());
+   TR_JITClientPersistentClassInfo::_chTable->markSubClassAdded(getClassId(), subClass);
    return TR_PersistentClassInfo::addSubClass(subClass);
    }
 
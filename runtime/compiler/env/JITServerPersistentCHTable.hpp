@@ -125,6 +125,13 @@ public:
    size_t collectEntireHierarchy(std::vector<TR_PersistentClassInfo*> &out) const;
    void markForRemoval(TR_OpaqueClassBlock *clazz);
    void markDirty(TR_OpaqueClassBlock *clazz);
+   /**
+    * @brief Record that subClass was added to the subclasses of superClass.
+    *        Unless superClass has other changes, only the added subclasses are
+    *        sent to the server instead of the whole list, which for classes
+    *        like java/lang/Object grows with every class loaded.
+    */
+   void markSubClassAdded(TR_OpaqueClassBlock *superClass, TR_PersistentClassInfo *subClass);
 #ifdef COLLECT_CHTABLE_STATS
    uint32_t _numUpdates; // aka numCompilations
    uint32_t _numCommitFailures;
@@ -141,6 +148,8 @@ private:
 
    PersistentUnorderedSet<TR_OpaqueClassBlock*> _dirty;
    PersistentUnorderedSet<TR_OpaqueClassBlock*> _remove;
+   // Subclasses added since the last update, for classes that are not dirty
+   PersistentVector<std::pair<TR_OpaqueClassBlock*, TR_OpaqueClassBlock*>> _addedSubClasses;
    };
 
 
@@ -162,6 +171,13 @@ public:
    static size_t serializeClass(TR_PersistentClassInfo *clazz, FlatPersistentClassInfo* info);
    static size_t deserializeClassSimple(TR_PersistentClassInfo *clazz, FlatPersistentClassInfo *info);
 
+   // Set in _classId of an entry that only lists subclasses added since the last
+   // update; the other fields of such an entry are not valid. Bit 0 is the
+   // initialized flag of TR_PersistentClassInfo.
+   static const uintptr_t ADDED_SUBCLASSES_ONLY = 2;
+   bool hasAddedSubClassesOnly() const { return ((uintptr_t)_classId & ADDED_SUBCLASSES_ONLY) != 0; }
+   TR_OpaqueClassBlock *getClassId() const { return (TR_OpaqueClassBlock *)((uintptr_t)_classId & ~(ADDED_SUBCLASSES_ONLY | (uintptr_t)1)); }
+
    TR_OpaqueClassBlock                *_classId;
 
    union
@@ -124,8 +124,30 @@ class TR_RuntimeAssumptionTable
 
    int32_t countRatAssumptions();
 
+   /**
+    * Scope in which the buckets of the RAT may be walked with getBucketPtr()
+    * and getNext() without holding assumptionTableMutex.
+    *
+    * Assumptions unlinked by reclaimMarkedAssumptionsFromRAT() are not freed
+    * while a reader is active, so a reader may see an assumption that is being
+    * removed but never freed memory. Readers must not modify the table; they
+    * acquire assumptionTableMutex and walk the bucket again once they find an
+    * assumption they need to act upon.
+    */
+   class Reader
+      {
+      public:
+      Reader(TR_RuntimeAssumptionTable *table);
+      ~Reader();
+
+      private:
+      TR_RuntimeAssumptionTable *_table;
+      };
+
    private:
    friend class OMR::RuntimeAssumption;
+   void freeUnlinkedAssumptions();
+
    void addAssumption(OMR::RuntimeAssumption *a, TR_RuntimeAssumptionKind kind, TR_FrontEnd *fe, OMR::RuntimeAssumption **sentinel);
    int32_t reclaimAssumptions(void *md, OMR::RuntimeAssumption **hashTable, OMR::RuntimeAssumption **possiblyRelevantHashTable);
 
@@ -135,6 +157,8 @@ class TR_RuntimeAssumptionTable
    uint32_t _marked;                            // Counts the number of assumptions waiting to be removed
    int32_t assumptionCount[LastAssumptionKind]; // this never gets decremented
    int32_t reclaimedAssumptionCount[LastAssumptionKind];
+   volatile uint32_t _numReaders;                   // Threads inside a Reader scope
+   OMR::RuntimeAssumption *_unlinkedAssumptions;    // Removed from the RAT, freed once there are no readers
    };
 
 #endif // RUNTIMEASSUMPTIONTABLE_HPP
@@ -2687,14 +2687,10 @@ TR_J9VMBase::isQueuedForVeryHotOrScorching(TR_ResolvedMethod *calleeMethod, TR::
    _compInfo->acquireCompMonitor(_vmThread);
    //Check again in case another thread has already upgraded this request
 
-   for (TR_MethodToBeCompiled *cur = TR::CompilationController::getCompilationInfo()->getMethodQueue(); cur; cur = cur->_next)
-      {
-      if (cur->getMethodDetails().getMethod() == (J9Method*) calleeMethod->getPersistentIdentifier() && cur->getMethodDetails().isOrdinaryMethod())
-         {
-         isQueuedForVeryHotOrScorching = cur->_optimizationPlan->getOptLevel() >= veryHot;
-         break;
-         }
-      }
+   TR::IlGeneratorMethodDetails details((J9Method *)calleeMethod->getPersistentIdentifier());
+   TR_MethodToBeCompiled *cur = _compInfo->findQueuedEntry(details, this);
+   if (cur)
+      isQueuedForVeryHotOrScorching = cur->_optimizationPlan->getOptLevel() >= veryHot;
 
    _compInfo->releaseCompMonitor(_vmThread);
    return isQueuedForVeryHotOrScorching;
@@ -5248,7 +5244,21 @@ TR_J9VMBase::getDesignatedCodeCache(TR::Compilation *comp) // MCT
    bool hadClassUnloadMonitor;
    bool hadVMAccess = releaseClassUnloadMonitorAndAcquireVMaccessIfNeeded(comp, &hadClassUnloadMonitor);
 
-   TR::CodeCache * result = TR::CodeCacheManager::instance()->reserveCodeCache(false, 0, compThreadID, &numReserved);
+   TR::CodeCache * result = NULL;
+   // Hot and scorching bodies, which include the callees they inline, go to
+   // the hot code cache while it has room. Profiling bodies are replaced soon,
+   // relocatable bodies are not run from this cache, and bodies compiled by
+   // the server are shipped to the client, so none of them belongs there.
+   if (comp && comp->getMethodHotness() >= hot &&
+       !comp->isProfilingCompilation() &&
+       !comp->compileRelocatableCode()
+#if defined(J9VM_OPT_JITSERVER)
+       && !comp->isOutOfProcessCompilation()
+#endif /* defined(J9VM_OPT_JITSERVER) */
+      )
+      result = TR::CodeCacheManager::instance()->reserveHotCodeCache(compThreadID);
+   if (!result)
+      result = TR::CodeCacheManager::instance()->reserveCodeCache(false, 0, compThreadID, &numReserved);
 
    acquireClassUnloadMonitorAndReleaseVMAccessIfNeeded(comp, hadVMAccess, hadClassUnloadMonitor);
    if (!result)
@@ -121,6 +121,7 @@ typedef struct TR_JitPrivateConfig
    TR::FILE      *rtLogFile;
    char          *rtLogFileName;
    char          *itraceFileNamePrefix;
+   char          *iprofilerSnapshotFileName;
    TR_IProfiler  *iProfiler;
    TR_HWProfiler *hwProfiler;
    TR_JProfilerThread  *jProfiler;
@@ -183,7 +183,7 @@ TR_J9ServerVM::getSystemClassFromClassName(const char * name, int32_t length, bo
    PersistentUnorderedMap<ClassLoaderStringPair, TR_OpaqueClassBlock*> & classBySignatureMap = _compInfoPT->getClientData()->getClassBySignatureMap();
 
    {
-   OMR::CriticalSection getSystemClassCS(_compInfoPT->getClientData()->getClassMapMonitor());
+   JITServerRWMutex::ReadCriticalSection getSystemClassCS(_compInfoPT->getClientData()->getClassMapRWMutex());
    auto it = classBySignatureMap.find(key);
    if (it != classBySignatureMap.end())
       return it->second;
@@ -194,7 +194,7 @@ TR_J9ServerVM::getSystemClassFromClassName(const char * name, int32_t length, bo
    TR_OpaqueClassBlock * clazz = std::get<0>(stream->read<TR_OpaqueClassBlock *>());
    if (clazz)
       {
-      OMR::CriticalSection getSystemClassCS(_compInfoPT->getClientData()->getClassMapMonitor());
+      JITServerRWMutex::WriteCriticalSection getSystemClassCS(_compInfoPT->getClientData()->getClassMapRWMutex());
       classBySignatureMap[key] = clazz;
       }
    else
@@ -217,7 +217,7 @@ bool
 TR_J9ServerVM::isMethodTracingEnabled(TR_OpaqueMethodBlock *method)
    {
       {
-      OMR::CriticalSection getRemoteROMClass(_compInfoPT->getClientData()->getROMMapMonitor());
+      JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(_compInfoPT->getClientData()->getJ9MethodMapRWMutex());
       auto it = _compInfoPT->getClientData()->getJ9MethodMap().find((J9Method*) method);
       if (it != _compInfoPT->getClientData()->getJ9MethodMap().end())
          {
@@ -309,7 +309,7 @@ TR_J9ServerVM::getClassFromSignature(const char *sig, int32_t length, TR_Resolve
    ClassLoaderStringPair key = {cl, std::string(sig, length)};
    PersistentUnorderedMap<ClassLoaderStringPair, TR_OpaqueClassBlock*> & classBySignatureMap = _compInfoPT->getClientData()->getClassBySignatureMap();
       {
-      OMR::CriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapMonitor());
+      JITServerRWMutex::ReadCriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapRWMutex());
       auto it = classBySignatureMap.find(key);
       if (it != classBySignatureMap.end())
          return it->second;
@@ -318,7 +318,7 @@ TR_J9ServerVM::getClassFromSignature(const char *sig, int32_t length, TR_Resolve
    clazz = getClassFromSignature(sig, length, (TR_OpaqueMethodBlock *)method->getPersistentIdentifier(), isVettedForAOT);
    if (clazz)
       {
-      OMR::CriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapMonitor());
+      JITServerRWMutex::WriteCriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapRWMutex());
       classBySignatureMap[key] = clazz;
       }
    else
@@ -670,7 +670,7 @@ TR_J9ServerVM::getOSRFrameSizeInBytes(TR_OpaqueMethodBlock * method)
    {
       {
       ClientSessionData *clientSessionData = _compInfoPT->getClientData();
-      OMR::CriticalSection getRemoteROMClass(clientSessionData->getROMMapMonitor());
+      JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(clientSessionData->getJ9MethodMapRWMutex());
       auto it = clientSessionData->getJ9MethodMap().find((J9Method*) method);
       if (it != clientSessionData->getJ9MethodMap().end())
          {
@@ -1466,7 +1466,7 @@ TR_OpaqueClassBlock *
 TR_J9ServerVM::getClassFromMethodBlock(TR_OpaqueMethodBlock *method)
    {
       {
-      OMR::CriticalSection getRemoteROMClass(_compInfoPT->getClientData()->getROMMapMonitor());
+      JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(_compInfoPT->getClientData()->getJ9MethodMapRWMutex());
       auto it = _compInfoPT->getClientData()->getJ9MethodMap().find((J9Method*) method);
       if (it != _compInfoPT->getClientData()->getJ9MethodMap().end())
          {
@@ -1799,7 +1799,7 @@ TR_J9ServerVM::getClassFromCP(J9ConstantPool *cp)
    auto & constantPoolMap = _compInfoPT->getClientData()->getConstantPoolToClassMap();
       {
       // check if the value is cached
-      OMR::CriticalSection getConstantPoolMonitor(_compInfoPT->getClientData()->getConstantPoolMonitor());
+      JITServerRWMutex::ReadCriticalSection getConstantPoolMap(_compInfoPT->getClientData()->getConstantPoolMapRWMutex());
       auto it = constantPoolMap.find(cp);
       if (it != constantPoolMap.end())
          return it->second;
@@ -1810,7 +1810,7 @@ TR_J9ServerVM::getClassFromCP(J9ConstantPool *cp)
    TR_OpaqueClassBlock * clazz = std::get<0>(stream->read<TR_OpaqueClassBlock *>());
    if (clazz)
       {
-      OMR::CriticalSection getConstantPoolMonitor(_compInfoPT->getClientData()->getConstantPoolMonitor());
+      JITServerRWMutex::WriteCriticalSection getConstantPoolMap(_compInfoPT->getClientData()->getConstantPoolMapRWMutex());
       constantPoolMap.insert({cp, clazz});
       }
    return clazz;
@@ -1859,7 +1859,7 @@ TR_J9ServerVM::getROMMethodFromRAMMethod(J9Method *ramMethod)
    {
       {
       // Check persistent cache first
-      OMR::CriticalSection J9MethodMapMonitor(_compInfoPT->getClientData()->getROMMapMonitor());
+      JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(_compInfoPT->getClientData()->getJ9MethodMapRWMutex());
       auto it = _compInfoPT->getClientData()->getJ9MethodMap().find(ramMethod);
       if (it != _compInfoPT->getClientData()->getJ9MethodMap().end())
          {
@@ -2127,7 +2127,7 @@ TR_J9SharedCacheServerVM::getClassFromSignature(const char * sig, int32_t sigLen
    ClassLoaderStringPair key = {cl, std::string(sig, sigLength)};
    PersistentUnorderedMap<ClassLoaderStringPair, TR_OpaqueClassBlock*> & classBySignatureMap = _compInfoPT->getClientData()->getClassBySignatureMap();
       {
-      OMR::CriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapMonitor());
+      JITServerRWMutex::ReadCriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapRWMutex());
       auto it = classBySignatureMap.find(key);
       if (it != classBySignatureMap.end())
          clazz = it->second;
@@ -2139,7 +2139,7 @@ TR_J9SharedCacheServerVM::getClassFromSignature(const char * sig, int32_t sigLen
       if (clazz)
          {
             {
-            OMR::CriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapMonitor());
+            JITServerRWMutex::WriteCriticalSection classFromSigCS(_compInfoPT->getClientData()->getClassMapRWMutex());
             classBySignatureMap[key] = clazz;
             }
          if (!validateClass((TR_OpaqueMethodBlock *)resolvedJITServerMethod->getPersistentIdentifier(), clazz, isVettedForAOT))
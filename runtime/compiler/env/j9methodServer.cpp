@@ -516,6 +516,14 @@ TR_ResolvedJ9JITServerMethod::getAttributesCache(bool isStatic, bool unresolvedI
    return attributesCache;
    }
 
+TR_ResolvedStringsCache *
+TR_ResolvedJ9JITServerMethod::getResolvedStringsCache()
+   {
+   // Return the persistent cache of resolved strings for regular JIT compilations.
+   // Must be called with the ROMMapMonitor in hand.
+   return &getJ9ClassInfo(_fe->_compInfoPT, _ramClass)._resolvedStringsCache;
+   }
+
 bool
 TR_ResolvedJ9JITServerMethod::getCachedFieldAttributes(int32_t cpIndex, TR_J9MethodFieldAttributes &attributes, bool isStatic)
    {
@@ -1044,11 +1052,12 @@ TR_ResolvedJ9JITServerMethod::getRemoteROMString(int32_t &len, void *basePtr, st
       std::string offsetsStr((char*) offsets.begin(), offsets.size() * sizeof(size_t));
       
       _stream->write(JITServer::MessageType::ResolvedMethod_getRemoteROMString, _remoteMirror, offsetFromROMClass, offsetsStr);
+      // Receive the string before reacquiring the monitor so that other threads are not blocked on the network
+      auto recv = _stream->read<std::string>();
          {
-         // reaquire the monitor
          OMR::CriticalSection getRemoteROMClass(threadCompInfo->getClientData()->getROMMapMonitor()); 
          auto &stringsCache = getJ9ClassInfo(threadCompInfo, _ramClass)._remoteROMStringsCache;
-         cachedStr = &(stringsCache.insert({key, std::get<0>(_stream->read<std::string>())}).first->second);
+         cachedStr = &(stringsCache.insert({key, std::move(std::get<0>(recv))}).first->second);
          }
       }
 
@@ -1218,11 +1227,12 @@ TR_ResolvedJ9JITServerMethod::fieldOrStaticName(I_32 cpIndex, int32_t & len, TR_
    if (!isCached)
       {
       _stream->write(JITServer::MessageType::ResolvedMethod_fieldOrStaticName, _remoteMirror, cpIndex);
+      // Receive the string before reacquiring the monitor so that other threads are not blocked on the network
+      auto recv = _stream->read<std::string>();
          {
-         // reaquire the monitor
          OMR::CriticalSection getRemoteROMClass(threadCompInfo->getClientData()->getROMMapMonitor()); 
          auto &stringsCache = getJ9ClassInfo(threadCompInfo, _ramClass)._fieldOrStaticNameCache;
-         cachedStr = &(stringsCache.insert({cpIndex, std::get<0>(_stream->read<std::string>())}).first->second);
+         cachedStr = &(stringsCache.insert({cpIndex, std::move(std::get<0>(recv))}).first->second);
          }
       }
 
@@ -1234,18 +1244,48 @@ void *
 TR_ResolvedJ9JITServerMethod::stringConstant(I_32 cpIndex)
    {
    TR_ASSERT(cpIndex != -1, "cpIndex shouldn't be -1");
+   auto compInfoPT = static_cast<TR::CompilationInfoPerThreadRemote *>(_fe->_compInfoPT);
+      {
+      // A string that was resolved in a previous compilation stays resolved
+      // until its class is unloaded or redefined, which purges the cache
+      OMR::CriticalSection getRemoteROMClass(compInfoPT->getClientData()->getROMMapMonitor());
+      if (auto resolvedStrings = getResolvedStringsCache())
+         {
+         auto it = resolvedStrings->find(cpIndex);
+         if (it != resolvedStrings->end())
+            return it->second;
+         }
+      }
+
    _stream->write(JITServer::MessageType::ResolvedMethod_stringConstant, _remoteMirror, cpIndex);
    auto recv = _stream->read<void *, bool, bool>();
+   void *stringAddress = std::get<0>(recv);
+   bool optimizeForAOTTrueResult = std::get<1>(recv);
+   bool optimizeForAOTFalseResult = std::get<2>(recv);
 
-   auto compInfoPT = static_cast<TR::CompilationInfoPerThreadRemote *>(_fe->_compInfoPT);
-   compInfoPT->cacheIsUnresolvedStr((TR_OpaqueClassBlock *) _ramClass, cpIndex, TR_IsUnresolvedString(std::get<1>(recv), std::get<2>(recv)));
-   return std::get<0>(recv);
+   if (!optimizeForAOTTrueResult && !optimizeForAOTFalseResult)
+      {
+      OMR::CriticalSection getRemoteROMClass(compInfoPT->getClientData()->getROMMapMonitor());
+      if (auto resolvedStrings = getResolvedStringsCache())
+         {
+         resolvedStrings->insert({ cpIndex, stringAddress });
+         return stringAddress;
+         }
+      }
+   compInfoPT->cacheIsUnresolvedStr((TR_OpaqueClassBlock *) _ramClass, cpIndex, TR_IsUnresolvedString(optimizeForAOTTrueResult, optimizeForAOTFalseResult));
+   return stringAddress;
    }
 
 bool
 TR_ResolvedJ9JITServerMethod::isUnresolvedString(I_32 cpIndex, bool optimizeForAOT)
    {
    auto compInfoPT = static_cast<TR::CompilationInfoPerThreadRemote *>(_fe->_compInfoPT);
+      {
+      OMR::CriticalSection getRemoteROMClass(compInfoPT->getClientData()->getROMMapMonitor());
+      auto resolvedStrings = getResolvedStringsCache();
+      if (resolvedStrings && resolvedStrings->find(cpIndex) != resolvedStrings->end())
+         return false;
+      }
    TR_IsUnresolvedString stringAttrs;
    if (compInfoPT->getCachedIsUnresolvedStr((TR_OpaqueClassBlock *) _ramClass, cpIndex, stringAttrs))
       {
@@ -26,6 +26,7 @@
 #include "j9cfg.h"
 #include "j9port.h"
 #include "j9thread.h"
+#include "env/CompilerEnv.hpp"
 #include "infra/Monitor.hpp"
 #include "infra/MonitorTable.hpp"
 
@@ -49,6 +50,10 @@ bool
 J9::Monitor::init(char *name)
    {
    setNext(0);
+   _collectContentionStats = false;
+   _numEnters = 0;
+   _numContendedEnters = 0;
+   _contendedWaitTimeNs = 0;
    if (j9thread_monitor_init_with_name((J9ThreadMonitor**)&_monitor, 0, name))
       return false;
    else
@@ -59,6 +64,10 @@ bool
 J9::Monitor::initFromVMMutex(void *mutex)
    {
    _monitor = (J9ThreadMonitor*)mutex;
+   _collectContentionStats = false;
+   _numEnters = 0;
+   _numContendedEnters = 0;
+   _contendedWaitTimeNs = 0;
    return true;
    }
 
@@ -66,7 +75,24 @@ void
 J9::Monitor::enter()
    {
    TR_ASSERT(_monitor != TR::MonitorTable::get()->getClassTableMutex()->getVMMonitor(), "Use TR::ClassTableCriticalSection instead");
+   if (!_collectContentionStats)
+      {
+      j9thread_monitor_enter(_monitor);
+      return;
+      }
+
+   if (j9thread_monitor_try_enter(_monitor) == 0)
+      {
+      _numEnters++;
+      return;
+      }
+
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   uint64_t startTime = j9time_nano_time();
    j9thread_monitor_enter(_monitor);
+   _contendedWaitTimeNs += j9time_nano_time() - startTime;
+   _numContendedEnters++;
+   _numEnters++;
    }
 
 void
@@ -70,6 +70,14 @@ class Monitor : public TR_Link0<TR::Monitor>
 
    int32_t owned_by_self(); // returns 1 if current thread owns the monitor, 0 otherwise
 
+   // Contention statistics are only collected for monitors that opt in;
+   // the counters are updated with the monitor in hand
+   void enableContentionStats() { _collectContentionStats = true; }
+   bool isCollectingContentionStats() const { return _collectContentionStats; }
+   uint64_t getNumEnters() const { return _numEnters; }
+   uint64_t getNumContendedEnters() const { return _numContendedEnters; }
+   uint64_t getContendedWaitTimeNs() const { return _contendedWaitTimeNs; }
+
    // Dangerous: do not use this routine, except for thread exit
    void *getVMMonitor() { return (void*)_monitor; }
 
@@ -85,6 +93,11 @@ class Monitor : public TR_Link0<TR::Monitor>
    bool initFromVMMutex(void *mutex);
 
    J9ThreadMonitor *_monitor;
+
+   bool _collectContentionStats;
+   uint64_t _numEnters;
+   uint64_t _numContendedEnters;
+   uint64_t _contendedWaitTimeNs;
    };
 
 }
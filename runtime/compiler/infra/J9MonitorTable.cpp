@@ -65,7 +65,6 @@ J9::MonitorTable::init(
 #else
    if (!table->_classUnloadMonitor.init("JIT-ClassUnloadMonitor")) return 0;
 #endif
-   if (!table->_iprofilerPersistenceMonitor.init("JIT-IProfilerPersistenceMonitor")) return 0;
 
    // Setup a wrapper for VM's monitors that the JIT can acquire
    if (!table->_classTableMutex.initFromVMMutex(javaVM->classTableMutex)) return 0;
@@ -189,8 +188,7 @@ J9::MonitorTable::isThreadInSafeMonitorState(J9VMThread *vmThread)
    if (_tableMonitor.owned_by_self()               ||
        _j9MemoryAllocMonitor.owned_by_self()       ||
        _j9ScratchMemoryPoolMonitor.owned_by_self() ||
-       _classTableMutex.owned_by_self()            ||
-       _iprofilerPersistenceMonitor.owned_by_self()
+       _classTableMutex.owned_by_self()
        )
       return false;
    {
@@ -220,8 +218,6 @@ J9::MonitorTable::monitorHeldByCurrentThread()
       return &_j9ScratchMemoryPoolMonitor;
    if (_classTableMutex.owned_by_self())
       return &_classTableMutex;
-   if (_iprofilerPersistenceMonitor.owned_by_self())
-      return &_iprofilerPersistenceMonitor;
    {
    OMR::CriticalSection walkMonitorTable(&_tableMonitor);
    for (TR::Monitor *monitor = (TR::Monitor *)_monitors.getFirst(); monitor; monitor = monitor->getNext())
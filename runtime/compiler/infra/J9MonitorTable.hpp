@@ -58,7 +58,6 @@ class OMR_EXTENSIBLE MonitorTable : public OMR::MonitorTableConnector
 
    J9::RWMonitor *getClassUnloadMonitor() { return &_classUnloadMonitor; }
    TR::Monitor *getClassTableMutex() { return &_classTableMutex; }
-   TR::Monitor *getIProfilerPersistenceMonitor() { return &_iprofilerPersistenceMonitor; }
    void removeAndDestroy(TR::Monitor *monitor);
 
    bool isThreadInSafeMonitorState(J9VMThread *vmThread);
@@ -87,7 +86,6 @@ class OMR_EXTENSIBLE MonitorTable : public OMR::MonitorTableConnector
    TR::Monitor _j9ScratchMemoryPoolMonitor;
    J9::RWMonitor _classUnloadMonitor;
    TR::Monitor _classTableMutex;  // JavaVM's class table mutex
-   TR::Monitor _iprofilerPersistenceMonitor;
 
    // To detect which thread has locked the classUnloadMonitor we will keep an array of integers
    // Each entry corresponds to a determined compilation thread. This way we avoid any
@@ -283,6 +283,7 @@ ClientStream::ClientStream(TR::PersistentInfo *info)
    int connfd = openConnection(info->getJITServerAddress(), info->getJITServerPort(), info->getSocketTimeout());
    BIO *ssl = openSSLConnection(_sslCtx, connfd);
    initStream(connfd, ssl);
+   setCompressionPolicy(info->getJITServerUseCompression(), info->getJITServerCompressionThreshold());
    _numConnectionsOpened++;
    }
 };
@@ -82,6 +82,17 @@ public:
       As a side-effect, this function may also embed version information in the message
       if this is the first message sent after a connection request.
    */
+   /**
+      @brief Set the priority of the next compilation request
+
+      The priority travels in the message header, so that the server
+      can order pending requests before reading them.
+   */
+   void setCompilationRequestPriority(uint16_t priority)
+      {
+      _nextMessageFlags = (uint32_t)priority << Message::MESSAGE_PRIORITY_SHIFT;
+      }
+
    template <typename... T>
    void buildCompileRequest(T... args)
       {
@@ -111,6 +122,9 @@ public:
       setArgsRaw<T...>(_cMsg, args...);
 
       writeMessage(_cMsg);
+      // Answer to the query that was read last
+      if (type == _sMsg.type())
+         recordQueryServiceTime(type);
       }
 
    /**
@@ -24,6 +24,8 @@
 #include "control/Options.hpp" // TR::Options::useCompressedPointers()
 #include "env/CompilerEnv.hpp" // for TR::Compiler->target.is64Bit()
 #include "net/CommunicationStream.hpp"
+#include <cstring> // for memcpy
+#include "zlib.h"
 
 
 namespace JITServer
@@ -32,6 +34,86 @@ uint32_t CommunicationStream::CONFIGURATION_FLAGS = 0;
 #ifdef MESSAGE_SIZE_STATS
 TR_Stats JITServer::CommunicationStream::collectMsgStat[];
 #endif
+CommunicationStream::CompressionStats CommunicationStream::compressionStats[] = {};
+CommunicationStream::MessageStats CommunicationStream::messageStats[] = {};
+
+static inline uint64_t
+currentTimeNs()
+   {
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   return j9time_nano_time();
+   }
+
+void
+CommunicationStream::MessageStats::recordSent(uint32_t bytes)
+   {
+   VM_AtomicSupport::addU32(&_numSent, 1);
+   VM_AtomicSupport::addU64(&_bytesSent, bytes);
+   }
+
+void
+CommunicationStream::MessageStats::recordReceived(uint32_t bytes)
+   {
+   VM_AtomicSupport::addU32(&_numReceived, 1);
+   VM_AtomicSupport::addU64(&_bytesReceived, bytes);
+   }
+
+void
+CommunicationStream::MessageStats::recordLatency(uint64_t timeNs, uint64_t waitTimeNs)
+   {
+   VM_AtomicSupport::addU32(&_numTimed, 1);
+   VM_AtomicSupport::addU64(&_totalTimeNs, timeNs);
+   VM_AtomicSupport::addU64(&_waitTimeNs, waitTimeNs);
+   uint64_t maxTimeNs = _maxTimeNs;
+   while (timeNs > maxTimeNs)
+      {
+      uint64_t oldMaxTimeNs = VM_AtomicSupport::lockCompareExchangeU64(&_maxTimeNs, maxTimeNs, timeNs);
+      if (oldMaxTimeNs == maxTimeNs)
+         break;
+      maxTimeNs = oldMaxTimeNs;
+      }
+   uint64_t timeUs = timeNs / 1000;
+   int bucket = 0;
+   while ((bucket < NUM_LATENCY_BUCKETS - 1) && (timeUs >= latencyBucketLimitUs(bucket)))
+      bucket++;
+   VM_AtomicSupport::addU32(&_latencyHistogram[bucket], 1);
+   }
+
+bool
+CommunicationStream::peekMessageFlags(uint32_t &flags)
+   {
+   char header[Message::HEADER_SIZE];
+   if (_numPendingBytes >= Message::HEADER_SIZE)
+      {
+      memcpy(header, _pendingBytes, Message::HEADER_SIZE);
+      }
+   else if ((_numPendingBytes == 0) && !_ssl)
+      {
+      if (recv(_connfd, header, Message::HEADER_SIZE, MSG_PEEK | MSG_DONTWAIT) != (ssize_t)Message::HEADER_SIZE)
+         return false;
+      }
+   else
+      {
+      // SSL records cannot be inspected without consuming them
+      return false;
+      }
+   flags = reinterpret_cast<Message::MetaData *>(header + sizeof(uint32_t))->_flags;
+   return true;
+   }
+
+uint64_t
+CommunicationStream::recordRoundTrip(MessageType type)
+   {
+   uint64_t roundTripTimeNs = _readEndTimeNs - _writeStartTimeNs;
+   messageStats[type].recordLatency(roundTripTimeNs, _readEndTimeNs - _writeEndTimeNs);
+   return roundTripTimeNs;
+   }
+
+void
+CommunicationStream::recordQueryServiceTime(MessageType type)
+   {
+   messageStats[type].recordLatency(_writeEndTimeNs - _readEndTimeNs, 0);
+   }
 
 void
 CommunicationStream::initConfigurationFlags()
@@ -64,6 +146,7 @@ void
 CommunicationStream::readMessage2(Message &msg)
    {
    msg.clearForRead();
+   TR_ASSERT_FATAL(_numPendingBytes == 0, "readMessage2 cannot consume %u bytes left over by readMessage", _numPendingBytes);
 
    // read message size
    uint32_t serializedSize;
@@ -78,6 +161,8 @@ CommunicationStream::readMessage2(Message &msg)
 
    // rebuild the message
    msg.deserialize();
+   _readEndTimeNs = currentTimeNs();
+   messageStats[msg.type()].recordReceived(serializedSize);
 
    // collect message size
 #ifdef MESSAGE_SIZE_STATS
@@ -85,30 +170,236 @@ CommunicationStream::readMessage2(Message &msg)
 #endif
    }
 
+void
+CommunicationStream::savePendingBytes(const char *data, uint32_t size)
+   {
+   if (size > _pendingBytesCapacity)
+      {
+      char *newStorage = static_cast<char *>(TR_Memory::jitPersistentAlloc(size));
+      if (!newStorage)
+         throw std::bad_alloc();
+      if (_pendingBytes)
+         TR_Memory::jitPersistentFree(_pendingBytes);
+      _pendingBytes = newStorage;
+      _pendingBytesCapacity = size;
+      }
+   memcpy(_pendingBytes, data, size);
+   _numPendingBytes = size;
+   }
+
+void
+CommunicationStream::ensureCompressionBufferCapacity(uint32_t requiredSize)
+   {
+   if (requiredSize > _compressionBufferCapacity)
+      {
+      char *newStorage = static_cast<char *>(TR_Memory::jitPersistentAlloc(requiredSize));
+      if (!newStorage)
+         throw std::bad_alloc();
+      if (_compressionBuffer)
+         TR_Memory::jitPersistentFree(_compressionBuffer);
+      _compressionBuffer = newStorage;
+      _compressionBufferCapacity = requiredSize;
+      }
+   }
+
+void
+CommunicationStream::freeCompressionResources()
+   {
+   if (_deflateStream)
+      {
+      deflateEnd(_deflateStream);
+      TR_Memory::jitPersistentFree(_deflateStream);
+      _deflateStream = NULL;
+      }
+   if (_inflateStream)
+      {
+      inflateEnd(_inflateStream);
+      TR_Memory::jitPersistentFree(_inflateStream);
+      _inflateStream = NULL;
+      }
+   if (_compressionBuffer)
+      {
+      TR_Memory::jitPersistentFree(_compressionBuffer);
+      _compressionBuffer = NULL;
+      _compressionBufferCapacity = 0;
+      }
+   }
+
+void
+CommunicationStream::writeCompressedMessage(Message &msg)
+   {
+   // Layout of a compressed message:
+   // message size | MetaData | size of the inflated body | deflated body
+   uint32_t uncompressedSize = msg.serializedSize();
+   uint32_t bodySize = uncompressedSize - Message::HEADER_SIZE;
+   int64_t startTime = j9thread_get_self_cpu_time(j9thread_self());
+
+   if (!_deflateStream)
+      {
+      _deflateStream = static_cast<z_stream *>(TR_Memory::jitPersistentAlloc(sizeof(z_stream)));
+      if (!_deflateStream)
+         throw std::bad_alloc();
+      memset(_deflateStream, 0, sizeof(z_stream));
+      _deflateStream->zalloc = Z_NULL;
+      _deflateStream->zfree = Z_NULL;
+      _deflateStream->opaque = Z_NULL;
+      // Favor speed over ratio: compression is on the critical path of remote compilations
+      if (deflateInit(_deflateStream, Z_BEST_SPEED) != Z_OK)
+         {
+         TR_Memory::jitPersistentFree(_deflateStream);
+         _deflateStream = NULL;
+         throw JITServer::StreamFailure("JITServer I/O error: cannot initialize compression");
+         }
+      }
+
+   // Worst case expansion of deflate (same as compressBound(); deflateBound() is not
+   // exported by j9zlib), plus the empty stored block emitted by Z_SYNC_FLUSH
+   static const uint32_t SYNC_FLUSH_OVERHEAD = 16;
+   uint32_t compressedHeaderSize = Message::HEADER_SIZE + sizeof(uint32_t);
+   uint32_t maxCompressedSize = compressedHeaderSize + bodySize + (bodySize >> 12) + (bodySize >> 14) + (bodySize >> 25) + 13 + SYNC_FLUSH_OVERHEAD;
+   ensureCompressionBufferCapacity(maxCompressedSize);
+
+   memcpy(_compressionBuffer, msg.getBufferStartForRead(), Message::HEADER_SIZE);
+   memcpy(_compressionBuffer + Message::HEADER_SIZE, &bodySize, sizeof(uint32_t));
+
+   _deflateStream->next_out = reinterpret_cast<Bytef *>(_compressionBuffer + compressedHeaderSize);
+   _deflateStream->avail_out = maxCompressedSize - compressedHeaderSize;
+
+   // Feed every block of the body to the compressor; data points added by
+   // reference are compressed straight from their source memory
+   msg.getIOVectors(_ioVectors);
+   uint32_t bytesToSkip = Message::HEADER_SIZE;
+   for (size_t i = 0; i < _ioVectors.size(); ++i)
+      {
+      char *blockStart = static_cast<char *>(_ioVectors[i].iov_base);
+      uint32_t blockSize = _ioVectors[i].iov_len;
+      if (bytesToSkip >= blockSize)
+         {
+         bytesToSkip -= blockSize;
+         continue;
+         }
+      _deflateStream->next_in = reinterpret_cast<Bytef *>(blockStart + bytesToSkip);
+      _deflateStream->avail_in = blockSize - bytesToSkip;
+      bytesToSkip = 0;
+      // Flush after the last block so that the receiver can inflate the whole message
+      int flush = (i == _ioVectors.size() - 1) ? Z_SYNC_FLUSH : Z_NO_FLUSH;
+      int ret = deflate(_deflateStream, flush);
+      if ((ret != Z_OK && ret != Z_BUF_ERROR) || _deflateStream->avail_in != 0)
+         throw JITServer::StreamFailure("JITServer I/O error: compression failed");
+      }
+
+   uint32_t compressedSize = maxCompressedSize - _deflateStream->avail_out;
+   *reinterpret_cast<uint32_t *>(_compressionBuffer) = compressedSize;
+   reinterpret_cast<Message::MetaData *>(_compressionBuffer + sizeof(uint32_t))->_flags |= Message::MESSAGE_COMPRESSED;
+
+   CompressionStats &stats = compressionStats[msg.type()];
+   stats._numCompressed++;
+   stats._uncompressedBytes += uncompressedSize;
+   stats._compressedBytes += compressedSize;
+   stats._compressionTimeNs += j9thread_get_self_cpu_time(j9thread_self()) - startTime;
+
+   writeBlocking(_compressionBuffer, compressedSize);
+   }
+
+uint32_t
+CommunicationStream::decompressMessage(Message &msg, uint32_t serializedSize)
+   {
+   int64_t startTime = j9thread_get_self_cpu_time(j9thread_self());
+   uint32_t compressedHeaderSize = Message::HEADER_SIZE + sizeof(uint32_t);
+   if (serializedSize < compressedHeaderSize)
+      throw JITServer::StreamFailure("JITServer I/O error: invalid compressed message size");
+
+   if (!_inflateStream)
+      {
+      _inflateStream = static_cast<z_stream *>(TR_Memory::jitPersistentAlloc(sizeof(z_stream)));
+      if (!_inflateStream)
+         throw std::bad_alloc();
+      memset(_inflateStream, 0, sizeof(z_stream));
+      _inflateStream->zalloc = Z_NULL;
+      _inflateStream->zfree = Z_NULL;
+      _inflateStream->opaque = Z_NULL;
+      if (inflateInit(_inflateStream) != Z_OK)
+         {
+         TR_Memory::jitPersistentFree(_inflateStream);
+         _inflateStream = NULL;
+         throw JITServer::StreamFailure("JITServer I/O error: cannot initialize decompression");
+         }
+      }
+
+   // Move the deflated body out of the way, then inflate it back into the message buffer
+   char *buffer = msg.getBufferStartForRead();
+   uint32_t bodySize = *reinterpret_cast<uint32_t *>(buffer + Message::HEADER_SIZE);
+   uint32_t compressedBodySize = serializedSize - compressedHeaderSize;
+   ensureCompressionBufferCapacity(compressedBodySize);
+   memcpy(_compressionBuffer, buffer + compressedHeaderSize, compressedBodySize);
+
+   uint32_t uncompressedSize = Message::HEADER_SIZE + bodySize;
+   if (uncompressedSize > msg.getBufferCapacity())
+      {
+      msg.expandBuffer(uncompressedSize, Message::HEADER_SIZE);
+      buffer = msg.getBufferStartForRead();
+      }
+
+   _inflateStream->next_in = reinterpret_cast<Bytef *>(_compressionBuffer);
+   _inflateStream->avail_in = compressedBodySize;
+   _inflateStream->next_out = reinterpret_cast<Bytef *>(buffer + Message::HEADER_SIZE);
+   _inflateStream->avail_out = bodySize;
+   int ret = Z_OK;
+   do
+      {
+      ret = inflate(_inflateStream, Z_SYNC_FLUSH);
+      } while (ret == Z_OK && _inflateStream->avail_in != 0);
+   if ((ret != Z_OK && ret != Z_BUF_ERROR) || _inflateStream->avail_in != 0 || _inflateStream->avail_out != 0)
+      throw JITServer::StreamFailure("JITServer I/O error: decompression failed");
+
+   Message::MetaData *metaData = reinterpret_cast<Message::MetaData *>(buffer + sizeof(uint32_t));
+   metaData->_flags &= ~Message::MESSAGE_COMPRESSED;
+   *reinterpret_cast<uint32_t *>(buffer) = uncompressedSize;
+
+   CompressionStats &stats = compressionStats[metaData->_type];
+   stats._numDecompressed++;
+   stats._decompressionTimeNs += j9thread_get_self_cpu_time(j9thread_self()) - startTime;
+   return uncompressedSize;
+   }
+
 void
 CommunicationStream::readMessage(Message &msg)
    {
    msg.clearForRead();
 
+   uint32_t bytesRead = 0;
+   if (_numPendingBytes > 0)
+      {
+      // A previous read returned the beginning of this message;
+      // start from those bytes instead of going to the socket
+      msg.expandBufferIfNeeded(_numPendingBytes);
+      memcpy(msg.getBufferStartForRead(), _pendingBytes, _numPendingBytes);
+      bytesRead = _numPendingBytes;
+      _numPendingBytes = 0;
+      }
+
    // The message buffer storage and its capacity could be
    // changed when the serialized size is set.
    char *buffer = msg.getBufferStartForRead();
    uint32_t bufferCapacity = msg.getBufferCapacity();
 
-   int32_t bytesRead = readOnceBlocking(buffer, bufferCapacity);
+   // readOnceBlocking() throws an exception if (bytesRead <= 0),
+   // so this loop always makes progress
+   while (bytesRead < sizeof(uint32_t))
+      bytesRead += readOnceBlocking(buffer + bytesRead, bufferCapacity - bytesRead);
 
-   // bytesRead should be greater than 0 here, readOnceBlocking() throws
-   // an exception already if (bytesRead <= 0).
-   if (bytesRead < sizeof(uint32_t))
+   // bytesRead >= sizeof(uint32_t)
+   uint32_t serializedSize = ((uint32_t *)buffer)[0];
+   if (serializedSize < Message::HEADER_SIZE)
       {
-      throw JITServer::StreamFailure("JITServer I/O error: fail to read the size of the message");
+      throw JITServer::StreamFailure("JITServer I/O error: invalid message size");
       }
 
-   // bytesRead >= sizeof(uint32_t)
-   uint32_t serializedSize = ((uint32_t *)buffer)[0];
    if (bytesRead > serializedSize)
       {
-      throw JITServer::StreamFailure("JITServer I/O error: read more than the message size");
+      // We read the beginning of the next message(s) as well
+      savePendingBytes(buffer + serializedSize, bytesRead - serializedSize);
+      bytesRead = serializedSize;
       }
 
    // serializedSize >= bytesRead
@@ -128,10 +419,19 @@ CommunicationStream::readMessage(Message &msg)
       readBlocking(buffer + bytesRead, bytesLeftToRead);
       }
 
+   uint32_t flags = reinterpret_cast<Message::MetaData *>(buffer + sizeof(uint32_t))->_flags;
+   // The other end is willing to exchange compressed messages
+   if (_useCompression && (flags & Message::MESSAGE_COMPRESSION_SUPPORTED))
+      _compressionEnabled = true;
+   if (flags & Message::MESSAGE_COMPRESSED)
+      serializedSize = decompressMessage(msg, serializedSize);
+
    msg.setSerializedSize(serializedSize);
 
    // rebuild the message
    msg.deserialize();
+   _readEndTimeNs = currentTimeNs();
+   messageStats[msg.type()].recordReceived(serializedSize);
 
 #ifdef MESSAGE_SIZE_STATS
    collectMsgStat[int(msg.type())].update(serializedSize);
@@ -141,9 +441,26 @@ CommunicationStream::readMessage(Message &msg)
 void
 CommunicationStream::writeMessage(Message &msg)
    {
+   _writeStartTimeNs = currentTimeNs();
+   msg.getMetaData()->_flags = (_useCompression ? Message::MESSAGE_COMPRESSION_SUPPORTED : 0) | _nextMessageFlags;
+   _nextMessageFlags = 0;
    char *serialMsg = msg.serialize();
+   messageStats[msg.type()].recordSent(msg.serializedSize());
    // write serialized message to the socket
-   writeBlocking(serialMsg, msg.serializedSize());
+   if (_compressionEnabled && (msg.serializedSize() >= _compressionThreshold))
+      {
+      writeCompressedMessage(msg);
+      }
+   else if (msg.hasExternalData())
+      {
+      msg.getIOVectors(_ioVectors);
+      writeBlocking(_ioVectors.data(), _ioVectors.size());
+      }
+   else
+      {
+      writeBlocking(serialMsg, msg.serializedSize());
+      }
    msg.clearForWrite();
+   _writeEndTimeNs = currentTimeNs();
    }
 }
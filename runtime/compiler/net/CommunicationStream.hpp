@@ -24,13 +24,19 @@
 #define COMMUNICATION_STREAM_H
 
 #include <unistd.h>
+#include <algorithm> // for std::min
+#include <limits.h> // for IOV_MAX
+#include <sys/uio.h> // for writev
+#include <sys/socket.h> // for recv
 #include <openssl/ssl.h>
 #include <openssl/err.h>
 #include "net/LoadSSLLibs.hpp"
 #include "net/Message.hpp"
 #include "infra/Statistics.hpp"
+#include "AtomicSupport.hpp"
 #include "env/VerboseLog.hpp"
 
+struct z_stream_s; // from zlib.h, which is only included in CommunicationStream.cpp
 
 namespace JITServer
 {
@@ -50,6 +56,57 @@ public:
    static TR_Stats collectMsgStat[JITServer::MessageType_ARRAYSIZE];
 #endif
 
+   /**
+      @class CompressionStats
+      @brief Per-MessageType statistics about compressed messages sent and received.
+
+      Counters are updated without synchronization by all streams in the process,
+      so they are approximate when several compilation threads are active.
+   */
+   struct CompressionStats
+      {
+      uint32_t _numCompressed; // Number of messages sent compressed
+      uint32_t _numDecompressed; // Number of compressed messages received
+      uint64_t _uncompressedBytes; // Size of the compressed messages sent, before compression
+      uint64_t _compressedBytes; // Size of the compressed messages sent, after compression
+      uint64_t _compressionTimeNs; // CPU time spent compressing
+      uint64_t _decompressionTimeNs; // CPU time spent decompressing
+      };
+   static CompressionStats compressionStats[JITServer::MessageType_ARRAYSIZE];
+
+   /**
+      @class MessageStats
+      @brief Per-MessageType volume and latency statistics, always collected.
+
+      The server times each query it sends, from the start of the write until the
+      answer is read; the part after the query was written is the time the compilation
+      thread is blocked waiting for the client. The client times how long it takes to
+      answer each query. Compilation threads update the counters with atomic adds.
+   */
+   struct MessageStats
+      {
+      // Bucket 0 counts latencies below LATENCY_BUCKET_BASE_US; bucket i counts latencies
+      // in [BASE * 2^(i-1), BASE * 2^i) and the last bucket is open-ended
+      static const int NUM_LATENCY_BUCKETS = 12;
+      static const uint64_t LATENCY_BUCKET_BASE_US = 16;
+      static uint64_t latencyBucketLimitUs(int bucket) { return LATENCY_BUCKET_BASE_US << bucket; }
+
+      void recordSent(uint32_t bytes);
+      void recordReceived(uint32_t bytes);
+      void recordLatency(uint64_t timeNs, uint64_t waitTimeNs);
+
+      uint32_t _numSent;
+      uint32_t _numReceived;
+      uint64_t _bytesSent; // Uncompressed size of the messages sent
+      uint64_t _bytesReceived; // Uncompressed size of the messages received
+      uint32_t _numTimed; // Server: round trips; client: queries answered
+      uint64_t _totalTimeNs; // Server: round-trip time; client: time spent answering
+      uint64_t _maxTimeNs;
+      uint64_t _waitTimeNs; // Server only: time spent waiting for the answer after the query was sent
+      uint32_t _latencyHistogram[NUM_LATENCY_BUCKETS];
+      };
+   static MessageStats messageStats[JITServer::MessageType_ARRAYSIZE];
+
    static void initConfigurationFlags();
 
    static uint32_t getJITServerVersion()
@@ -62,6 +119,18 @@ public:
       return Message::buildFullVersion(getJITServerVersion(), CONFIGURATION_FLAGS);
       }
 
+   /**
+      @brief Tells if bytes of the next message have already been received, but not consumed.
+
+      Such bytes can be held by the stream itself or by the SSL layer. Waiting for
+      the socket to become readable before reading the next message is only valid
+      when this function returns false.
+   */
+   bool hasBufferedInput() const
+      {
+      return (_numPendingBytes > 0) || (_ssl && ((*OBIO_ctrl)(_ssl, BIO_CTRL_PENDING, 0, NULL) > 0));
+      }
+
    static void printJITServerVersion()
       {
       // print the human-readable version string
@@ -71,7 +140,21 @@ public:
 protected:
    CommunicationStream() :
       _ssl(NULL),
-      _connfd(-1)
+      _connfd(-1),
+      _pendingBytes(NULL),
+      _numPendingBytes(0),
+      _pendingBytesCapacity(0),
+      _useCompression(false),
+      _compressionEnabled(false),
+      _compressionThreshold(0),
+      _deflateStream(NULL),
+      _inflateStream(NULL),
+      _compressionBuffer(NULL),
+      _compressionBufferCapacity(0),
+      _writeStartTimeNs(0),
+      _writeEndTimeNs(0),
+      _readEndTimeNs(0),
+      _nextMessageFlags(0)
       {
       static_assert(
          sizeof(messageNames) / sizeof(messageNames[0]) == MessageType_ARRAYSIZE,
@@ -85,6 +168,11 @@ protected:
 
       if (_ssl)
          (*OBIO_free_all)(_ssl);
+
+      if (_pendingBytes)
+         TR_Memory::jitPersistentFree(_pendingBytes);
+
+      freeCompressionResources();
       }
 
    void initStream(int connfd, BIO *ssl)
@@ -94,14 +182,51 @@ protected:
       }
 
    // Build a message sent by a remote party by reading from the socket
-   // as much as possible (up to internal buffer capacity)
+   // as much as possible (up to internal buffer capacity).
+   // Bytes read past the end of the message belong to the next message(s)
+   // and are kept aside to be consumed by the next readMessage() call.
    void readMessage(Message &msg);
    // Build a message sent by a remote party by first reading the message
    // size and then reading the rest of the message
    void readMessage2(Message &msg);
+   // Write a message to the socket. The message buffer and the payloads of
+   // data points added by reference are gathered with a single writev()
    void writeMessage(Message &msg);
 
    int getConnFD() const { return _connfd; }
+
+   /**
+      @brief Declare whether this end of the connection is willing to exchange compressed messages
+
+      Compression is enabled on a connection only after both ends have declared it:
+      every message carries MESSAGE_COMPRESSION_SUPPORTED when the sender is willing,
+      and a stream starts compressing its outgoing messages once it receives such a message.
+      Only messages of at least compressionThreshold bytes are compressed.
+      Both directions use a persistent deflate/inflate stream for the whole connection,
+      so that repeated content (class names, signatures) compresses well across messages.
+   */
+   void setCompressionPolicy(bool useCompression, uint32_t compressionThreshold)
+      {
+      _useCompression = useCompression;
+      _compressionThreshold = compressionThreshold;
+      }
+
+   bool isCompressionEnabled() const { return _compressionEnabled; }
+
+   /**
+      @brief Read the flags of the next incoming message without consuming it
+
+      Only possible when the header of the message was already received and is not encrypted.
+      Never blocks.
+      @return true if the flags could be read
+   */
+   bool peekMessageFlags(uint32_t &flags);
+
+   // Server: account for the answer to the last query, which was just read.
+   // Returns the round-trip time
+   uint64_t recordRoundTrip(MessageType type);
+   // Client: account for the answer to the last query, which was just written
+   void recordQueryServiceTime(MessageType type);
    
    BIO *_ssl; // SSL connection, null if not using SSL
    int _connfd;
@@ -109,11 +234,42 @@ protected:
    ClientMessage _cMsg;
 
    static const uint8_t MAJOR_NUMBER = 1;
-   static const uint16_t MINOR_NUMBER = 17;
+   static const uint16_t MINOR_NUMBER = 25;
    static const uint8_t PATCH_NUMBER = 0;
    static uint32_t CONFIGURATION_FLAGS;
 
 private:
+   // Keep aside bytes that were read from the socket, but belong to the next message
+   void savePendingBytes(const char *data, uint32_t size);
+
+   // Deflate the body of a serialized message and write it to the socket
+   void writeCompressedMessage(Message &msg);
+   // Replace the deflated body of a message that was just read with its inflated version
+   uint32_t decompressMessage(Message &msg, uint32_t serializedSize);
+   void ensureCompressionBufferCapacity(uint32_t requiredSize);
+   void freeCompressionResources();
+
+   bool _useCompression; // This end of the connection is willing to exchange compressed messages
+   bool _compressionEnabled; // Both ends are willing to exchange compressed messages
+   uint32_t _compressionThreshold; // Minimum size of a message to be compressed
+   z_stream_s *_deflateStream; // Persistent compression state for outgoing messages
+   z_stream_s *_inflateStream; // Persistent decompression state for incoming messages
+   char *_compressionBuffer; // Holds compressed messages before sending or after receiving them
+   uint32_t _compressionBufferCapacity;
+
+   char *_pendingBytes; // Bytes read past the end of the last message received
+   uint32_t _numPendingBytes;
+   uint32_t _pendingBytesCapacity;
+   std::vector<struct iovec> _ioVectors; // Reused by writeMessage to avoid reallocations
+
+   // Timestamps of the last message written and read, used for latency statistics
+   uint64_t _writeStartTimeNs;
+   uint64_t _writeEndTimeNs;
+   uint64_t _readEndTimeNs;
+
+protected:
+   uint32_t _nextMessageFlags; // Additional MessageFlags for the next message written
+
    // readBlocking and writeBlocking are functions that directly read/write
    // passed object from/to the socket. For the object to be correctly written,
    // it needs to be contiguous.
@@ -216,6 +372,42 @@ private:
             }
          }
       }
+
+   // Write all the memory blocks described by iov, in order.
+   // Without SSL, the blocks are gathered with writev() so that a message
+   // composed of several blocks is sent with as few system calls as possible.
+   void writeBlocking(struct iovec *iov, int iovcnt)
+      {
+      if (_ssl)
+         {
+         for (int i = 0; i < iovcnt; ++i)
+            writeBlocking(static_cast<const char *>(iov[i].iov_base), iov[i].iov_len);
+         }
+      else
+         {
+         while (iovcnt > 0)
+            {
+            ssize_t result = writev(_connfd, iov, std::min(iovcnt, IOV_MAX));
+            if (result <= 0)
+               {
+               throw JITServer::StreamFailure("JITServer I/O error: write error");
+               }
+            size_t bytesWritten = result;
+            // Skip the blocks that were written completely and adjust a partially written one
+            while (iovcnt > 0 && bytesWritten >= iov->iov_len)
+               {
+               bytesWritten -= iov->iov_len;
+               iov++;
+               iovcnt--;
+               }
+            if (bytesWritten > 0)
+               {
+               iov->iov_base = static_cast<char *>(iov->iov_base) + bytesWritten;
+               iov->iov_len -= bytesWritten;
+               }
+            }
+         }
+      }
    }; // class CommunicationStream
 }; // namespace JITServer
 
@@ -96,6 +96,9 @@ OX509_free_t * OX509_free = NULL;
 
 OERR_print_errors_fp_t * OERR_print_errors_fp = NULL;
 
+OEVP_sha256_t * OEVP_sha256 = NULL;
+OEVP_Digest_t * OEVP_Digest = NULL;
+
 int OSSL102_OOPENSSL_init_ssl(uint64_t opts, const void * settings)
    {
    // Does not exist in 1.0.2. Should not be called directly outside this file
@@ -336,6 +339,9 @@ void dbgPrintSymbols()
 
    printf(" ERR_print_errors_fp %p\n", OERR_print_errors_fp);
 
+   printf(" EVP_sha256 %p\n", OEVP_sha256);
+   printf(" EVP_Digest %p\n", OEVP_Digest);
+
    printf("=============================================================\n\n");
    }
 #endif /* defined(DEBUG) */
@@ -450,6 +456,10 @@ bool loadLibsslAndFindSymbols()
 
    OERR_print_errors_fp = (OERR_print_errors_fp_t *)findLibsslSymbol(handle, "ERR_print_errors_fp");
 
+   // Optional; only used to compute content digests
+   OEVP_sha256 = (OEVP_sha256_t *)findLibsslSymbol(handle, "EVP_sha256");
+   OEVP_Digest = (OEVP_Digest_t *)findLibsslSymbol(handle, "EVP_Digest");
+
    if (
        (OOpenSSL_version == NULL) ||
 
@@ -525,4 +535,25 @@ bool loadLibsslAndFindSymbols()
    return true;
 }
 
+bool loadLibsslDigestSymbols()
+   {
+   if (OEVP_sha256 && OEVP_Digest)
+      return true;
+
+   void *handle = loadLibssl();
+   if (!handle)
+      return false;
+
+   OEVP_sha256 = (OEVP_sha256_t *)findLibsslSymbol(handle, "EVP_sha256");
+   OEVP_Digest = (OEVP_Digest_t *)findLibsslSymbol(handle, "EVP_Digest");
+   if (!OEVP_sha256 || !OEVP_Digest)
+      {
+      OEVP_sha256 = NULL;
+      OEVP_Digest = NULL;
+      unloadLibssl(handle);
+      return false;
+      }
+   return true;
+   }
+
 }; // JITServer
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <openssl/ssl.h>
+#include <openssl/evp.h>
 
 typedef const char * OOpenSSL_version_t(int);
 
@@ -90,6 +91,9 @@ typedef void OX509_free_t(X509 *a);
 
 typedef void OERR_print_errors_fp_t(FILE *fp);
 
+typedef const EVP_MD * OEVP_sha256_t(void);
+typedef int OEVP_Digest_t(const void *data, size_t count, unsigned char *md, unsigned int *size, const EVP_MD *type, ENGINE *impl);
+
 extern "C" OOpenSSL_version_t * OOpenSSL_version;
 
 extern "C" OSSL_load_error_strings_t * OSSL_load_error_strings;
@@ -152,6 +156,9 @@ extern "C" OEVP_cleanup_t * OEVP_cleanup;
 
 extern "C" OERR_print_errors_fp_t * OERR_print_errors_fp;
 
+extern "C" OEVP_sha256_t * OEVP_sha256;
+extern "C" OEVP_Digest_t * OEVP_Digest;
+
 namespace JITServer
 {
 void * loadLibssl();
@@ -159,5 +166,7 @@ void   unloadLibssl(void * handle);
 void * findLibsslSymbol(void * handle, const char * symName);
 
 bool loadLibsslAndFindSymbols();
+// Only finds the message digest functions; does not print anything on failure
+bool loadLibsslDigestSymbols();
 };
 #endif // LOAD_SSL_LIBS_H
@@ -67,6 +67,42 @@ Message::addData(const DataDescriptor &desc, const void *dataStart, bool needs64
    return desc.getTotalSize() + initialPadding;
    }
 
+uint32_t
+Message::addDataByReference(const DataDescriptor &desc, const void *dataStart)
+   {
+   uint32_t descOffset = _buffer.writeValue(desc);
+
+   // The payload itself is not copied; remember where it must be inserted
+   // and reserve only the padding that follows it
+   uint32_t payloadSize = desc.getPayloadSize();
+   if (payloadSize > 0)
+      {
+      _externalSegments.push_back({ _buffer.size(), payloadSize, static_cast<const char *>(dataStart) });
+      _externalDataSize += payloadSize;
+      }
+   _buffer.reserveData(desc.getPaddingSize());
+   _descriptorOffsets.push_back(descOffset);
+   return desc.getTotalSize();
+   }
+
+void
+Message::getIOVectors(std::vector<struct iovec> &ioVectors)
+   {
+   ioVectors.clear();
+   ioVectors.reserve(2 * _externalSegments.size() + 1);
+   char *bufferStart = _buffer.getBufferStart();
+   uint32_t crtOffset = 0;
+   for (auto it = _externalSegments.begin(); it != _externalSegments.end(); ++it)
+      {
+      if (it->_bufferOffset > crtOffset)
+         ioVectors.push_back({ bufferStart + crtOffset, it->_bufferOffset - crtOffset });
+      ioVectors.push_back({ const_cast<char *>(it->_data), it->_size });
+      crtOffset = it->_bufferOffset;
+      }
+   if (_buffer.size() > crtOffset)
+      ioVectors.push_back({ bufferStart + crtOffset, _buffer.size() - crtOffset });
+   }
+
 void
 Message::deserialize()
    {
@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <stdlib.h>
+#include <sys/uio.h> // for struct iovec
 #include "net/MessageBuffer.hpp"
 #include "net/MessageTypes.hpp"
 #include "OMR/Bytes.hpp" // for alignNoCheck
@@ -46,6 +47,17 @@ namespace JITServer
 class Message
    {
 public:
+   /**
+      @brief Flags describing how a message was encoded by the sender.
+   */
+   enum MessageFlags : uint32_t
+      {
+      MESSAGE_COMPRESSED             = 0x00000001, // Everything after the MetaData is deflated
+      MESSAGE_COMPRESSION_SUPPORTED  = 0x00000002, // Sender is willing to exchange compressed messages
+      MESSAGE_PRIORITY_MASK          = 0xFFFF0000, // Compilation requests: CompilationPriority of the request at the client
+      };
+   static const uint32_t MESSAGE_PRIORITY_SHIFT = 16;
+
    /**
       @class MetaData
       @brief Describes general parameters of a message: number of datapoints, message type, and version.
@@ -56,12 +68,13 @@ public:
    struct MetaData
       {
       MetaData() :
-         _version(0), _config(0), _type(MessageType_MAXTYPE), _numDataPoints(0)
+         _version(0), _config(0), _type(MessageType_MAXTYPE), _numDataPoints(0), _flags(0)
          {}
       uint32_t _version;
       uint32_t _config; // includes JITServerCompatibilityFlags which must match
       MessageType _type;
       uint16_t _numDataPoints;
+      uint32_t _flags; // MessageFlags; the MetaData itself is never compressed
 
       void init()
          {
@@ -69,9 +82,15 @@ public:
          _config = 0;
          _type = MessageType_MAXTYPE;
          _numDataPoints = 0;
+         _flags = 0;
          }
       };
 
+   /**
+      @brief Size of the part of a serialized message that is never compressed: message size and MetaData
+   */
+   static const uint32_t HEADER_SIZE = sizeof(uint32_t) + sizeof(MetaData);
+
    /**
    @brief Utility function that builds the "full version" of client/server as 
    a composition of the version number and compatibility flags.
@@ -209,7 +228,7 @@ public:
       uint32_t _size; // Size of the data segment, which can include nested data
       }; // struct DataDescriptor
 
-   Message()
+   Message() : _externalDataSize(0)
       {
       // Reserve space for encoding the size and MetaData.
       // These will be populated at a later time
@@ -239,6 +258,25 @@ public:
    */
    uint32_t addData(const DataDescriptor &desc, const void *dataStart, bool needs64BitAlignment = false);
 
+   /**
+      @brief Add a new data point to the message without copying its payload.
+
+      Only the descriptor and the trailing padding are written to the MessageBuffer.
+      The payload is recorded as an external segment that is spliced into the
+      outgoing byte stream when the message is written to the socket, so the
+      bytes seen by the receiver are identical to those produced by addData().
+      The memory at dataStart must stay valid until the message has been written.
+
+      Note: the sending side cannot inspect the payload of such a data point
+      through the MessageBuffer (e.g. with print()).
+
+      @param desc Descriptor for the new data
+      @param dataStart Pointer to the new data
+
+      @return The total amount of data written (including padding, but not including the descriptor)
+   */
+   uint32_t addDataByReference(const DataDescriptor &desc, const void *dataStart);
+
    /**
       @brief Allocate space for a descriptor in the MessageBuffer
       and update the message structure without writing any actual data.
@@ -303,14 +341,31 @@ public:
    */
    char *serialize()
       {
-      *_buffer.getValueAtOffset<uint32_t>(0) = _buffer.size();
+      *_buffer.getValueAtOffset<uint32_t>(0) = serializedSize();
       return _buffer.getBufferStart();
       }
 
    /**
       @brief Return the size of the serialized message.
+
+      This includes the payloads of data points added by reference.
+   */
+   uint32_t serializedSize() { return _buffer.size() + _externalDataSize; }
+
+   /**
+      @brief Describe the serialized message as a list of contiguous memory blocks.
+
+      The message must have been serialized first. Parts of the MessageBuffer are
+      interleaved with the payloads of data points added by reference, in wire order.
+
+      @param ioVectors vector to be populated with the memory blocks; its previous content is discarded
    */
-   uint32_t serializedSize() { return _buffer.size(); }
+   void getIOVectors(std::vector<struct iovec> &ioVectors);
+
+   /**
+      @brief Tells if any data point of this message was added by reference.
+   */
+   bool hasExternalData() const { return !_externalSegments.empty(); }
 
    /**
       @brief Rebuild the message from the MessageBuffer
@@ -363,12 +418,16 @@ public:
    void clearForRead()
       {
       _descriptorOffsets.clear();
+      _externalSegments.clear();
+      _externalDataSize = 0;
       _buffer.clear();
       }
 
    void clearForWrite()
       {
       _descriptorOffsets.clear();
+      _externalSegments.clear();
+      _externalDataSize = 0;
       _buffer.clear();
       _buffer.reserveValue<uint32_t>(); // For writing the size
       _buffer.reserveValue<MetaData>(); // For writing the metadata
@@ -376,7 +435,21 @@ public:
 
    void print();
 protected:
+   /**
+      @class ExternalSegment
+      @brief Payload of a data point added by reference, which must be
+      inserted in the outgoing byte stream at a given offset of the MessageBuffer
+   */
+   struct ExternalSegment
+      {
+      uint32_t _bufferOffset; // Offset in the MessageBuffer where the payload belongs
+      uint32_t _size;
+      const char *_data;
+      };
+
    std::vector<uint32_t> _descriptorOffsets;
+   std::vector<ExternalSegment> _externalSegments;
+   uint32_t _externalDataSize; // Total size of all external segments
    MessageBuffer _buffer; // Buffer used for send/receive operations
    };
 
@@ -118,6 +118,21 @@ public:
    */
    uint32_t writeData(const void *dataStart, uint32_t dataSize, uint8_t paddingSize);
 
+   /**
+      @brief Reserve a given number of bytes in the buffer without writing them.
+
+      Advances _curPtr by dataSize bytes, expanding the buffer if needed.
+
+      @return offset to the beginning of the reserved memory block
+   */
+   uint32_t reserveData(uint32_t dataSize)
+      {
+      expandIfNeeded(size() + dataSize);
+      char *dataStart = _curPtr;
+      _curPtr += dataSize;
+      return offset(dataStart);
+      }
+
    /**
       @brief Reserve memory for a value of type T.
 
@@ -67,6 +67,7 @@ enum MessageType : uint16_t
    ResolvedMethod_getRemoteROMString,
    ResolvedMethod_fieldOrStaticName,
    ResolvedMethod_getRemoteROMClassAndMethods,
+   ResolvedMethod_getRemoteROMClass,
    ResolvedMethod_getResolvedHandleMethod,
    ResolvedMethod_isUnresolvedMethodTypeTableEntry,
    ResolvedMethod_methodTypeTableEntryAddress,
@@ -344,6 +345,7 @@ static const char *messageNames[MessageType_ARRAYSIZE] =
    "ResolvedMethod_getRemoteROMString",
    "ResolvedMethod_fieldOrStaticName",
    "ResolvedMethod_getRemoteROMClassAndMethods",
+   "ResolvedMethod_getRemoteROMClass",
    "ResolvedMethod_getResolvedHandleMethod",
    "ResolvedMethod_isUnresolvedMethodTypeTableEntry",
    "ResolvedMethod_methodTypeTableEntryAddress",
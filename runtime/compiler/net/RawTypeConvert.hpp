@@ -131,6 +131,27 @@ template <> struct RawTypeConvert<const std::string>
 
 template <> struct RawTypeConvert<std::string> : RawTypeConvert<const std::string> {};
 
+// Reference to a contiguous block of memory sent as a STRING data point.
+// The payload is not copied into the message buffer; instead it is gathered
+// directly from its source memory when the message is written to the socket,
+// so the memory must stay valid until the message has been sent.
+// The receiving side reads such a data point as a regular std::string.
+struct StringRef
+   {
+   StringRef(const char *data, uint32_t size) : _data(data), _size(size) {}
+   StringRef(const std::string &str) : _data(str.data()), _size(str.size()) {}
+   const char *_data;
+   uint32_t _size;
+   };
+
+template <> struct RawTypeConvert<StringRef>
+   {
+   static inline uint32_t onSend(Message &msg, const StringRef &value)
+      {
+      return msg.addDataByReference(Message::DataDescriptor(Message::DataDescriptor::DataType::STRING, value._size), value._data);
+      }
+   };
+
 // For trivially copyable classes
 template <typename T> struct RawTypeConvert<T, typename std::enable_if<std::is_trivially_copyable<T>::value>::type>
    {
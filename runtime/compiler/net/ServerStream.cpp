@@ -21,17 +21,45 @@
  *******************************************************************************/
 
 #include "ServerStream.hpp"
+#include "control/CompilationRuntime.hpp"
 
 namespace JITServer
 {
 int ServerStream::_numConnectionsOpened = 0;
 int ServerStream::_numConnectionsClosed = 0;
+ServerStream::CompilationRoundTripStats ServerStream::compilationRoundTripStats = {};
 
 ServerStream::ServerStream(int connfd, BIO *ssl)
    : CommunicationStream()
    {
    initStream(connfd, ssl);
+   TR::PersistentInfo *info = TR::CompilationInfo::get()->getPersistentInfo();
+   setCompressionPolicy(info->getJITServerUseCompression(), info->getJITServerCompressionThreshold());
    _numConnectionsOpened++;
    _pClientSessionData = NULL;
+   _clientId = 0;
+   _numRoundTrips = 0;
+   _roundTripTimeNs = 0;
+   }
+
+void
+ServerStream::recordCompilationRoundTrips()
+   {
+   CompilationRoundTripStats &stats = compilationRoundTripStats;
+   VM_AtomicSupport::addU32(&stats._numCompilations, 1);
+   VM_AtomicSupport::addU64(&stats._numRoundTrips, _numRoundTrips);
+   VM_AtomicSupport::addU64(&stats._roundTripTimeNs, _roundTripTimeNs);
+   uint32_t maxRoundTrips = stats._maxRoundTrips;
+   while (_numRoundTrips > maxRoundTrips)
+      {
+      uint32_t oldMaxRoundTrips = VM_AtomicSupport::lockCompareExchangeU32(&stats._maxRoundTrips, maxRoundTrips, _numRoundTrips);
+      if (oldMaxRoundTrips == maxRoundTrips)
+         break;
+      maxRoundTrips = oldMaxRoundTrips;
+      }
+   int bucket = 0;
+   while ((bucket < CompilationRoundTripStats::NUM_BUCKETS - 1) && (_numRoundTrips >= (1u << bucket)))
+      bucket++;
+   VM_AtomicSupport::addU32(&stats._histogram[bucket], 1);
    }
 }
@@ -137,6 +137,8 @@ public:
                throw StreamMessageTypeMismatch(_sMsg.type(), _cMsg.type());
             }
          }
+      _roundTripTimeNs += recordRoundTrip(_cMsg.type());
+      _numRoundTrips++;
       return getArgsRaw<T...>(_cMsg);
       }
 
@@ -176,6 +178,8 @@ public:
             }
          case MessageType::compilationRequest:
             {
+            _numRoundTrips = 0;
+            _roundTripTimeNs = 0;
             return getArgsRaw<T...>(_cMsg);
             }
          default:
@@ -203,6 +207,7 @@ public:
    template <typename... T>
    void finishCompilation(T... args)
       {
+      recordCompilationRoundTrips();
       try
          {
          write(MessageType::compilationCode, args...);
@@ -219,6 +224,7 @@ public:
    */
    void writeError(uint32_t statusCode)
       {
+      recordCompilationRoundTrips();
       try
          {
          if (TR::Options::getVerboseOption(TR_VerboseJITServer))
@@ -257,15 +263,61 @@ public:
       return (_pClientSessionData) ? _pClientSessionData->isClassUnloadingAttempted() : false;
       }
 
+   using CommunicationStream::getConnFD;
+
    // Statistics
    static int getNumConnectionsOpened() { return _numConnectionsOpened; }
    static int getNumConnectionsClosed() { return _numConnectionsClosed; }
 
+   // Returned by peekCompilationRequestPriority() when the priority cannot be determined
+   static const int32_t UNKNOWN_PRIORITY = -1;
+
+   /**
+      @brief Priority the client assigned to the next compilation request on this stream
+
+      @return The CompilationPriority sent by the client, or UNKNOWN_PRIORITY if it cannot be
+              determined without reading the request (e.g. the request did not arrive yet or SSL is used)
+   */
+   int32_t peekCompilationRequestPriority()
+      {
+      uint32_t flags = 0;
+      if (!peekMessageFlags(flags))
+         return UNKNOWN_PRIORITY;
+      return (int32_t)((flags & Message::MESSAGE_PRIORITY_MASK) >> Message::MESSAGE_PRIORITY_SHIFT);
+      }
+
+   // Queries sent to the client by the compilation in progress on this stream
+   uint32_t getNumRoundTrips() const { return _numRoundTrips; }
+   uint64_t getRoundTripTimeNs() const { return _roundTripTimeNs; }
+
+   /**
+      @class CompilationRoundTripStats
+      @brief Distribution of the number of queries sent to the client per compilation.
+      Updated with atomic adds, like CommunicationStream::MessageStats.
+   */
+   struct CompilationRoundTripStats
+      {
+      // Bucket 0 counts compilations without round trips; bucket i counts
+      // [2^(i-1), 2^i) round trips and the last bucket is open-ended
+      static const int NUM_BUCKETS = 12;
+
+      uint32_t _numCompilations;
+      uint64_t _numRoundTrips;
+      uint64_t _roundTripTimeNs;
+      uint32_t _maxRoundTrips;
+      uint32_t _histogram[NUM_BUCKETS];
+      };
+   static CompilationRoundTripStats compilationRoundTripStats;
+
 private:
+   void recordCompilationRoundTrips();
+
    static int _numConnectionsOpened;
    static int _numConnectionsClosed;
    uint64_t _clientId;  // UID of client connected to this communication stream
    ClientSessionData *_pClientSessionData;
+   uint32_t _numRoundTrips; // since the last compilation request was read
+   uint64_t _roundTripTimeNs;
    };
 
 
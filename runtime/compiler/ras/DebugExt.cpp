@@ -2510,7 +2510,6 @@ TR_DebugExt::dxPrintJ9MonitorTable(TR::MonitorTable *remoteMonTable)
    _dbgPrintf("\tTR::Monitor * _j9ScratchMemoryPoolMonitor = 0x%p\n", &(remoteMonTable->_j9ScratchMemoryPoolMonitor));
    _dbgPrintf("\tTR::Monitor * _classUnloadMonitor = 0x%p\n", &(remoteMonTable->_classUnloadMonitor));
    _dbgPrintf("\tTR::Monitor * _classTableMutex = 0x%p\n", &(remoteMonTable->_classTableMutex));
-   _dbgPrintf("\tTR::Monitor * _iprofilerPersistenceMonitor = 0x%p\n", &(remoteMonTable->_iprofilerPersistenceMonitor));
    _dbgPrintf("\tHolders of classUnloadMonitor at address 0x%p\n", remoteMonTable->_classUnloadMonitorHolders);
 
    dxFree(localMonTable);
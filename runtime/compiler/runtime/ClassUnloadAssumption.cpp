@@ -39,6 +39,7 @@
 #include "runtime/JITClientSession.hpp"
 #endif
 #include "omrformatconsts.h"
+#include "AtomicSupport.hpp"
 
 extern TR::Monitor *assumptionTableMutex;
 
@@ -189,6 +190,8 @@ TR_PersistentClassInfo::removeUnloadedSubClasses()
        memset(_tables[i]._markedforDetachCount, 0, sizeof(uint32_t)*_tables[i]._spineArraySize);
        }
     _marked=0;
+    _numReaders=0;
+    _unlinkedAssumptions=NULL;
     memset(_detachPending, 0, sizeof(bool)*LastAssumptionKind);
     return true;
     }
@@ -325,10 +328,14 @@ void TR_RuntimeAssumptionTable::purgeAssumptionListHead(OMR::RuntimeAssumption *
    OMR::RuntimeAssumption *next = assumptionList->getNextEvenIfDead();
    printf("Freeing Assumption 0x%" OMR_PRIxPTR " and next assumption is 0x%" OMR_PRIxPTR "\n", (uintptr_t)assumptionList, (uintptr_t)next);
 
-   assumptionList->dequeueFromListOfAssumptionsForJittedBody();
+   if (assumptionList->getNextAssumptionForSameJittedBodyEvenIfDead())
+      assumptionList->dequeueFromListOfAssumptionsForJittedBody();
    incReclaimedAssumptionCount(assumptionList->getAssumptionKind());
 
-   TR_PersistentMemory::jitPersistentFree(assumptionList);
+   // As in reclaimMarkedAssumptionsFromRAT(), a reader may still be walking
+   // this bucket, so the assumption is only freed once there are no readers
+   assumptionList->setNextAssumptionForSameJittedBody(_unlinkedAssumptions);
+   _unlinkedAssumptions = assumptionList;
 
    assumptionList = next;
 
@@ -352,6 +359,7 @@ void TR_RuntimeAssumptionTable::purgeRATTable(TR_FrontEnd *fe)
          continue; // For some reason we don't want to purge this type of assumption
       purgeRATArray(fe, _tables[i]._htSpineArray, _tables[i]._spineArraySize);
       }
+   freeUnlinkedAssumptions();
    }
 
 
@@ -368,6 +376,8 @@ void TR_RuntimeAssumptionTable::addAssumption(OMR::RuntimeAssumption *a, TR_Runt
    OMR::RuntimeAssumption **headPtr = getBucketPtr(kind, a->hashCode());
    if (*headPtr)
       a->setNext(*headPtr);
+   // Readers walk the buckets without the mutex; they must see a fully built assumption
+   VM_AtomicSupport::writeBarrier();
    *headPtr = a;
 
    if (TR::Options::getCmdLineOptions()->getOption(TR_EnableRATPurging))
@@ -405,7 +415,7 @@ void TR_RuntimeAssumptionTable::markForDetachFromRAT(OMR::RuntimeAssumption *ass
  */
 void TR_RuntimeAssumptionTable::reclaimMarkedAssumptionsFromRAT(int32_t cleanupCount)
    {
-   if (_marked == 0)
+   if (_marked == 0 && !_unlinkedAssumptions)
       return;
 
    assumptionTableMutex->enter();
@@ -437,13 +447,14 @@ void TR_RuntimeAssumptionTable::reclaimMarkedAssumptionsFromRAT(int32_t cleanupC
                   if (cursor->getNextAssumptionForSameJittedBodyEvenIfDead())
                      cursor->dequeueFromListOfAssumptionsForJittedBody();
 
-                  // Now release the assumption
+                  // Now release the assumption. A reader may still be looking at it,
+                  // so its next pointer is left alone and freeing it is deferred; the
+                  // jitted body link is free at this point and chains the unlinked list
                   hashTable->_markedforDetachCount[i]--;
                   _marked--;
                   incReclaimedAssumptionCount(kind);
-                  cursor->reclaim();
-                  cursor->paint(); // RAS
-                  TR_PersistentMemory::jitPersistentFree(cursor);
+                  cursor->setNextAssumptionForSameJittedBody(_unlinkedAssumptions);
+                  _unlinkedAssumptions = cursor;
                   cleanupCount--;
                   }
                else
@@ -458,9 +469,47 @@ void TR_RuntimeAssumptionTable::reclaimMarkedAssumptionsFromRAT(int32_t cleanupC
             _detachPending[kind] = false;
          }
       }
+   freeUnlinkedAssumptions();
    assumptionTableMutex->exit();
    }
 
+/**
+ * Free the assumptions unlinked from the RAT unless a reader may still be
+ * walking them; they are then freed by a later reclaimMarkedAssumptionsFromRAT().
+ * Must be executed under assumptionTableMutex.
+ */
+void TR_RuntimeAssumptionTable::freeUnlinkedAssumptions()
+   {
+   // Pairs with the barrier in Reader::Reader(): either the reader sees the
+   // unlinked buckets, or we see the reader and keep the assumptions
+   VM_AtomicSupport::readWriteBarrier();
+   if (_numReaders != 0)
+      return;
+
+   OMR::RuntimeAssumption *cursor = _unlinkedAssumptions;
+   _unlinkedAssumptions = NULL;
+   while (cursor)
+      {
+      OMR::RuntimeAssumption *next = cursor->getNextAssumptionForSameJittedBodyEvenIfDead();
+      cursor->setNextAssumptionForSameJittedBody(NULL);
+      cursor->reclaim();
+      cursor->paint(); // RAS
+      TR_PersistentMemory::jitPersistentFree(cursor);
+      cursor = next;
+      }
+   }
+
+TR_RuntimeAssumptionTable::Reader::Reader(TR_RuntimeAssumptionTable *table) : _table(table)
+   {
+   VM_AtomicSupport::addU32(&_table->_numReaders, 1);
+   VM_AtomicSupport::readWriteBarrier();
+   }
+
+TR_RuntimeAssumptionTable::Reader::~Reader()
+   {
+   VM_AtomicSupport::subtractU32(&_table->_numReaders, 1);
+   }
+
 /**
  * Mark and detach all of the assumptions in the metadata's circular linked list
  * @param md The metadata for which to mark & detach assumptions from.
@@ -623,12 +623,7 @@ TR_HWProfiler::recompilationLogic(TR_PersistentJittedBodyInfo *bodyInfo,
          // Check again in case another thread has already upgraded this request
          if (bodyInfo->_hwpReducedWarmCompileInQueue)
             {
-            for (cur = _compInfo->getMethodQueue(); cur; cur = cur->_next)
-               {
-               if (cur->getMethodDetails().sameAs(details, fe))
-                  break;
-               }
-
+            cur = _compInfo->findQueuedEntry(details, fe);
             if (cur)
                {
                cur->_optimizationPlan->setIsHwpDoReducedWarm(false);
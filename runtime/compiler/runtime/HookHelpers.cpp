@@ -92,12 +92,16 @@ namespace  {
          }
       }
 
-   // mark the code cache as not full
+   // mark the code cache as not full, unless the reclaimed space is scattered
+   // in blocks too small for a method body; clearing the flag then would only
+   // let compilations fail again on the next code cache allocation
    inline void renewCodeCachePessimism(J9VMThread *vmThread)
       {
       if (
-         !TR::Options::getCmdLineOptions()->getOption(TR_DisableCodeCacheReclamation)
+         (vmThread->javaVM->jitConfig->runtimeFlags & J9JIT_CODE_CACHE_FULL)
+         && !TR::Options::getCmdLineOptions()->getOption(TR_DisableCodeCacheReclamation)
          && !TR::Options::getCmdLineOptions()->getOption(TR_DisableClearCodeCacheFullFlag)
+         && TR::CodeCacheManager::instance()->canAllocateCodeBlock(TR::Options::_minFreeCodeCacheBlockToResumeCompilations)
          )
          {
          // Clear the flag to allow compilation to continue
@@ -31,6 +31,7 @@
 #include <algorithm>
 #include <stdlib.h>
 #include <string.h>
+#include "AtomicSupport.hpp"
 #include "bcnames.h"
 #include "jilconsts.h"
 #include "j9cp.h"
@@ -70,6 +71,7 @@
 #include "ilgen/J9ByteCode.hpp"
 #include "ilgen/J9ByteCodeIterator.hpp"
 #include "runtime/IProfiler.hpp"
+#include "runtime/IProfilerSnapshot.hpp"
 #include "runtime/J9Profiler.hpp"
 #include "omrformatconsts.h"
 
@@ -570,13 +572,17 @@ TR_IProfiler::allocate(J9JITConfig *jitConfig)
 TR_IProfiler::TR_IProfiler(J9JITConfig *jitConfig)
    : _isIProfilingEnabled(true),
      _valueProfileMethod(NULL), _lightHashTableMonitor(0), _allowedToGiveInlinedInformation(true),
-     _globalAllocationCount (0), _maxCallFrequency(0), _iprofilerThread(0), _iprofilerOSThread(NULL),
+     _globalAllocationCount (0), _maxCallFrequency(0), _numParserThreads(0), _numParserThreadsRunning(0),
      _workingBufferTail(NULL), _numOutstandingBuffers(0), _numRequests(1), _numRequestsSkipped(0),
      _numRequestsHandedToIProfilerThread(0), _iprofilerThreadExitFlag(0), _iprofilerMonitor(NULL),
-     _crtProfilingBuffer(NULL), _iprofilerThreadAttachAttempted(false), _iprofilerNumRecords(0)
+     _iprofilerNumRecords(0), _numBuffersParsed(0), _numBuffersDropped(0),
+     _numEntriesAbandoned(0), _bytesAbandoned(0),
+     _totalQueueTime(0), _maxQueueTime(0), _totalParseTime(0), _snapshot(NULL), _writingSnapshot(0)
    {
    PORT_ACCESS_FROM_JITCONFIG(jitConfig);
 
+   memset(_parserThreads, 0, sizeof(_parserThreads));
+
    _iprofilerBufferSize = (uint32_t)jitConfig->iprofilerBufferSize; //J9_PROFILING_BUFFER_SIZE;
    _portLib = jitConfig->javaVM->portLibrary;
    _vm = TR_J9VMBase::get(jitConfig, 0);
@@ -611,6 +617,16 @@ TR_IProfiler::TR_IProfiler(J9JITConfig *jitConfig)
       {
       _isIProfilingEnabled = false;
       }
+
+   // Profiling data saved by a previous run is loaded lazily, one method at a time
+   const char *snapshotFileName = ((TR_JitPrivateConfig *)jitConfig->privateConfig)->iprofilerSnapshotFileName;
+   bool useSnapshot = _isIProfilingEnabled && snapshotFileName;
+#if defined(J9VM_OPT_JITSERVER)
+   if (_compInfo->getPersistentInfo()->getRemoteCompilationMode() == JITServer::SERVER)
+      useSnapshot = false;
+#endif /* defined(J9VM_OPT_JITSERVER) */
+   if (useSnapshot)
+      _snapshot = TR_IProfilerSnapshot::load(_portLib, snapshotFileName);
    }
 
 
@@ -1065,24 +1081,54 @@ TR_IProfiler::findOrCreateEntry(int32_t bucket, uintptr_t pc, bool addIt)
 
    // Create a new hash table entry
    U_8 byteCode = *(U_8*) pc;
+   size_t entrySize = 0;
    if (isCompact(byteCode))
+      {
       entry = new TR_IPBCDataFourBytes(pc);
+      entrySize = sizeof(TR_IPBCDataFourBytes);
+      }
    else
       {
       if (isSwitch(byteCode))
+         {
          entry = new TR_IPBCDataEightWords(pc);
+         entrySize = sizeof(TR_IPBCDataEightWords);
+         }
       else
+         {
          entry = new TR_IPBCDataCallGraph(pc);
+         entrySize = sizeof(TR_IPBCDataCallGraph);
+         }
       }
 
    if (!entry)
       return NULL;
 
-   entry->setNext(_bcHashTable[bucket]);
-   FLUSH_MEMORY(TR::Compiler->target.isSMP());
-   _bcHashTable[bucket] = entry;
-
-   return entry;
+   // Buffers are parsed concurrently by several threads, so link the new entry
+   // at the head of the bucket with a CAS. If the head changed, another thread
+   // may have created an entry for the same pc; use that one instead.
+   TR_IPBytecodeHashTableEntry *head = _bcHashTable[bucket];
+   while (true)
+      {
+      entry->setNext(head);
+      FLUSH_MEMORY(TR::Compiler->target.isSMP());
+      TR_IPBytecodeHashTableEntry *oldHead = (TR_IPBytecodeHashTableEntry *)VM_AtomicSupport::lockCompareExchange(
+         (uintptr_t *)&_bcHashTable[bucket], (uintptr_t)head, (uintptr_t)entry);
+      if (oldHead == head)
+         return entry;
+      for (TR_IPBytecodeHashTableEntry *e = oldHead; e != head; e = e->getNext())
+         {
+         if (e->getPC() == pc)
+            {
+            // The entry allocated here cannot be freed because alignedPersistentAlloc does not keep
+            // the address returned by the allocator; account for it in the IProfiler statistics
+            VM_AtomicSupport::add(&_numEntriesAbandoned, 1);
+            VM_AtomicSupport::add(&_bytesAbandoned, entrySize);
+            return e;
+            }
+         }
+      head = oldHead;
+      }
    }
 
 TR_IPBCDataAllocation *
@@ -1152,8 +1198,32 @@ TR_IProfiler::findOrCreateMethodEntry(J9Method *callerMethod, J9Method *calleeMe
          entry->_caller.setPCIndex(pcIndex);
          entry->_caller.incWeight();
 
-         FLUSH_MEMORY(TR::Compiler->target.isSMP());
-         _methodHashTable[bucket] = entry; // chain it
+         // chain it; another parser thread may be adding to the same bucket
+         TR_IPMethodHashTableEntry *head = entry->_next;
+         while (true)
+            {
+            FLUSH_MEMORY(TR::Compiler->target.isSMP());
+            TR_IPMethodHashTableEntry *oldHead = (TR_IPMethodHashTableEntry *)VM_AtomicSupport::lockCompareExchange(
+               (uintptr_t *)&_methodHashTable[bucket], (uintptr_t)head, (uintptr_t)entry);
+            if (oldHead == head)
+               break;
+            TR_IPMethodHashTableEntry *existing = oldHead;
+            for (; existing != head; existing = existing->_next)
+               {
+               if (existing->_method == (TR_OpaqueMethodBlock *)calleeMethod)
+                  break;
+               }
+            if (existing != head)
+               {
+               jitPersistentFree(entry);
+               memoryConsumed -= (int32_t)sizeof(TR_IPMethodHashTableEntry);
+               entry = existing;
+               entry->add((TR_OpaqueMethodBlock *)callerMethod, (TR_OpaqueMethodBlock *)calleeMethod, pcIndex);
+               break;
+               }
+            head = oldHead;
+            entry->_next = head;
+            }
          }
       }
    return entry;
@@ -1396,6 +1466,9 @@ TR_IProfiler::profilingSample (TR_OpaqueMethodBlock *method, uint32_t byteCodeIn
       U_8 bytecode =  *(U_8 *)pc;
       // Find the pc in the IProfiler/bytecode hashtable
       TR_IPBytecodeHashTableEntry * currentEntry = findOrCreateEntry(bcHash(pc), pc, false);
+      // Not sampled in this run yet; the snapshot from a previous run may have data for this method
+      if (!currentEntry && _snapshot && _snapshot->loadMethod(this, (J9Method *)method, comp))
+         currentEntry = findOrCreateEntry(bcHash(pc), pc, false);
       TR_IPBytecodeHashTableEntry * persistentEntry = NULL;
       TR_IPBytecodeHashTableEntry * entry = currentEntry;
       TR_IPBCDataStorageHeader *persistentEntryStore = NULL;
@@ -2434,6 +2507,20 @@ TR_IProfiler::createIProfilingValueInfo (TR_ByteCodeInfo &bcInfo, TR::Compilatio
                   list->incrementOrCreate(address, &addrOfTotalFrequency, i, weight, &comp->trMemory()->heapMemoryRegion());
                   }
                }
+            // Megamorphic but skewed call sites keep more receivers in the extended slots
+            if (CallSiteExtendedProfileInfo *extendedCSInfo = cgData->getExtendedCGData())
+               {
+               for (int32_t i = 0; i < NUM_EXTENDED_CS_SLOTS; i++)
+                  {
+                  data = extendedCSInfo->_clazz[i];
+                  if (data)
+                     {
+                     weight = cgData->getEdgeWeight((TR_OpaqueClassBlock *)data, comp);
+                     ProfileAddressType address = static_cast<ProfileAddressType>(data);
+                     list->incrementOrCreate(address, &addrOfTotalFrequency, NUM_CS_SLOTS + i, weight, &comp->trMemory()->heapMemoryRegion());
+                     }
+                  }
+               }
             // add residual to last total frequency
             *addrOfTotalFrequency = (*addrOfTotalFrequency) + csInfo->_residueWeight;
             }
@@ -2572,12 +2659,44 @@ TR_IProfiler::outputStats()
       fprintf(stderr, "IProfiler: Number of buffers to be processed           =%" OMR_PRIu64 "\n", _numRequests);
       fprintf(stderr, "IProfiler: Number of buffers discarded                 =%" OMR_PRIu64 "\n", _numRequestsSkipped);
       fprintf(stderr, "IProfiler: Number of buffers handed to iprofiler thread=%" OMR_PRIu64 "\n", _numRequestsHandedToIProfilerThread);
+      fprintf(stderr, "IProfiler: Number of parser threads                    =%d\n", _numParserThreads);
+      fprintf(stderr, "IProfiler: Number of buffers parsed by parser threads  =%" OMR_PRIu64 "\n", _numBuffersParsed);
+      fprintf(stderr, "IProfiler: Number of buffers dropped before parsing    =%" OMR_PRIu64 "\n", _numBuffersDropped);
+      if (_numBuffersParsed > 0)
+         {
+         fprintf(stderr, "IProfiler: Queue time (usec) avg=%" OMR_PRIu64 " max=%" OMR_PRIu64 "\n", _totalQueueTime / _numBuffersParsed, _maxQueueTime);
+         fprintf(stderr, "IProfiler: Parse time (usec) avg=%" OMR_PRIu64 " total=%" OMR_PRIu64 "\n", _totalParseTime / _numBuffersParsed, _totalParseTime);
+         }
       }
    fprintf(stderr, "IProfiler: Number of records processed=%" OMR_PRIu64 "\n", _iprofilerNumRecords);
    fprintf(stderr, "IProfiler: Number of hashtable entries=%u\n", countEntries());
+   fprintf(stderr, "IProfiler: Entries abandoned after losing an insertion race=%" OMR_PRIuPTR " (%" OMR_PRIuPTR " bytes)\n", _numEntriesAbandoned, _bytesAbandoned);
+   fprintf(stderr, "IProfiler: Memory footprint=%u bytes\n", getProfilerMemoryFootprint());
+   if (_snapshot)
+      _snapshot->printStats();
    checkMethodHashTable();
    }
 
+bool
+TR_IProfiler::writeSnapshot(J9VMThread *vmThread)
+   {
+   const char *fileName = ((TR_JitPrivateConfig *)_vm->getJ9JITConfig()->privateConfig)->iprofilerSnapshotFileName;
+   if (!fileName || !_bcHashTable)
+      return false;
+#if defined(J9VM_OPT_JITSERVER)
+   // The server holds profiling data of its clients, which is not meaningful to save
+   if (_compInfo->getPersistentInfo()->getRemoteCompilationMode() == JITServer::SERVER)
+      return false;
+#endif /* defined(J9VM_OPT_JITSERVER) */
+   // Periodic writes from the sampler thread may overlap with the write at shutdown
+   if (VM_AtomicSupport::lockCompareExchangeU32(&_writingSnapshot, 0, 1) != 0)
+      return false;
+   bool success = TR_IProfilerSnapshot::write(this, vmThread, fileName);
+   VM_AtomicSupport::writeBarrier();
+   _writingSnapshot = 0;
+   return success;
+   }
+
 void *
 TR_IPBytecodeHashTableEntry::alignedPersistentAlloc(size_t size)
    {
@@ -2595,6 +2714,40 @@ TR_IPBytecodeHashTableEntry::alignedPersistentAlloc(size_t size)
 
 
 
+void
+TR_IPBytecodeHashTableEntry::setFlags(uint32_t flags)
+   {
+   uint32_t oldFlags;
+   do {
+      oldFlags = _flags;
+      if ((oldFlags & flags) == flags)
+         return;
+      } while (VM_AtomicSupport::lockCompareExchangeU32(&_flags, oldFlags, oldFlags | flags) != oldFlags);
+   }
+
+void
+TR_IPBytecodeHashTableEntry::resetFlags(uint32_t flags)
+   {
+   uint32_t oldFlags;
+   do {
+      oldFlags = _flags;
+      if ((oldFlags & flags) == 0)
+         return;
+      } while (VM_AtomicSupport::lockCompareExchangeU32(&_flags, oldFlags, oldFlags & ~flags) != oldFlags);
+   }
+
+bool
+TR_IPBytecodeHashTableEntry::setLockedEntry()
+   {
+   uint32_t oldFlags;
+   do {
+      oldFlags = _flags;
+      if (oldFlags & IPBC_ENTRY_PERSIST_LOCK_FLAG)
+         return false;
+      } while (VM_AtomicSupport::lockCompareExchangeU32(&_flags, oldFlags, oldFlags | IPBC_ENTRY_PERSIST_LOCK_FLAG) != oldFlags);
+   return true;
+   }
+
 void *
 TR_IPBCDataCallGraph::operator new (size_t size) throw()
    {
@@ -2761,6 +2914,12 @@ TR_IPBCDataCallGraph::setData(uintptr_t v, uint32_t freq)
          maxWeight = _csInfo._weight[i];
       }
 
+   if (!found)
+      {
+      returnCount = addExtendedSample(v, freq);
+      found = (returnCount > 0);
+      }
+
    if (!found)
       {
       // Must update the `residue` bucket
@@ -2777,6 +2936,8 @@ TR_IPBCDataCallGraph::setData(uintptr_t v, uint32_t freq)
             {
             // Reset the entries in reverse order
             // Want to avoid the situation where one entry has the class reset, but a subsequent entry does not
+            if (CallSiteExtendedProfileInfo *extendedCSInfo = _extendedCSInfo)
+               extendedCSInfo->initialize();
             for (int32_t i = NUM_CS_SLOTS - 1; i > 0; i--)
                {
                _csInfo.setClazz(i, 0);
@@ -2794,6 +2955,104 @@ TR_IPBCDataCallGraph::setData(uintptr_t v, uint32_t freq)
    return returnCount;
    }
 
+CallSiteExtendedProfileInfo *
+TR_IPBCDataCallGraph::getOrCreateExtendedCGData()
+   {
+   if (_extendedCSInfo || TR::Options::_iprofilerNumExtendedCallSiteSlots <= 0)
+      return _extendedCSInfo;
+
+   // Serialization for JITServer computes the size of an entry and then writes it with the
+   // entry locked, so the extended slots can only appear while nobody holds the lock
+   if (!lockEntry())
+      return NULL;
+   if (!_extendedCSInfo)
+      {
+      CallSiteExtendedProfileInfo *extendedCSInfo = new (PERSISTENT_NEW) CallSiteExtendedProfileInfo;
+      if (extendedCSInfo)
+         {
+         memoryConsumed += (int32_t)sizeof(CallSiteExtendedProfileInfo);
+         extendedCSInfo->initialize();
+         FLUSH_MEMORY(TR::Compiler->target.isSMP());
+         _extendedCSInfo = extendedCSInfo;
+         }
+      }
+   releaseEntry();
+   return _extendedCSInfo;
+   }
+
+/**
+ * Record a receiver that did not fit in the base slots
+ *
+ * A receiver that becomes heavier than the lightest receiver in the base slots
+ * trades places with it, so consumers that only look at the base slots still see
+ * the dominant targets.
+ *
+ * @return the weight of the receiver, or 0 if the extended slots are full or unavailable
+ */
+int32_t
+TR_IPBCDataCallGraph::addExtendedSample(uintptr_t v, uint32_t freq)
+   {
+   CallSiteExtendedProfileInfo *extendedCSInfo = getOrCreateExtendedCGData();
+   if (!extendedCSInfo)
+      return 0;
+
+   int32_t numSlots = std::min(TR::Options::_iprofilerNumExtendedCallSiteSlots, NUM_EXTENDED_CS_SLOTS);
+   int32_t slot = -1;
+   for (int32_t i = 0; i < numSlots; i++)
+      {
+      if (extendedCSInfo->_clazz[i] == v)
+         {
+         uint32_t oldWeight = extendedCSInfo->_weight[i];
+         uint32_t newWeight = oldWeight + freq;
+         if (newWeight < oldWeight)
+            newWeight = 0xFFFFFFFF;
+         extendedCSInfo->_weight[i] = newWeight;
+         slot = i;
+         break;
+         }
+      else if (extendedCSInfo->_clazz[i] == 0)
+         {
+         extendedCSInfo->_clazz[i] = v;
+         extendedCSInfo->_weight[i] = freq;
+         slot = i;
+         break;
+         }
+      }
+   if (slot < 0)
+      return 0;
+
+   uint32_t weight = extendedCSInfo->_weight[slot];
+   int32_t minIndex = 0;
+   for (int32_t i = 1; i < NUM_CS_SLOTS; i++)
+      {
+      if (_csInfo._weight[i] < _csInfo._weight[minIndex])
+         minIndex = i;
+      }
+   if (weight > _csInfo._weight[minIndex] && lockEntry())
+      {
+      uintptr_t baseClazz = _csInfo.getClazz(minIndex);
+      uint16_t baseWeight = _csInfo._weight[minIndex];
+      _csInfo.setClazz(minIndex, v);
+      _csInfo._weight[minIndex] = (uint16_t)std::min<uint32_t>(weight, 0xFFFF);
+      extendedCSInfo->_clazz[slot] = baseClazz;
+      extendedCSInfo->_weight[slot] = baseWeight;
+      releaseEntry();
+      }
+   return (int32_t)std::min<uint32_t>(weight, INT_MAX);
+   }
+
+static int32_t
+sumOfExtendedWeights(CallSiteExtendedProfileInfo *extendedCSInfo)
+   {
+   if (!extendedCSInfo)
+      return 0;
+   uint64_t sumWeight = 0;
+   for (int32_t i = 0; i < NUM_EXTENDED_CS_SLOTS; i++)
+      sumWeight += extendedCSInfo->_weight[i];
+   // Leave room for the weights of the base slots
+   return (int32_t)std::min<uint64_t>(sumWeight, INT_MAX / 2);
+   }
+
 int32_t
 TR_IPBCDataCallGraph::getSumCount(TR::Compilation *comp)
    {
@@ -2801,7 +3060,7 @@ TR_IPBCDataCallGraph::getSumCount(TR::Compilation *comp)
    for (int32_t i = 0; i < NUM_CS_SLOTS; i++)
       sumWeight += _csInfo._weight[i];
 
-   return sumWeight + _csInfo._residueWeight;
+   return sumWeight + _csInfo._residueWeight + sumOfExtendedWeights(_extendedCSInfo);
    }
 
 int32_t
@@ -2821,9 +3080,10 @@ TR_IPBCDataCallGraph::getSumCount(TR::Compilation *comp, bool)
       sumWeight += _csInfo._weight[i];
       }
    sumWeight += _csInfo._residueWeight;
+   sumWeight += sumOfExtendedWeights(_extendedCSInfo);
    if(debug)
       {
-      fprintf(stderr," residueweight %d\n", _csInfo._residueWeight);
+      fprintf(stderr," residueweight %d extendedweight %d\n", _csInfo._residueWeight, sumOfExtendedWeights(_extendedCSInfo));
       fflush(stderr);
       }
    return sumWeight;
@@ -2835,6 +3095,8 @@ TR_IPBCDataCallGraph::getData(TR::Compilation *comp)
    int32_t sumWeight;
    int32_t maxWeight;
    uintptr_t data = _csInfo.getDominantClass(sumWeight, maxWeight);
+   // Receivers in the extended slots are lighter than the dominant one, but they add up
+   sumWeight += sumOfExtendedWeights(_extendedCSInfo);
 
    static bool traceIProfiling = ((debug("traceIProfiling") != NULL));
    if (traceIProfiling && comp)
@@ -2883,6 +3145,14 @@ TR_IPBCDataCallGraph::getEdgeWeight(TR_OpaqueClassBlock *clazz, TR::Compilation
          return _csInfo._weight[i];
          }
       }
+   if (CallSiteExtendedProfileInfo *extendedCSInfo = _extendedCSInfo)
+      {
+      for (int32_t i = 0; i < NUM_EXTENDED_CS_SLOTS; i++)
+         {
+         if (extendedCSInfo->_clazz[i] == (uintptr_t)clazz)
+            return (int32_t)std::min<uint32_t>(extendedCSInfo->_weight[i], INT_MAX);
+         }
+      }
    return 0;
    }
 
@@ -2899,6 +3169,17 @@ TR_IPBCDataCallGraph::printWeights(TR::Compilation *comp)
 
       fprintf(stderr, "%#" OMR_PRIxPTR " %s %d\n", _csInfo.getClazz(i), s, _csInfo._weight[i]);
       }
+   if (CallSiteExtendedProfileInfo *extendedCSInfo = _extendedCSInfo)
+      {
+      for (int32_t i = 0; i < NUM_EXTENDED_CS_SLOTS; i++)
+         {
+         if (!extendedCSInfo->_clazz[i])
+            continue;
+         int32_t len;
+         const char * s = comp->fej9()->getClassNameChars((TR_OpaqueClassBlock*)extendedCSInfo->_clazz[i], len);
+         fprintf(stderr, "%#" OMR_PRIxPTR " %s %u\n", extendedCSInfo->_clazz[i], s, extendedCSInfo->_weight[i]);
+         }
+      }
    fprintf(stderr, "%d\n", _csInfo._residueWeight);
    }
 
@@ -2910,7 +3191,18 @@ TR_IPBCDataCallGraph::updateEdgeWeight(TR_OpaqueClassBlock *clazz, int32_t weigh
       if (_csInfo.getClazz(i) == (uintptr_t)clazz)
          {
          _csInfo._weight[i] = weight;
-         break;
+         return;
+         }
+      }
+   if (CallSiteExtendedProfileInfo *extendedCSInfo = _extendedCSInfo)
+      {
+      for (int32_t i = 0; i < NUM_EXTENDED_CS_SLOTS; i++)
+         {
+         if (extendedCSInfo->_clazz[i] == (uintptr_t)clazz)
+            {
+            extendedCSInfo->_weight[i] = weight;
+            return;
+            }
          }
       }
    }
@@ -2918,38 +3210,20 @@ TR_IPBCDataCallGraph::updateEdgeWeight(TR_OpaqueClassBlock *clazz, int32_t weigh
 bool
 TR_IPBCDataCallGraph::lockEntry()
    {
-   TR::Monitor *persistenceMonitor = TR::MonitorTable::get()->getIProfilerPersistenceMonitor();
-   persistenceMonitor->enter();
-   bool success=false;
-   if (!isLockedEntry())
-      {
-      success=true;
-      setLockedEntry();
-      }
-   persistenceMonitor->exit();
-   return success;
+   return setLockedEntry();
    }
 
 void
 TR_IPBCDataCallGraph::releaseEntry()
    {
-   TR::Monitor *persistenceMonitor = TR::MonitorTable::get()->getIProfilerPersistenceMonitor();
-   persistenceMonitor->enter();
    resetLockedEntry();
-   persistenceMonitor->exit();
    }
 
 bool
 TR_IPBCDataCallGraph::isLocked()
    {
-   TR::Monitor *persistenceMonitor = TR::MonitorTable::get()->getIProfilerPersistenceMonitor();
-   persistenceMonitor->enter();
-   bool locked=false;
-   if (isLockedEntry())
-      locked=true;
-
-   persistenceMonitor->exit();
-   return locked;
+   VM_AtomicSupport::readBarrier();
+   return isLockedEntry();
    }
 
 #if defined(J9VM_OPT_JITSERVER)
@@ -3019,6 +3293,33 @@ TR_IPBCDataCallGraph::serialize(uintptr_t methodStartAddress, TR_IPBCDataStorage
    store->_csInfo._residueWeight = _csInfo._residueWeight;
    store->_csInfo._tooBigToBeInlined = _csInfo._tooBigToBeInlined;
 
+   // The entry is locked, so the extended slots cannot appear after getSerializedBytesFootprint()
+   if (CallSiteExtendedProfileInfo *extendedCSInfo = _extendedCSInfo)
+      {
+      storage->ID = TR_IPBCD_CALL_GRAPH_EXTENDED;
+      CallSiteExtendedProfileInfo *extendedStore = &((TR_IPBCDataCallGraphExtendedStorage *)storage)->_extendedCSInfo;
+      for (int32_t i = 0; i < NUM_EXTENDED_CS_SLOTS; i++)
+         {
+         J9Class *clazz = (J9Class *)extendedCSInfo->_clazz[i];
+         bool isValid = clazz && !info->isUnloadedClass(clazz, true);
+         extendedStore->_clazz[i] = isValid ? (uintptr_t)clazz : 0;
+         extendedStore->_weight[i] = isValid ? extendedCSInfo->_weight[i] : 0;
+         }
+      }
+   }
+
+/**
+ * API used by JITClient to find how much space serialize() needs for this entry
+ *
+ * Must be called with the entry locked by canBeSerialized()
+ *
+ * @return size of TR_IPBCDataCallGraphStorage, or of TR_IPBCDataCallGraphExtendedStorage
+ *         if the call site has extended slots
+ */
+uint32_t
+TR_IPBCDataCallGraph::getSerializedBytesFootprint()
+   {
+   return _extendedCSInfo ? sizeof(TR_IPBCDataCallGraphExtendedStorage) : sizeof(TR_IPBCDataCallGraphStorage);
    }
 
 
@@ -3033,7 +3334,7 @@ void
 TR_IPBCDataCallGraph::deserialize(TR_IPBCDataStorageHeader *storage)
    {
    TR_IPBCDataCallGraphStorage * store = (TR_IPBCDataCallGraphStorage *) storage;
-   TR_ASSERT(storage->ID == TR_IPBCD_CALL_GRAPH, "Incompatible types between storage and loading of iprofile persistent data");
+   TR_ASSERT(storage->ID == TR_IPBCD_CALL_GRAPH || storage->ID == TR_IPBCD_CALL_GRAPH_EXTENDED, "Incompatible types between storage and loading of iprofile persistent data");
    for (int32_t i = 0; i < NUM_CS_SLOTS; i++)
       {
       _csInfo.setClazz(i, store->_csInfo.getClazz(i));
@@ -3041,6 +3342,10 @@ TR_IPBCDataCallGraph::deserialize(TR_IPBCDataStorageHeader *storage)
       }
    _csInfo._residueWeight = store->_csInfo._residueWeight;
    _csInfo._tooBigToBeInlined = store->_csInfo._tooBigToBeInlined;
+
+   // The storage for the extended slots was allocated together with the entry by the JITServer
+   if (storage->ID == TR_IPBCD_CALL_GRAPH_EXTENDED && _extendedCSInfo)
+      *_extendedCSInfo = ((TR_IPBCDataCallGraphExtendedStorage *)storage)->_extendedCSInfo;
    }
 #endif
 
@@ -3201,6 +3506,10 @@ TR_IPBCDataCallGraph::copyFromEntry(TR_IPBytecodeHashTableEntry * originalEntry,
       }
    _csInfo._residueWeight = entry->_csInfo._residueWeight;
    _csInfo._tooBigToBeInlined = entry->_csInfo._tooBigToBeInlined;
+
+   CallSiteExtendedProfileInfo *originalExtendedCSInfo = entry->_extendedCSInfo;
+   if (originalExtendedCSInfo && getOrCreateExtendedCGData())
+      *_extendedCSInfo = *originalExtendedCSInfo;
    }
 
 TR_IPBCDataCallGraph*
@@ -3647,7 +3956,8 @@ bool TR_IProfiler::getCallerWeight(TR_OpaqueMethodBlock *calleeMethod,TR_OpaqueM
 
 static int32_t J9THREAD_PROC iprofilerThreadProc(void * entryarg)
    {
-   J9JITConfig * jitConfig = (J9JITConfig *) entryarg;
+   IProfilerParserThread *parserThread = (IProfilerParserThread *) entryarg;
+   J9JITConfig * jitConfig = parserThread->_jitConfig;
    J9JavaVM * vm           = jitConfig->javaVM;
    TR_J9VMBase *fe = TR_J9VM::get(jitConfig, 0);
    TR_IProfiler *iProfiler = fe->getIProfiler();
@@ -3657,11 +3967,14 @@ static int32_t J9THREAD_PROC iprofilerThreadProc(void * entryarg)
    int rc = vm->internalVMFunctions->internalAttachCurrentThread(vm, &iprofilerThread, NULL,
                                   J9_PRIVATE_FLAGS_DAEMON_THREAD | J9_PRIVATE_FLAGS_NO_OBJECT |
                                   J9_PRIVATE_FLAGS_SYSTEM_THREAD | J9_PRIVATE_FLAGS_ATTACHED_THREAD,
-                                  iProfiler->getIProfilerOSThread());
+                                  parserThread->_osThread);
    iProfiler->getIProfilerMonitor()->enter();
-   iProfiler->setAttachAttempted(true);
+   parserThread->_attachAttempted = true;
    if (rc == JNI_OK)
-      iProfiler->setIProfilerThread(iprofilerThread);
+      {
+      parserThread->_vmThread = iprofilerThread;
+      iProfiler->parserThreadAttached();
+      }
    iProfiler->getIProfilerMonitor()->notifyAll();
    iProfiler->getIProfilerMonitor()->exit();
    if (rc != JNI_OK)
@@ -3672,20 +3985,20 @@ static int32_t J9THREAD_PROC iprofilerThreadProc(void * entryarg)
       (*vm->javaOffloadSwitchOnWithReasonFunc)(iprofilerThread, J9_JNI_OFFLOAD_SWITCH_JIT_IPROFILER_THREAD);
 #endif
 
-   j9thread_set_name(j9thread_self(), "JIT IProfiler");
+   j9thread_set_name(j9thread_self(), (parserThread->_index > 0) ? "JIT IProfiler Helper" : "JIT IProfiler");
 
-   iProfiler->processWorkingQueue();
+   iProfiler->processWorkingQueue(parserThread);
 
    vm->internalVMFunctions->DetachCurrentThread((JavaVM *) vm);
-   iProfiler->setIProfilerThread(NULL);
+   parserThread->_vmThread = NULL;
    iProfiler->getIProfilerMonitor()->enter();
    // free the special buffer because we don't need it anymore
-   if (iProfiler->getCrtProfilingBuffer())
+   if (parserThread->_crtProfilingBuffer)
       {
-      j9mem_free_memory(iProfiler->getCrtProfilingBuffer());
-      iProfiler->setCrtProfilingBuffer(NULL);
+      j9mem_free_memory(parserThread->_crtProfilingBuffer);
+      parserThread->_crtProfilingBuffer = NULL;
       }
-   iProfiler->setIProfilerThreadExitFlag();
+   iProfiler->parserThreadExited();
    iProfiler->getIProfilerMonitor()->notifyAll();
    j9thread_exit((J9ThreadMonitor*)iProfiler->getIProfilerMonitor()->getVMMonitor());
 
@@ -3698,37 +4011,60 @@ static int32_t J9THREAD_PROC iprofilerThreadProc(void * entryarg)
    return 0;
    }
 
+// Create one parser thread and wait until it attaches to the VM
+// Returns false if the thread could not be created
+bool TR_IProfiler::createParserThread(J9JavaVM *javaVM, int32_t index)
+   {
+   IProfilerParserThread *parserThread = &_parserThreads[index];
+   parserThread->_jitConfig = javaVM->jitConfig;
+   parserThread->_index = index;
+   if (javaVM->internalVMFunctions->createThreadWithCategory(&parserThread->_osThread,
+                                   TR::Options::_profilerStackSize << 10,
+                                   J9THREAD_PRIORITY_NORMAL,
+                                   0,
+                                   &iprofilerThreadProc,
+                                   parserThread,
+                                   J9THREAD_CATEGORY_SYSTEM_JIT_THREAD))
+      return false;
+
+   // Must wait here until the thread gets created; otherwise an early shutdown
+   // does not know whether or not to destroy the thread
+   _iprofilerMonitor->enter();
+   _numParserThreads++;
+   while (!parserThread->_attachAttempted)
+      _iprofilerMonitor->wait();
+   _iprofilerMonitor->exit();
+   return true;
+   }
 
 void TR_IProfiler::startIProfilerThread(J9JavaVM *javaVM)
    {
    PORT_ACCESS_FROM_PORT(_portLib);
-   UDATA priority;
-
-   priority = J9THREAD_PRIORITY_NORMAL;
 
    _iprofilerMonitor = TR::Monitor::create("JIT-iprofilerMonitor");
    if (_iprofilerMonitor)
       {
       // create the thread for interpreter profiling
-      if(javaVM->internalVMFunctions->createThreadWithCategory(&_iprofilerOSThread,
-                                      TR::Options::_profilerStackSize << 10,
-                                      priority,
-                                      0,
-                                      &iprofilerThreadProc,
-                                      javaVM->jitConfig,
-                                      J9THREAD_CATEGORY_SYSTEM_JIT_THREAD))
+      if (!createParserThread(javaVM, 0))
          {
          j9tty_printf(PORTLIB, "Error: Unable to create iprofiler thread\n");
          TR::Options::getCmdLineOptions()->setOption(TR_DisableIProfilerThread);
          // TODO:destroy the monitor that was created (_iprofilerMonitor)
          _iprofilerMonitor = NULL;
          }
-      else // Must wait here until the thread gets created; otherwise an early shutdown
-         { // does not know whether or not to destroy the thread
-         _iprofilerMonitor->enter();
-         while (!getAttachAttempted())
-            _iprofilerMonitor->wait();
-         _iprofilerMonitor->exit();
+      else if (getIProfilerThread())
+         {
+         // Helpers share the parsing of posted buffers with the IProfiler thread;
+         // failing to create them is not an error
+         int32_t numHelpers = TR::Options::_iprofilerNumHelperThreads;
+         if (numHelpers < 0) // not set on the command line; one helper per 8 additional CPUs
+            numHelpers = (int32_t)((TR::Compiler->target.numberOfProcessors() - 1) / 8);
+         numHelpers = std::min(numHelpers, IPROFILER_MAX_PARSER_THREADS - 1);
+         for (int32_t i = 1; i <= numHelpers; i++)
+            {
+            if (!createParserThread(javaVM, i))
+               break;
+            }
          }
       }
    else
@@ -3779,51 +4115,47 @@ void TR_IProfiler::stopIProfilerThread()
       return;
       }
 
-   // get a special buffer which will be used as a signal to stop iprofilerThread
-   //
-   IProfilerBuffer *specialProfilingBuffer = NULL;
-   if (!_freeBufferList.isEmpty())
-      {
-      specialProfilingBuffer = _freeBufferList.pop();
-      }
-   else if (!_workingBufferList.isEmpty())
-      {
-      specialProfilingBuffer = _workingBufferList.pop();
-      _numOutstandingBuffers--;
-      if (_workingBufferList.isEmpty())
-         _workingBufferTail = NULL;
-      }
-   else
-      {
-      specialProfilingBuffer = (IProfilerBuffer*)j9mem_allocate_memory(sizeof(IProfilerBuffer), J9MEM_CATEGORY_JIT);
-      if (specialProfilingBuffer)
-    specialProfilingBuffer->setBuffer(NULL);
-      }
-
    // Deallocate all outstanding buffers
    while (!_workingBufferList.isEmpty())
       {
       IProfilerBuffer *profilingBuffer = _workingBufferList.pop();
       _numOutstandingBuffers--;
+      _numBuffersDropped++;
       _freeBufferList.add(profilingBuffer);
       }
    _workingBufferTail = NULL;
 
-   // Add the special request
-   if (specialProfilingBuffer)
+   // Each parser thread exits when it dequeues a special buffer
+   int32_t numSpecialBuffers = 0;
+   for (; numSpecialBuffers < _numParserThreadsRunning; numSpecialBuffers++)
       {
+      IProfilerBuffer *specialProfilingBuffer = NULL;
+      if (!_freeBufferList.isEmpty())
+         {
+         specialProfilingBuffer = _freeBufferList.pop();
+         }
+      else
+         {
+         specialProfilingBuffer = (IProfilerBuffer*)j9mem_allocate_memory(sizeof(IProfilerBuffer), J9MEM_CATEGORY_JIT);
+         if (!specialProfilingBuffer)
+            break;
+         specialProfilingBuffer->setBuffer(NULL);
+         }
       if (specialProfilingBuffer->getBuffer())
          j9mem_free_memory(specialProfilingBuffer->getBuffer());
       specialProfilingBuffer->setBuffer(NULL);
       specialProfilingBuffer->setSize(0);
-      _workingBufferList.add(specialProfilingBuffer);
+      _workingBufferList.insertAfter(_workingBufferTail, specialProfilingBuffer);
       _workingBufferTail = specialProfilingBuffer;
-      // wait for the iprofilerThread to stop
-      while (!_iprofilerThreadExitFlag)
-         {
-         _iprofilerMonitor->notifyAll();
-         _iprofilerMonitor->wait();
-         }
+      }
+
+   // wait for the parser threads to stop; if we could not get a special buffer
+   // for each of them, only wait for the ones that will see one
+   int32_t numThreadsToRemain = _numParserThreadsRunning - numSpecialBuffers;
+   while (_numParserThreadsRunning > numThreadsToRemain)
+      {
+      _iprofilerMonitor->notifyAll();
+      _iprofilerMonitor->wait();
       }
 
    _iprofilerMonitor->exit();
@@ -3872,6 +4204,7 @@ TR_IProfiler::postIprofilingBufferToWorkingQueue(J9VMThread * vmThread, const U_
    freeBuffer->setBuffer((U_8*)dataStart);
    freeBuffer->setSize(size);
    freeBuffer->setIsInvalidated(false); // reset while holding VM access
+   freeBuffer->setPostTime(j9time_usec_clock());
    _workingBufferList.insertAfter(_workingBufferTail, freeBuffer);
    _workingBufferTail = freeBuffer;
 
@@ -3917,10 +4250,11 @@ bool TR_IProfiler::processProfilingBuffer(J9VMThread *vmThread, const U_8* dataS
    }
 
 
-// This method is executed by the iprofiling thread
-void TR_IProfiler::processWorkingQueue()
+// This method is executed by the iprofiling thread and its helpers
+void TR_IProfiler::processWorkingQueue(IProfilerParserThread *parserThread)
    {
    PORT_ACCESS_FROM_PORT(_portLib);
+   J9VMThread *vmThread = parserThread->_vmThread;
    // wait for something to do
    _iprofilerMonitor->enter();
    do {
@@ -3932,24 +4266,32 @@ void TR_IProfiler::processWorkingQueue()
       // We have some buffer to process
       // Dequeue the buffer to be processed
       //
-      _crtProfilingBuffer = _workingBufferList.pop();
+      IProfilerBuffer *profilingBuffer = _workingBufferList.pop();
+      parserThread->_crtProfilingBuffer = profilingBuffer;
       if (_workingBufferList.isEmpty())
          _workingBufferTail = NULL;
 
       // We don't need the iprofiler monitor now
       _iprofilerMonitor->exit();
-      if (_crtProfilingBuffer->getSize() > 0)
+      uint64_t queueTime = 0;
+      uint64_t parseTime = 0;
+      bool parsed = false;
+      if (profilingBuffer->getSize() > 0)
          {
          // process the buffer after acquiring VM access
-         acquireVMAccessNoSuspend(_iprofilerThread);   // blocking. Will wait for the entire GC
+         acquireVMAccessNoSuspend(vmThread);   // blocking. Will wait for the entire GC
          // Check to see if GC has invalidated this buffer
-         if (_crtProfilingBuffer->isValid())
+         if (profilingBuffer->isValid())
             {
+            uint64_t startTime = j9time_usec_clock();
+            queueTime = startTime - profilingBuffer->getPostTime();
          //fprintf(stderr, "IProfiler thread will process buffer %p of size %u\n", profilingBuffer->getBuffer(), profilingBuffer->getSize());
-            parseBuffer(_iprofilerThread, _crtProfilingBuffer->getBuffer(), _crtProfilingBuffer->getSize());
+            parseBuffer(vmThread, profilingBuffer->getBuffer(), profilingBuffer->getSize());
          //fprintf(stderr, "IProfiler thread finished processing\n");
+            parseTime = j9time_usec_clock() - startTime;
+            parsed = true;
             }
-         releaseVMAccess(_iprofilerThread);
+         releaseVMAccess(vmThread);
          }
       else // Special
          {
@@ -3957,8 +4299,16 @@ void TR_IProfiler::processWorkingQueue()
          }
       // attach the buffer to the buffer pool
       _iprofilerMonitor->enter();
-      _freeBufferList.add(_crtProfilingBuffer);
-      _crtProfilingBuffer = NULL;
+      if (parsed)
+         {
+         _numBuffersParsed++;
+         _totalQueueTime += queueTime;
+         if (queueTime > _maxQueueTime)
+            _maxQueueTime = queueTime;
+         _totalParseTime += parseTime;
+         }
+      _freeBufferList.add(profilingBuffer);
+      parserThread->_crtProfilingBuffer = NULL;
       _numOutstandingBuffers--;
       }while(1);
    }
@@ -4155,7 +4505,7 @@ UDATA TR_IProfiler::parseBuffer(J9VMThread * vmThread, const U_8* dataStart, UDA
             uint32_t offset = (uint32_t) (pc - caller->bytecodes);
             findOrCreateMethodEntry(caller, callee , true ,offset);
             if (_compInfo->getLowPriorityCompQueue().isTrackingEnabled() &&  // is feature enabled?
-                vmThread == _iprofilerThread) // only IProfiler thread is allowed to execute this
+                vmThread == getIProfilerThread()) // only IProfiler thread is allowed to execute this
                {
                _compInfo->getLowPriorityCompQueue().tryToScheduleCompilation(vmThread, caller);
                }
@@ -4181,7 +4531,7 @@ UDATA TR_IProfiler::parseBuffer(J9VMThread * vmThread, const U_8* dataStart, UDA
                uint32_t offset = (uint32_t) (pc - caller->bytecodes);
                findOrCreateMethodEntry(caller, callee , true , offset);
                if (_compInfo->getLowPriorityCompQueue().isTrackingEnabled() &&  // is feature enabled?
-                  vmThread == _iprofilerThread)  // only IProfiler thread is allowed to execute this
+                  vmThread == getIProfilerThread())  // only IProfiler thread is allowed to execute this
                   {
                   _compInfo->getLowPriorityCompQueue().tryToScheduleCompilation(vmThread, caller);
                   }
@@ -4323,12 +4673,17 @@ void TR_IProfiler::invalidateProfilingBuffers() // called for class unloading
       _iprofilerMonitor->exit();
       return;
       }
-   IProfilerBuffer *specialProfilingBuffer = NULL;
-   if (_crtProfilingBuffer && _crtProfilingBuffer->getSize() > 0)
+   for (int32_t i = 0; i < _numParserThreads; i++)
       {
-      // mark this buffer as invalid
-      _crtProfilingBuffer->setIsInvalidated(true); // set with exclusive VM access
+      IProfilerBuffer *crtProfilingBuffer = _parserThreads[i]._crtProfilingBuffer;
+      if (crtProfilingBuffer && crtProfilingBuffer->getSize() > 0 && crtProfilingBuffer->isValid())
+         {
+         // mark this buffer as invalid
+         crtProfilingBuffer->setIsInvalidated(true); // set with exclusive VM access
+         _numBuffersDropped++;
+         }
       }
+   TR_LinkHead0<IProfilerBuffer> specialProfilingBuffers;
    while (!_workingBufferList.isEmpty())
       {
       IProfilerBuffer *profilingBuffer = _workingBufferList.pop();
@@ -4337,18 +4692,20 @@ void TR_IProfiler::invalidateProfilingBuffers() // called for class unloading
          // attach the buffer to the buffer pool
          _freeBufferList.add(profilingBuffer);
          _numOutstandingBuffers--;
+         _numBuffersDropped++;
          }
-      else // When the iprofiler thread sees this special buffer it will exit
+      else // When a parser thread sees a special buffer it will exit
          {
-         specialProfilingBuffer = profilingBuffer;
+         specialProfilingBuffers.add(profilingBuffer);
          }
       }
    _workingBufferTail = NULL; // queue should be empty now
 
-   if (specialProfilingBuffer)
+   // Put the special buffers back
+   while (!specialProfilingBuffers.isEmpty())
       {
-      // Put this buffer back
-      _workingBufferList.add(specialProfilingBuffer);
+      IProfilerBuffer *specialProfilingBuffer = specialProfilingBuffers.pop();
+      _workingBufferList.insertAfter(_workingBufferTail, specialProfilingBuffer);
       _workingBufferTail = specialProfilingBuffer;
       }
    _iprofilerMonitor->exit();
@@ -80,6 +80,7 @@ class TR_IPBCDataCallGraph;
 class TR_IPBCDataFourBytes;
 class TR_IPBCDataEightWords;
 class TR_IPBCDataAllocation;
+class TR_IProfilerSnapshot;
 class TR_IPByteVector;
 class TR_J9ByteCodeIterator;
 class TR_ExternalValueProfileInfo;
@@ -144,9 +145,31 @@ private:
    uintptr_t _clazz[NUM_CS_SLOTS]; // store them in either 64 or 32 bits
    };
 
+// Receivers tracked in addition to the NUM_CS_SLOTS of CallSiteProfileInfo,
+// for call sites that see more receiver classes than fit there
+#define NUM_EXTENDED_CS_SLOTS 5
+class CallSiteExtendedProfileInfo
+   {
+public:
+   TR_PERSISTENT_ALLOC(TR_Memory::IPBCDataCallGraph)
+
+   void initialize()
+         {
+         for (int i = 0; i < NUM_EXTENDED_CS_SLOTS; i++)
+            {
+            _clazz[i] = 0;
+            _weight[i] = 0;
+            }
+         }
+
+   uintptr_t _clazz[NUM_EXTENDED_CS_SLOTS]; // J9Class pointers, never compressed
+   uint32_t _weight[NUM_EXTENDED_CS_SLOTS]; // saturating counters
+   };
+
 #define TR_IPBCD_FOUR_BYTES  1
 #define TR_IPBCD_EIGHT_WORDS 2
 #define TR_IPBCD_CALL_GRAPH  3
+#define TR_IPBCD_CALL_GRAPH_EXTENDED 4 // JITServer only: TR_IPBCD_CALL_GRAPH followed by the extended slots
 
 
 // We rely on the following structures having the same first 4 fields
@@ -176,6 +199,12 @@ typedef struct TR_IPBCDataCallGraphStorage
    CallSiteProfileInfo _csInfo;
    } TR_IPBCDataCallGraphStorage;
 
+typedef struct TR_IPBCDataCallGraphExtendedStorage
+   {
+   TR_IPBCDataCallGraphStorage cgStorage;
+   CallSiteExtendedProfileInfo _extendedCSInfo;
+   } TR_IPBCDataCallGraphExtendedStorage;
+
 enum TR_EntryStatusInfo
    {
    IPBC_ENTRY_CANNOT_PERSIST = 0,
@@ -185,7 +214,7 @@ enum TR_EntryStatusInfo
    IPBC_ENTRY_PERSIST_UNLOADED
    };
 
-#define TR_IPBC_PERSISTENT_ENTRY_READ  0x1 // used to check if the persistent entry has been read, if so we want to avoid the overhead introduced by calculating sample counts
+#define TR_IPBC_PERSISTENT_ENTRY_READ  0x4 // used to check if the persistent entry has been read, if so we want to avoid the overhead introduced by calculating sample counts
 
 // Hash table for bytecodes
 class TR_IPBytecodeHashTableEntry
@@ -193,7 +222,7 @@ class TR_IPBytecodeHashTableEntry
 public:
    TR_PERSISTENT_ALLOC(TR_Memory::IProfiler)
    static void* alignedPersistentAlloc(size_t size);
-   TR_IPBytecodeHashTableEntry(uintptr_t pc) : _next(NULL), _pc(pc), _lastSeenClassUnloadID(-1), _entryFlags(0), _persistFlags(IPBC_ENTRY_CAN_PERSIST_FLAG) {}
+   TR_IPBytecodeHashTableEntry(uintptr_t pc) : _next(NULL), _pc(pc), _lastSeenClassUnloadID(-1), _flags(IPBC_ENTRY_CAN_PERSIST_FLAG) {}
 
    uintptr_t getPC() const { return _pc; }
    TR_IPBytecodeHashTableEntry * getNext() const { return _next; }
@@ -218,6 +247,8 @@ public:
    // Serialization used for JITServer
    // not sufficient for persisting to the shared cache
    virtual uint32_t canBeSerialized(TR::PersistentInfo *info) { return IPBC_ENTRY_CAN_PERSIST; }
+   // Size of the data written by serialize(), which may differ from the size stored in the SCC
+   virtual uint32_t getSerializedBytesFootprint() { return getBytesFootprint(); }
    virtual void serialize(uintptr_t methodStartAddress, TR_IPBCDataStorageHeader *storage, TR::PersistentInfo *info) = 0;
    virtual void deserialize(TR_IPBCDataStorageHeader *storage) = 0;
 #endif
@@ -226,17 +257,22 @@ public:
    virtual void createPersistentCopy(TR_J9SharedCache *sharedCache, TR_IPBCDataStorageHeader *storage, TR::PersistentInfo *info)  = 0;
    virtual void loadFromPersistentCopy(TR_IPBCDataStorageHeader *storage, TR::Compilation *comp) {}
    virtual void copyFromEntry(TR_IPBytecodeHashTableEntry * originalEntry, TR::Compilation *comp) {}
-   void clearEntryFlags(){ _entryFlags = 0;};
-   void setPersistentEntryRead(){ _entryFlags |= TR_IPBC_PERSISTENT_ENTRY_READ;};
-   bool isPersistentEntryRead(){ return (_entryFlags & TR_IPBC_PERSISTENT_ENTRY_READ) != 0;};
+   void clearEntryFlags(){ resetFlags(TR_IPBC_PERSISTENT_ENTRY_READ);};
+   void setPersistentEntryRead(){ setFlags(TR_IPBC_PERSISTENT_ENTRY_READ);};
+   bool isPersistentEntryRead(){ return (_flags & TR_IPBC_PERSISTENT_ENTRY_READ) != 0;};
 
-   bool getCanPersistEntryFlag() const { return (_persistFlags & IPBC_ENTRY_CAN_PERSIST_FLAG) != 0; }
-   void setDoNotPersist() { _persistFlags &= ~IPBC_ENTRY_CAN_PERSIST_FLAG; }
-   bool isLockedEntry() const { return (_persistFlags & IPBC_ENTRY_PERSIST_LOCK_FLAG) != 0; }
-   void setLockedEntry() { _persistFlags |= IPBC_ENTRY_PERSIST_LOCK_FLAG; }
-   void resetLockedEntry() { _persistFlags &= ~IPBC_ENTRY_PERSIST_LOCK_FLAG; }
+   bool getCanPersistEntryFlag() const { return (_flags & IPBC_ENTRY_CAN_PERSIST_FLAG) != 0; }
+   void setDoNotPersist() { resetFlags(IPBC_ENTRY_CAN_PERSIST_FLAG); }
+   bool isLockedEntry() const { return (_flags & IPBC_ENTRY_PERSIST_LOCK_FLAG) != 0; }
+   bool setLockedEntry(); // returns false if the entry was already locked
+   void resetLockedEntry() { resetFlags(IPBC_ENTRY_PERSIST_LOCK_FLAG); }
 
 protected:
+   // Entries are updated concurrently by all threads parsing profiling buffers,
+   // so flags are only changed with atomic read-modify-write operations
+   void setFlags(uint32_t flags);
+   void resetFlags(uint32_t flags);
+
    TR_IPBytecodeHashTableEntry *_next;
    uintptr_t _pc;
    int32_t    _lastSeenClassUnloadID;
@@ -247,8 +283,7 @@ protected:
       IPBC_ENTRY_PERSIST_LOCK_FLAG = 0x02,
       };
 
-   uint8_t _entryFlags;
-   uint8_t _persistFlags;
+   volatile uint32_t _flags; // TR_PersistenceFlags and TR_IPBC_PERSISTENT_ENTRY_READ
    }; // class TR_IPBytecodeHashTableEntry
 
 class TR_IPMethodData
@@ -391,7 +426,7 @@ class TR_IPBCDataCallGraph : public TR_IPBytecodeHashTableEntry
    {
 public:
    TR_PERSISTENT_ALLOC(TR_Memory::IPBCDataCallGraph)
-   TR_IPBCDataCallGraph (uintptr_t pc) : TR_IPBytecodeHashTableEntry(pc)
+   TR_IPBCDataCallGraph (uintptr_t pc) : TR_IPBytecodeHashTableEntry(pc), _extendedCSInfo(NULL)
       {
       _csInfo.initialize();
       }
@@ -409,6 +444,11 @@ public:
 
    virtual uintptr_t getData(TR::Compilation *comp = NULL);
    virtual CallSiteProfileInfo* getCGData() { return &_csInfo; } // overloaded
+   // Receivers beyond the NUM_CS_SLOTS of getCGData(); NULL unless the call site overflowed them.
+   // The base slots always hold the heaviest receivers seen so far.
+   CallSiteExtendedProfileInfo *getExtendedCGData() const { return _extendedCSInfo; }
+   // Used by the JITServer to point to storage allocated together with the entry
+   void setExtendedCGData(CallSiteExtendedProfileInfo *info) { _extendedCSInfo = info; }
    virtual int32_t setData(uintptr_t v, uint32_t freq = 1);
    virtual uint32_t* getDataReference() { return NULL; }
    virtual bool isCompact() { return false; }
@@ -428,6 +468,7 @@ public:
 
 #if defined(J9VM_OPT_JITSERVER)
    virtual uint32_t canBeSerialized(TR::PersistentInfo *info);
+   virtual uint32_t getSerializedBytesFootprint();
    virtual void serialize(uintptr_t methodStartAddress, TR_IPBCDataStorageHeader *storage, TR::PersistentInfo *info);
    virtual void deserialize(TR_IPBCDataStorageHeader *storage);
 #endif
@@ -442,7 +483,11 @@ public:
    bool isLocked();
 
 private:
+   int32_t addExtendedSample(uintptr_t v, uint32_t freq);
+   CallSiteExtendedProfileInfo *getOrCreateExtendedCGData();
+
    CallSiteProfileInfo _csInfo;
+   CallSiteExtendedProfileInfo * volatile _extendedCSInfo;
    };
 
 class IProfilerBuffer : public TR_Link0<IProfilerBuffer>
@@ -454,12 +499,30 @@ class IProfilerBuffer : public TR_Link0<IProfilerBuffer>
    void setSize(UDATA size) {_size = size;}
    bool isValid() const { return !_isInvalidated; }
    void setIsInvalidated(bool b) { _isInvalidated = b; }
+   uint64_t getPostTime() const { return _postTime; }
+   void setPostTime(uint64_t t) { _postTime = t; }
    private:
    U_8 *_buffer;
    UDATA _size;
+   uint64_t _postTime; // usec; when an app thread handed the buffer to the parser threads
    volatile bool _isInvalidated;
    };
 
+#define IPROFILER_MAX_PARSER_THREADS 4 // the IProfiler thread and up to 3 helpers
+
+// A thread that parses the profiling buffers posted by application threads.
+// Slot 0 is the IProfiler thread; the other slots are helper threads that
+// only parse buffers and leave all other IProfiler thread duties alone.
+struct IProfilerParserThread
+   {
+   J9JITConfig *_jitConfig;
+   int32_t _index;
+   j9thread_t _osThread;
+   J9VMThread *_vmThread;
+   IProfilerBuffer *_crtProfilingBuffer; // profiling buffer being processed by this thread
+   volatile bool _attachAttempted;
+   };
+
 class TR_ReadSampleRequestsStats
    {
 friend class TR_ReadSampleRequestsHistory;
@@ -495,6 +558,7 @@ private:
 
 class TR_IProfiler : public TR_ExternalProfiler
    {
+friend class TR_IProfilerSnapshot;
 public:
 
    TR_PERSISTENT_ALLOC(TR_Memory::IProfiler);
@@ -568,20 +632,20 @@ public:
 
 
 public:
-   J9VMThread* getIProfilerThread() { return _iprofilerThread; }
-   void setIProfilerThread(J9VMThread* thread) { _iprofilerThread = thread; }
-   j9thread_t getIProfilerOSThread() { return _iprofilerOSThread; }
+   J9VMThread* getIProfilerThread() { return _parserThreads[0]._vmThread; }
+   int32_t getNumParserThreads() const { return _numParserThreads; }
+   J9VMThread* getParserThread(int32_t i) { return _parserThreads[i]._vmThread; }
    TR::Monitor* getIProfilerMonitor() { return _iprofilerMonitor; }
    bool processProfilingBuffer(J9VMThread *vmThread, const U_8* dataStart, UDATA size);
-   void setAttachAttempted(bool b) { _iprofilerThreadAttachAttempted = b; }
-   void processWorkingQueue();
-   bool getAttachAttempted() const { return _iprofilerThreadAttachAttempted; }
-   IProfilerBuffer *getCrtProfilingBuffer() const { return _crtProfilingBuffer; }
-   void setCrtProfilingBuffer(IProfilerBuffer *b) { _crtProfilingBuffer = b; }
-   void setIProfilerThreadExitFlag() { _iprofilerThreadExitFlag = 1; }
+   void processWorkingQueue(IProfilerParserThread *parserThread);
+   // Called by parser threads with the IProfiler monitor in hand
+   void parserThreadAttached() { _numParserThreadsRunning++; }
+   void parserThreadExited() { if (--_numParserThreadsRunning == 0) _iprofilerThreadExitFlag = 1; }
    void jitProfileParseBuffer(J9VMThread *vmThread);
    uint32_t getIProfilerThreadExitFlag() { return _iprofilerThreadExitFlag; }
    bool postIprofilingBufferToWorkingQueue(J9VMThread * vmThread, const U_8* dataStart, UDATA size);
+   // Save the profiling data to the file given by -Xjit:iprofilerSnapshotFile=
+   bool writeSnapshot(J9VMThread *vmThread);
    // this is wrapper of registered version, for the helper function, from JitRunTime
 
    // Data accessors, overridden for JITServer
@@ -640,6 +704,8 @@ private:
    static int32_t methodHash(uintptr_t pc);
 //   static int32_t pcHash(uintptr_t pc);
 
+   bool createParserThread(J9JavaVM *javaVM, int32_t index);
+
    bool acquireHashTableWriteLock(bool forceFullLock);
    void releaseHashTableWriteLock();
 
@@ -701,25 +767,36 @@ private:
    bool                            _enableCGProfiling;
    uint32_t                        _globalAllocationCount;
    int32_t                         _maxCallFrequency;
-   j9thread_t                      _iprofilerOSThread;
-   J9VMThread                     *_iprofilerThread;
+   IProfilerParserThread           _parserThreads[IPROFILER_MAX_PARSER_THREADS];
+   int32_t                         _numParserThreads; // threads created
+   int32_t                         _numParserThreadsRunning; // threads attached and not yet exited
    TR_LinkHead0<IProfilerBuffer>   _freeBufferList;
    TR_LinkHead0<IProfilerBuffer>   _workingBufferList;
    IProfilerBuffer                *_workingBufferTail;
-   IProfilerBuffer                *_crtProfilingBuffer; // profiling buffer being processes by iprofiling thread
    TR::Monitor                    *_iprofilerMonitor;
    volatile int32_t                _numOutstandingBuffers;
    uint64_t                        _numRequests;
    uint64_t                        _numRequestsSkipped;
    uint64_t                        _numRequestsHandedToIProfilerThread;
-   volatile uint32_t               _iprofilerThreadExitFlag;
-   volatile bool                   _iprofilerThreadAttachAttempted;
+   volatile uint32_t               _iprofilerThreadExitFlag; // set when all parser threads have exited
    uint64_t                        _iprofilerNumRecords; // info stats only
+   // Stats for buffers handed to parser threads; updated with _iprofilerMonitor in hand
+   uint64_t                        _numBuffersParsed;
+   uint64_t                        _numBuffersDropped; // posted, but discarded by GC or shutdown before being parsed
+   // Bytecode entries allocated by a parser thread that lost the race to insert an entry for the same pc.
+   // They cannot be freed (see alignedPersistentAlloc) and stay counted in the memory footprint
+   volatile uintptr_t              _numEntriesAbandoned;
+   volatile uintptr_t              _bytesAbandoned;
+   uint64_t                        _totalQueueTime; // usec between posting and the start of parsing
+   uint64_t                        _maxQueueTime;
+   uint64_t                        _totalParseTime; // usec
 
    TR_IPMethodHashTableEntry       **_methodHashTable;
 
    uint32_t                        _iprofilerBufferSize;
    TR_ReadSampleRequestsHistory   *_readSampleRequestsHistory;
+   TR_IProfilerSnapshot           *_snapshot; // profiling data saved by a previous run; NULL if none
+   volatile uint32_t               _writingSnapshot; // set while a thread writes the snapshot file
 
 
    public:
@@ -0,0 +1,634 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/IProfilerSnapshot.hpp"
+
+#include <algorithm>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include "AtomicSupport.hpp"
+#include "j9.h"
+#include "j9protos.h"
+#include "rommeth.h"
+#include "vmaccess.h"
+#include "compile/Compilation.hpp"
+#include "control/CompilationRuntime.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/PersistentCollections.hpp"
+#include "env/PersistentInfo.hpp"
+#include "env/VMAccessCriticalSection.hpp"
+#include "env/VMJ9.h"
+#include "env/VerboseLog.hpp"
+#include "runtime/J9VMAccess.hpp"
+
+
+static inline uint64_t
+mixHash(uint64_t h, const uint8_t *data, size_t size)
+   {
+   // FNV-1a; good enough to tell methods apart and independent of where the data lives
+   for (size_t i = 0; i < size; ++i)
+      {
+      h ^= data[i];
+      h *= 0x100000001b3ULL;
+      }
+   return h;
+   }
+
+uint64_t
+TR_IProfilerSnapshot::methodHash(J9ROMClass *romClass, J9ROMMethod *romMethod)
+   {
+   J9UTF8 *className = J9ROMCLASS_CLASSNAME(romClass);
+   J9UTF8 *name = J9ROMMETHOD_NAME(romMethod);
+   J9UTF8 *signature = J9ROMMETHOD_SIGNATURE(romMethod);
+   uint32_t bytecodeSize = (uint32_t)J9_BYTECODE_SIZE_FROM_ROM_METHOD(romMethod);
+
+   uint64_t h = 0xcbf29ce484222325ULL;
+   h = mixHash(h, J9UTF8_DATA(className), J9UTF8_LENGTH(className));
+   h = mixHash(h, (const uint8_t *)".", 1);
+   h = mixHash(h, J9UTF8_DATA(name), J9UTF8_LENGTH(name));
+   h = mixHash(h, J9UTF8_DATA(signature), J9UTF8_LENGTH(signature));
+   h = mixHash(h, (const uint8_t *)&bytecodeSize, sizeof(bytecodeSize));
+   h = mixHash(h, J9_BYTECODE_START_FROM_ROM_METHOD(romMethod), bytecodeSize);
+   return h;
+   }
+
+
+// Check that count records of recordSize bytes starting at offset are within the file.
+// The file is untrusted, so nothing is added before it is known not to overflow.
+bool
+TR_IProfilerSnapshot::fitsInFile(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t fileSize)
+   {
+   return (offset >= sizeof(Header)) && (offset <= fileSize) &&
+          (count <= (fileSize - offset) / recordSize);
+   }
+
+TR_IProfilerSnapshot::TR_IProfilerSnapshot(J9PortLibrary *portLib, const uint8_t *data, J9MmapHandle *mmapHandle, intptr_t fd) :
+   _portLib(portLib), _data(data), _mmapHandle(mmapHandle), _fd(fd), _methodLoaded(NULL),
+   _numMethodsLoaded(0), _numEntriesLoaded(0), _numClassesNotFound(0)
+   {
+   memset((void *)_checkedMethods, 0, sizeof(_checkedMethods));
+   }
+
+TR_IProfilerSnapshot *
+TR_IProfilerSnapshot::load(J9PortLibrary *portLib, const char *fileName)
+   {
+   PORT_ACCESS_FROM_PORT(portLib);
+   intptr_t fd = j9file_open((char *)fileName, EsOpenRead, 0);
+   if (fd == -1)
+      return NULL;
+
+   int64_t length = j9file_flength(fd);
+   if (length < (int64_t)sizeof(Header) || (uint64_t)length > (uint64_t)UINTPTR_MAX)
+      {
+      j9file_close(fd);
+      return NULL;
+      }
+
+   const uint8_t *data = NULL;
+   J9MmapHandle *mmapHandle = NULL;
+   if (j9mmap_capabilities() & J9PORT_MMAP_CAPABILITY_READ)
+      {
+      mmapHandle = (J9MmapHandle *)j9mmap_map_file(fd, 0, (uintptr_t)length, fileName, J9PORT_MMAP_FLAG_READ, J9MEM_CATEGORY_JIT);
+      if (mmapHandle && mmapHandle->pointer)
+         data = (const uint8_t *)mmapHandle->pointer;
+      }
+   if (!data)
+      {
+      uint8_t *buffer = (uint8_t *)j9mem_allocate_memory((uintptr_t)length, J9MEM_CATEGORY_JIT);
+      int64_t bytesRead = 0;
+      while (buffer && bytesRead < length)
+         {
+         intptr_t rc = j9file_read(fd, buffer + bytesRead, (intptr_t)std::min(length - bytesRead, (int64_t)(1 << 20)));
+         if (rc <= 0)
+            break;
+         bytesRead += rc;
+         }
+      j9file_close(fd);
+      fd = -1;
+      if (!buffer || bytesRead != length)
+         {
+         if (buffer)
+            j9mem_free_memory(buffer);
+         return NULL;
+         }
+      data = buffer;
+      }
+
+   // Validate the layout; individual records are checked when they are used
+   const Header *h = (const Header *)data;
+   bool isValid = (h->_magic == MAGIC) && (h->_version == VERSION) && (h->_headerSize == sizeof(Header)) &&
+                  (h->_fileSize == (uint64_t)length) &&
+                  (h->_methodsOffset % sizeof(uint64_t) == 0) &&
+                  fitsInFile(h->_methodsOffset, h->_numMethods, sizeof(MethodRecord), h->_fileSize) &&
+                  (h->_entriesOffset % sizeof(uint64_t) == 0) &&
+                  fitsInFile(h->_entriesOffset, h->_numEntries, sizeof(EntryRecord), h->_fileSize) &&
+                  (h->_classNamesOffset % sizeof(uint32_t) == 0) &&
+                  fitsInFile(h->_classNamesOffset, h->_numClassNames, sizeof(uint32_t), h->_fileSize);
+
+   TR_IProfilerSnapshot *snapshot = NULL;
+   if (isValid)
+      {
+      snapshot = new (PERSISTENT_NEW) TR_IProfilerSnapshot(portLib, data, mmapHandle, fd);
+      if (snapshot)
+         {
+         size_t loadedSize = std::max(h->_numMethods, 1U) * sizeof(uint32_t);
+         snapshot->_methodLoaded = (volatile uint32_t *)TR_Memory::jitPersistentAlloc(loadedSize, TR_Memory::IProfiler);
+         if (snapshot->_methodLoaded)
+            {
+            memset((void *)snapshot->_methodLoaded, 0, loadedSize);
+            }
+         else
+            {
+            TR_Memory::jitPersistentFree(snapshot);
+            snapshot = NULL;
+            }
+         }
+      }
+
+   if (!snapshot)
+      {
+      if (mmapHandle)
+         j9mmap_unmap_file(mmapHandle);
+      else
+         j9mem_free_memory((void *)data);
+      if (fd != -1)
+         j9file_close(fd);
+      return NULL;
+      }
+
+   if (TR::Options::getVerboseOption(TR_VerbosePerformance))
+      TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Loaded IProfiler snapshot %s: %u methods, %u entries, %u classes",
+                                     fileName, h->_numMethods, h->_numEntries, h->_numClassNames);
+   return snapshot;
+   }
+
+int32_t
+TR_IProfilerSnapshot::findMethod(uint64_t hash) const
+   {
+   const MethodRecord *methods = (const MethodRecord *)(_data + header()->_methodsOffset);
+   int32_t low = 0;
+   int32_t high = (int32_t)header()->_numMethods - 1;
+   while (low <= high)
+      {
+      int32_t mid = low + (high - low) / 2;
+      if (methods[mid]._hash < hash)
+         low = mid + 1;
+      else if (methods[mid]._hash > hash)
+         high = mid - 1;
+      else
+         {
+         // Records with the same hash are merged by loadMethod; return the first one
+         while (mid > 0 && methods[mid - 1]._hash == hash)
+            mid--;
+         return mid;
+         }
+      }
+   return -1;
+   }
+
+const TR_IProfilerSnapshot::ClassName *
+TR_IProfilerSnapshot::getClassName(uint32_t index) const
+   {
+   const Header *h = header();
+   if (index >= h->_numClassNames)
+      return NULL;
+   uint32_t offset = ((const uint32_t *)(_data + h->_classNamesOffset))[index];
+   // load() checked that _classNamesOffset <= _fileSize
+   uint64_t available = h->_fileSize - h->_classNamesOffset;
+   if ((offset % sizeof(uint16_t) != 0) || (available < sizeof(uint16_t)) || (offset > available - sizeof(uint16_t)))
+      return NULL;
+   const ClassName *name = (const ClassName *)(_data + h->_classNamesOffset + offset);
+   if (name->_length > available - sizeof(uint16_t) - offset)
+      return NULL;
+   return name;
+   }
+
+J9Class *
+TR_IProfilerSnapshot::resolveClass(uint32_t nameIndex, J9Method *method, TR::Compilation *comp)
+   {
+   if (nameIndex == 0)
+      return NULL;
+   const ClassName *name = getClassName(nameIndex - 1);
+   if (!name)
+      return NULL;
+
+   TR_J9VMBase *fej9 = comp->fej9();
+   J9Class *clazz = NULL;
+      {
+      TR::VMAccessCriticalSection getClassFromUTF8(fej9);
+      clazz = jitGetClassFromUTF8(fej9->vmThread(), J9_CP_FROM_METHOD(method), (void *)name->_data, name->_length);
+      }
+   // As for profiles loaded from the shared class cache, only initialized classes may appear
+   // in profiling data, because the optimizer assumes receivers it sees there are initialized
+   if (!clazz || !fej9->isClassInitialized((TR_OpaqueClassBlock *)clazz))
+      {
+      _numClassesNotFound++;
+      return NULL;
+      }
+   return clazz;
+   }
+
+bool
+TR_IProfilerSnapshot::loadMethod(TR_IProfiler *iProfiler, J9Method *method, TR::Compilation *comp)
+   {
+   uint32_t slot = (uint32_t)(((uintptr_t)method >> 3) % CHECKED_METHODS_CACHE_SIZE);
+   if (_checkedMethods[slot] == method)
+      return false;
+   _checkedMethods[slot] = method;
+
+   J9ROMMethod *romMethod = getOriginalROMMethod(method);
+   uint64_t hash = methodHash(J9_CLASS_FROM_METHOD(method)->romClass, romMethod);
+   int32_t index = findMethod(hash);
+   if (index < 0)
+      return false;
+   // Only one thread loads the profile of a method
+   if (VM_AtomicSupport::lockCompareExchangeU32(&_methodLoaded[index], 0, 1) != 0)
+      return false;
+
+   const Header *h = header();
+   uintptr_t bytecodeStart = (uintptr_t)J9_BYTECODE_START_FROM_ROM_METHOD(romMethod);
+   uint32_t bytecodeSize = (uint32_t)J9_BYTECODE_SIZE_FROM_ROM_METHOD(romMethod);
+   uint32_t numLoaded = 0;
+   // write() saves one record per method hash, but the file is not trusted to. Records with the same
+   // hash are merged: entries of later records only fill bytecodes that have no data yet.
+   bool outOfMemory = false;
+   const MethodRecord *records = (const MethodRecord *)(_data + h->_methodsOffset);
+   for (uint32_t r = (uint32_t)index; (r < h->_numMethods) && (records[r]._hash == hash) && !outOfMemory; r++)
+      {
+      const MethodRecord *record = records + r;
+      if ((uint64_t)record->_firstEntry + record->_numEntries > h->_numEntries)
+         continue;
+      const EntryRecord *entries = (const EntryRecord *)(_data + h->_entriesOffset) + record->_firstEntry;
+      for (uint32_t i = 0; i < record->_numEntries; i++)
+         {
+         const EntryRecord &e = entries[i];
+         if (e._bcIndex >= bytecodeSize)
+            continue;
+         uintptr_t pc = bytecodeStart + e._bcIndex;
+         U_8 byteCode = *(U_8 *)pc;
+         uint32_t expectedType = iProfiler->isCompact(byteCode) ? TR_IPBCD_FOUR_BYTES :
+                                 iProfiler->isSwitch(byteCode) ? TR_IPBCD_EIGHT_WORDS : TR_IPBCD_CALL_GRAPH;
+         if (e._type != expectedType)
+            continue;
+
+         TR_IPBytecodeHashTableEntry *entry = iProfiler->findOrCreateEntry(TR_IProfiler::bcHash(pc), pc, true);
+         if (!entry)
+            {
+            outOfMemory = true;
+            break;
+            }
+         switch (e._type)
+            {
+            case TR_IPBCD_FOUR_BYTES:
+               {
+               TR_IPBCDataFourBytes *branchEntry = entry->asIPBCDataFourBytes();
+               if (!branchEntry || branchEntry->getData() != 0)
+                  continue; // the current run has its own data
+               branchEntry->setData(e._branchData);
+               }
+               break;
+            case TR_IPBCD_EIGHT_WORDS:
+               {
+               TR_IPBCDataEightWords *switchEntry = entry->asIPBCDataEightWords();
+               if (!switchEntry)
+                  continue;
+               uint64_t *data = switchEntry->getDataPointer();
+               bool hasData = false;
+               for (int32_t j = 0; j < SWITCH_DATA_COUNT; j++)
+                  hasData |= (data[j] != 0);
+               if (hasData)
+                  continue;
+               for (int32_t j = 0; j < SWITCH_DATA_COUNT; j++)
+                  data[j] = e._switchData[j];
+               }
+               break;
+            case TR_IPBCD_CALL_GRAPH:
+               {
+               TR_IPBCDataCallGraph *cgEntry = entry->asIPBCDataCallGraph();
+               if (!cgEntry || cgEntry->getSumCount(comp) != 0)
+                  continue;
+               if (!cgEntry->lockEntry())
+                  continue;
+               CallSiteProfileInfo *csInfo = cgEntry->getCGData();
+               // Reset in reverse order, like TR_IPBCDataCallGraph::setData
+               for (int32_t j = NUM_CS_SLOTS - 1; j >= 0; j--)
+                  {
+                  J9Class *clazz = resolveClass(e._callGraph._classNames[j], method, comp);
+                  csInfo->setClazz(j, (uintptr_t)clazz);
+                  csInfo->_weight[j] = clazz ? e._callGraph._weights[j] : 0;
+                  }
+               csInfo->_residueWeight = e._callGraph._residueWeight;
+               csInfo->_tooBigToBeInlined = e._callGraph._tooBigToBeInlined;
+               cgEntry->releaseEntry();
+               }
+               break;
+            }
+         numLoaded++;
+         }
+      }
+
+   // Statistics only; races between compilation threads are tolerated
+   _numMethodsLoaded++;
+   _numEntriesLoaded += numLoaded;
+   if (numLoaded > 0 && TR::Options::getCmdLineOptions()->getOption(TR_VerboseInterpreterProfiling))
+      {
+      J9UTF8 *className = J9ROMCLASS_CLASSNAME(J9_CLASS_FROM_METHOD(method)->romClass);
+      J9UTF8 *name = J9ROMMETHOD_NAME(romMethod);
+      J9UTF8 *signature = J9ROMMETHOD_SIGNATURE(romMethod);
+      TR_VerboseLog::writeLineLocked(TR_Vlog_IPROFILER, "Loaded %u entries from the IProfiler snapshot for %.*s.%.*s%.*s",
+                                     numLoaded,
+                                     J9UTF8_LENGTH(className), J9UTF8_DATA(className),
+                                     J9UTF8_LENGTH(name), J9UTF8_DATA(name),
+                                     J9UTF8_LENGTH(signature), J9UTF8_DATA(signature));
+      }
+   return numLoaded > 0;
+   }
+
+void
+TR_IProfilerSnapshot::printStats()
+   {
+   fprintf(stderr, "IProfiler: Snapshot methods=%u entries=%u\n", header()->_numMethods, header()->_numEntries);
+   fprintf(stderr, "IProfiler: Snapshot methods loaded=%u entries loaded=%u receiver classes not found=%u\n",
+           _numMethodsLoaded, _numEntriesLoaded, _numClassesNotFound);
+   }
+
+
+namespace
+{
+struct PendingEntry
+   {
+   uint64_t _hash;
+   J9ROMMethod *_romMethod;
+   uint32_t _bcIndex;
+   uint32_t _recordIndex; // index in the vector of records
+   };
+}
+
+bool
+TR_IProfilerSnapshot::write(TR_IProfiler *iProfiler, J9VMThread *vmThread, const char *fileName)
+   {
+   PORT_ACCESS_FROM_PORT(iProfiler->_portLib);
+   TR::PersistentAllocator &allocator = TR::Compiler->persistentAllocator();
+   TR::PersistentInfo *persistentInfo = iProfiler->_compInfo->getPersistentInfo();
+   J9InternalVMFunctions *vmFunctions = vmThread->javaVM->internalVMFunctions;
+
+   PersistentVector<EntryRecord> records(PersistentVector<EntryRecord>::allocator_type(allocator));
+   PersistentVector<PendingEntry> pending(PersistentVector<PendingEntry>::allocator_type(allocator));
+   PersistentVector<std::string> classNames(PersistentVector<std::string>::allocator_type(allocator));
+   PersistentUnorderedMap<std::string, uint32_t> classNameIndex(PersistentUnorderedMap<std::string, uint32_t>::allocator_type(allocator));
+   PersistentUnorderedMap<J9ROMMethod *, uint64_t> methodHashes(PersistentUnorderedMap<J9ROMMethod *, uint64_t>::allocator_type(allocator));
+
+   // Need VM access to block GC from unloading classes while a bucket is walked.
+   // Entries are copied out, so the file is written without VM access.
+   // When this function acquired VM access itself, it is released every few buckets
+   // (or as soon as exclusive access is requested) so that a large hash table does
+   // not hold off GC and class unloading for the whole walk.
+   bool haveAcquiredVMAccess = false;
+   if (!(vmThread->publicFlags & J9_PUBLIC_FLAGS_VM_ACCESS))
+      {
+      acquireVMAccessNoSuspend(vmThread);
+      haveAcquiredVMAccess = true;
+      }
+   try
+      {
+
+      J9ROMClass *romClass = NULL;
+      J9ROMMethod *romMethod = NULL;
+      for (int32_t bucket = 0; bucket < BC_HASH_TABLE_SIZE; bucket++)
+         {
+         for (TR_IPBytecodeHashTableEntry *entry = iProfiler->_bcHashTable[bucket]; entry; entry = entry->getNext())
+            {
+            if (entry->asIPBCDataAllocation() || entry->isInvalid() || iProfiler->invalidateEntryIfInconsistent(entry))
+               continue;
+
+            // Find the method this pc belongs to; consecutive entries are often in the same method
+            uintptr_t pc = entry->getPC();
+            if (!romMethod ||
+                pc < (uintptr_t)J9_BYTECODE_START_FROM_ROM_METHOD(romMethod) ||
+                pc >= (uintptr_t)J9_BYTECODE_END_FROM_ROM_METHOD(romMethod))
+               {
+               J9ClassLoader *loader;
+               romMethod = NULL;
+               romClass = vmFunctions->findROMClassFromPC(vmThread, pc, &loader);
+               if (!romClass)
+                  continue;
+               J9ROMMethod *currentMethod = J9ROMCLASS_ROMMETHODS(romClass);
+               for (uint32_t i = 0; i < romClass->romMethodCount; i++)
+                  {
+                  if (pc >= (uintptr_t)J9_BYTECODE_START_FROM_ROM_METHOD(currentMethod) &&
+                      pc < (uintptr_t)J9_BYTECODE_END_FROM_ROM_METHOD(currentMethod))
+                     {
+                     romMethod = currentMethod;
+                     break;
+                     }
+                  currentMethod = nextROMMethod(currentMethod);
+                  }
+               if (!romMethod)
+                  continue;
+               }
+
+            EntryRecord record;
+            memset(&record, 0, sizeof(record));
+            record._bcIndex = (uint32_t)(pc - (uintptr_t)J9_BYTECODE_START_FROM_ROM_METHOD(romMethod));
+            if (TR_IPBCDataFourBytes *branchEntry = entry->asIPBCDataFourBytes())
+               {
+               record._type = TR_IPBCD_FOUR_BYTES;
+               record._branchData = (uint32_t)branchEntry->getData();
+               if (!record._branchData)
+                  continue;
+               }
+            else if (TR_IPBCDataEightWords *switchEntry = entry->asIPBCDataEightWords())
+               {
+               record._type = TR_IPBCD_EIGHT_WORDS;
+               memcpy(record._switchData, switchEntry->getDataPointer(), sizeof(record._switchData));
+               }
+            else if (TR_IPBCDataCallGraph *cgEntry = entry->asIPBCDataCallGraph())
+               {
+               record._type = TR_IPBCD_CALL_GRAPH;
+               CallSiteProfileInfo *csInfo = cgEntry->getCGData();
+               for (int32_t i = 0; i < NUM_CS_SLOTS; i++)
+                  {
+                  J9Class *clazz = (J9Class *)csInfo->getClazz(i);
+                  if (!clazz || persistentInfo->isUnloadedClass(clazz, true))
+                     continue;
+                  J9UTF8 *className = J9ROMCLASS_CLASSNAME(clazz->romClass);
+                  std::string name((const char *)J9UTF8_DATA(className), J9UTF8_LENGTH(className));
+                  auto it = classNameIndex.find(name);
+                  if (it == classNameIndex.end())
+                     {
+                     it = classNameIndex.insert({ name, (uint32_t)classNames.size() }).first;
+                     classNames.push_back(name);
+                     }
+                  record._callGraph._classNames[i] = it->second + 1;
+                  record._callGraph._weights[i] = csInfo->_weight[i];
+                  }
+               record._callGraph._residueWeight = csInfo->_residueWeight;
+               record._callGraph._tooBigToBeInlined = csInfo->_tooBigToBeInlined;
+               }
+            else
+               {
+               continue;
+               }
+
+            auto hashIt = methodHashes.find(romMethod);
+            if (hashIt == methodHashes.end())
+               hashIt = methodHashes.insert({ romMethod, methodHash(romClass, romMethod) }).first;
+
+            PendingEntry p = { hashIt->second, romMethod, record._bcIndex, (uint32_t)records.size() };
+            pending.push_back(p);
+            records.push_back(record);
+            }
+
+         if (haveAcquiredVMAccess &&
+             (((bucket + 1) % BUCKETS_PER_VM_ACCESS) == 0 || (vmThread->publicFlags & J9_PUBLIC_FLAGS_HALT_THREAD_EXCLUSIVE)))
+            {
+            releaseVMAccessNoSuspend(vmThread);
+            acquireVMAccessNoSuspend(vmThread);
+            // Classes may have been unloaded and their ROM methods reused in the meantime.
+            // Recorded ROM method pointers are only compared for grouping, never dereferenced.
+            romClass = NULL;
+            romMethod = NULL;
+            methodHashes.clear();
+            }
+         }
+      }
+   catch (const std::bad_alloc &)
+      {
+      if (haveAcquiredVMAccess)
+         releaseVMAccessNoSuspend(vmThread);
+      return false;
+      }
+   if (haveAcquiredVMAccess)
+      releaseVMAccessNoSuspend(vmThread);
+
+   std::sort(pending.begin(), pending.end(), [](const PendingEntry &a, const PendingEntry &b)
+      {
+      if (a._hash != b._hash)
+         return a._hash < b._hash;
+      if (a._bcIndex != b._bcIndex)
+         return a._bcIndex < b._bcIndex;
+      return (uintptr_t)a._romMethod < (uintptr_t)b._romMethod;
+      });
+
+   // Identical methods have the same hash even if their ROM methods differ (e.g. a class loaded by
+   // several class loaders). The loader looks methods up by hash, so save one record per hash and
+   // one entry per bytecode of that method.
+   size_t numKept = 0;
+   for (size_t i = 0; i < pending.size(); i++)
+      {
+      if (numKept == 0 || pending[i]._hash != pending[numKept - 1]._hash || pending[i]._bcIndex != pending[numKept - 1]._bcIndex)
+         pending[numKept++] = pending[i];
+      }
+   pending.resize(numKept);
+
+   // Lay out the file: header, method records, entry records, class name table
+   uint32_t numMethods = 0;
+   for (size_t i = 0; i < pending.size(); i++)
+      {
+      if (i == 0 || pending[i]._hash != pending[i - 1]._hash)
+         numMethods++;
+      }
+   uint64_t methodsOffset = sizeof(Header);
+   uint64_t entriesOffset = methodsOffset + (uint64_t)numMethods * sizeof(MethodRecord);
+   uint64_t classNamesOffset = entriesOffset + (uint64_t)pending.size() * sizeof(EntryRecord);
+   uint64_t namesSize = (uint64_t)classNames.size() * sizeof(uint32_t);
+   for (size_t i = 0; i < classNames.size(); i++)
+      namesSize += (sizeof(uint16_t) + classNames[i].size() + 1) & ~(uint64_t)1; // keep names 2-byte aligned
+   uint64_t fileSize = classNamesOffset + namesSize;
+
+   uint8_t *buffer = (uint8_t *)j9mem_allocate_memory((uintptr_t)fileSize, J9MEM_CATEGORY_JIT);
+   if (!buffer)
+      return false;
+   memset(buffer, 0, (size_t)fileSize);
+
+   Header *h = (Header *)buffer;
+   h->_magic = MAGIC;
+   h->_version = VERSION;
+   h->_headerSize = sizeof(Header);
+   h->_numMethods = numMethods;
+   h->_numEntries = (uint32_t)pending.size();
+   h->_numClassNames = (uint32_t)classNames.size();
+   h->_methodsOffset = methodsOffset;
+   h->_entriesOffset = entriesOffset;
+   h->_classNamesOffset = classNamesOffset;
+   h->_fileSize = fileSize;
+
+   MethodRecord *methods = (MethodRecord *)(buffer + methodsOffset);
+   EntryRecord *entries = (EntryRecord *)(buffer + entriesOffset);
+   MethodRecord *crtMethod = NULL;
+   for (size_t i = 0; i < pending.size(); i++)
+      {
+      if (i == 0 || pending[i]._hash != pending[i - 1]._hash)
+         {
+         crtMethod = crtMethod ? crtMethod + 1 : methods;
+         crtMethod->_hash = pending[i]._hash;
+         crtMethod->_firstEntry = (uint32_t)i;
+         crtMethod->_numEntries = 0;
+         }
+      crtMethod->_numEntries++;
+      entries[i] = records[pending[i]._recordIndex];
+      }
+
+   uint32_t *nameOffsets = (uint32_t *)(buffer + classNamesOffset);
+   uint32_t nameOffset = (uint32_t)(classNames.size() * sizeof(uint32_t));
+   for (size_t i = 0; i < classNames.size(); i++)
+      {
+      nameOffsets[i] = nameOffset;
+      ClassName *name = (ClassName *)(buffer + classNamesOffset + nameOffset);
+      name->_length = (uint16_t)classNames[i].size();
+      memcpy(name->_data, classNames[i].data(), classNames[i].size());
+      nameOffset += (uint32_t)((sizeof(uint16_t) + classNames[i].size() + 1) & ~(size_t)1);
+      }
+
+   // Write to a temporary file and rename it, so that a concurrent reader
+   // (or a crash while writing) never sees a partial snapshot
+   std::string tmpFileName = std::string(fileName) + ".tmp";
+   bool success = false;
+   intptr_t fd = j9file_open((char *)tmpFileName.c_str(), EsOpenWrite | EsOpenCreate | EsOpenTruncate, 0644);
+   if (fd != -1)
+      {
+      success = (j9file_write(fd, buffer, (intptr_t)fileSize) == (intptr_t)fileSize);
+      j9file_close(fd);
+      if (success && j9file_move((char *)tmpFileName.c_str(), (char *)fileName) != 0)
+         {
+         // Some platforms cannot rename over an existing file
+         j9file_unlink((char *)fileName);
+         success = (j9file_move((char *)tmpFileName.c_str(), (char *)fileName) == 0);
+         }
+      if (!success)
+         j9file_unlink((char *)tmpFileName.c_str());
+      }
+   j9mem_free_memory(buffer);
+
+   if (TR::Options::getVerboseOption(TR_VerbosePerformance))
+      {
+      if (success)
+         TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Wrote IProfiler snapshot %s: %u methods, %u entries, %u classes",
+                                        fileName, numMethods, (uint32_t)pending.size(), (uint32_t)classNames.size());
+      else
+         TR_VerboseLog::writeLineLocked(TR_Vlog_PERF, "Failed to write IProfiler snapshot %s", fileName);
+      }
+   return success;
+   }
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef IPROFILER_SNAPSHOT_HPP
+#define IPROFILER_SNAPSHOT_HPP
+
+#include "j9.h"
+#include "env/TRMemory.hpp"
+#include "runtime/IProfiler.hpp"
+
+namespace TR { class Compilation; }
+
+/**
+   @class TR_IProfilerSnapshot
+   @brief Interpreter profiling data saved to a file by one run and loaded by the next
+
+   The snapshot file does not depend on the shared class cache. Methods are identified by
+   a hash of their class name, name, signature and bytecodes, so a saved profile is only
+   applied to identical code. Receiver classes in call graph data are recorded by name and
+   looked up in the class loader of the profiled method when its profile is loaded.
+
+   At startup the file is mapped (or read when mapping is not supported) and only its
+   header is validated. The profile of a method is copied into the IProfiler hash table
+   the first time a compilation asks for data of that method that the current run has not
+   collected yet; data collected by the current run always takes precedence.
+*/
+class TR_IProfilerSnapshot
+   {
+public:
+   TR_PERSISTENT_ALLOC(TR_Memory::IProfiler)
+
+   /**
+      @brief Open a snapshot file written by a previous run
+      @return NULL if the file does not exist or is not a valid snapshot for this JVM
+   */
+   static TR_IProfilerSnapshot *load(J9PortLibrary *portLib, const char *fileName);
+
+   /**
+      @brief Save the contents of the IProfiler bytecode hash table to fileName
+      @return false if the file could not be written
+   */
+   static bool write(TR_IProfiler *iProfiler, J9VMThread *vmThread, const char *fileName);
+
+   /**
+      @brief Copy the saved profile of a method into the IProfiler hash table
+      @return true if entries were added; false if the method has no saved profile
+              or its profile was already loaded
+   */
+   bool loadMethod(TR_IProfiler *iProfiler, J9Method *method, TR::Compilation *comp);
+
+   void printStats();
+
+private:
+   static const uint32_t MAGIC = 0x4e535049; // "IPSN" when written on a little endian machine
+   static const uint32_t VERSION = 1;
+   static const int32_t CHECKED_METHODS_CACHE_SIZE = 1024;
+   static const int32_t BUCKETS_PER_VM_ACCESS = 64; // buckets walked by write() before yielding VM access
+
+   struct Header
+      {
+      uint32_t _magic;
+      uint32_t _version;
+      uint32_t _headerSize; // catches layout differences such as pointer size
+      uint32_t _numMethods;
+      uint32_t _numEntries;
+      uint32_t _numClassNames;
+      uint64_t _methodsOffset; // MethodRecord[_numMethods] sorted by hash, one per hash
+      uint64_t _entriesOffset; // EntryRecord[_numEntries] grouped by method
+      uint64_t _classNamesOffset; // uint32_t offset of each name from here, then the names
+      uint64_t _fileSize;
+      };
+
+   struct MethodRecord
+      {
+      uint64_t _hash;
+      uint32_t _firstEntry;
+      uint32_t _numEntries;
+      };
+
+   struct EntryRecord
+      {
+      uint32_t _bcIndex;
+      uint32_t _type; // TR_IPBCD_FOUR_BYTES, TR_IPBCD_EIGHT_WORDS or TR_IPBCD_CALL_GRAPH
+      union
+         {
+         uint32_t _branchData;
+         uint64_t _switchData[SWITCH_DATA_COUNT];
+         struct
+            {
+            uint32_t _classNames[NUM_CS_SLOTS]; // index in the class name table + 1; 0 means no class
+            uint16_t _weights[NUM_CS_SLOTS];
+            uint16_t _residueWeight;
+            uint16_t _tooBigToBeInlined;
+            } _callGraph;
+         };
+      };
+
+   // A class name is stored as a 16-bit length followed by the characters
+   struct ClassName
+      {
+      uint16_t _length;
+      char _data[1];
+      };
+
+   TR_IProfilerSnapshot(J9PortLibrary *portLib, const uint8_t *data, J9MmapHandle *mmapHandle, intptr_t fd);
+
+   static uint64_t methodHash(J9ROMClass *romClass, J9ROMMethod *romMethod);
+   static bool fitsInFile(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t fileSize);
+   const Header *header() const { return (const Header *)_data; }
+   int32_t findMethod(uint64_t hash) const;
+   const ClassName *getClassName(uint32_t index) const;
+   J9Class *resolveClass(uint32_t nameIndex, J9Method *method, TR::Compilation *comp);
+
+   J9PortLibrary *_portLib;
+   const uint8_t *_data;
+   J9MmapHandle *_mmapHandle; // NULL if the file was read into memory
+   intptr_t _fd;
+   volatile uint32_t *_methodLoaded; // one word per method record; set once its profile is loaded
+   // Methods recently looked up; avoids hashing the bytecodes of a method again and again
+   J9Method * volatile _checkedMethods[CHECKED_METHODS_CACHE_SIZE];
+   // Statistics
+   uint32_t _numMethodsLoaded;
+   uint32_t _numEntriesLoaded;
+   uint32_t _numClassesNotFound;
+   };
+
+#endif /* IPROFILER_SNAPSHOT_HPP */
@@ -713,6 +713,67 @@ J9::CodeCache::resetCodeCache()
       self()->resetTrampolines();
    }
 
+int32_t
+J9::CodeCache::sizeClassOfFreeBlock(size_t size)
+   {
+   int32_t sizeClass = 0;
+   // Each class is four times larger than the previous one, starting at 256 bytes
+   for (size_t limit = 256; sizeClass < FreeSpaceStats::NUM_SIZE_CLASSES - 1 && size >= limit; limit <<= 2)
+      sizeClass++;
+   return sizeClass;
+   }
+
+void
+J9::CodeCache::collectFreeSpaceStats(FreeSpaceStats &stats)
+   {
+   CacheCriticalSection collectingStats(self());
+
+   stats._freeContiguousSpace += self()->getFreeContiguousSpace();
+   for (OMR::CodeCacheFreeCacheBlock *block = self()->freeBlockList(); block; block = block->_next)
+      {
+      int32_t sizeClass = sizeClassOfFreeBlock(block->_size);
+      stats._numBlocksInSizeClass[sizeClass]++;
+      stats._bytesInSizeClass[sizeClass] += block->_size;
+      stats._numFreeBlocks++;
+      stats._freeBlockBytes += block->_size;
+      if (block->_size > stats._largestFreeBlock)
+         stats._largestFreeBlock = block->_size;
+      }
+   }
+
+size_t
+J9::CodeCache::largestAllocatableBlock()
+   {
+   size_t largest = self()->getFreeContiguousSpace();
+   largest = std::max<size_t>(largest, _sizeOfLargestFreeWarmBlock);
+   largest = std::max<size_t>(largest, _sizeOfLargestFreeColdBlock);
+   return largest;
+   }
+
+void
+J9::CodeCache::unreserve()
+   {
+   if (_manager->hotCodeCache() == self())
+      {
+      TR::CodeCacheManager::CacheListCriticalSection parkHotCodeCache(_manager);
+      _reserved = true;
+      _reservingCompThreadID = PARKED_HOT_CODE_CACHE_ID;
+      }
+   else
+      {
+      self()->OMR::CodeCache::unreserve();
+      }
+   }
+
+bool
+J9::CodeCache::claimHotCodeCache(int32_t compThreadID)
+   {
+   if (_reservingCompThreadID != PARKED_HOT_CODE_CACHE_ID)
+      return false;
+   _reservingCompThreadID = compThreadID;
+   return true;
+   }
+
 
 extern "C"
    {
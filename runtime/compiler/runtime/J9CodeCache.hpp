@@ -31,6 +31,7 @@ namespace J9 { typedef CodeCache CodeCacheConnector; }
 #endif
 
 
+#include <string.h>
 #include "env/jittypes.h"
 #include "runtime/OMRCodeCache.hpp"
 #include "env/IO.hpp"
@@ -105,6 +106,68 @@ public:
    */
    void resetCodeCache();
 
+   /**
+    * @brief Free space of one or more code caches. Reclaimed blocks are counted
+    *        per size class so that a cache whose free space is scattered in
+    *        small blocks can be told apart from a cache that is really full.
+    */
+   struct FreeSpaceStats
+      {
+      static const int32_t NUM_SIZE_CLASSES = 5; // <256, <1K, <4K, <16K and >=16K bytes
+
+      FreeSpaceStats() { memset(this, 0, sizeof(*this)); }
+
+      /**
+       * @brief Percentage of the bytes in the free block lists that are not in
+       *        the largest free block; 0 when the free lists are empty
+       */
+      uint32_t fragmentation() const
+         {
+         return _freeBlockBytes ? (uint32_t)(100 - (_largestFreeBlock * 100) / _freeBlockBytes) : 0;
+         }
+
+      size_t   _freeContiguousSpace; // between warmCodeAlloc and coldCodeAlloc
+      size_t   _freeBlockBytes;      // in the free block lists
+      size_t   _largestFreeBlock;
+      uint32_t _numFreeBlocks;
+      uint32_t _numBlocksInSizeClass[NUM_SIZE_CLASSES];
+      size_t   _bytesInSizeClass[NUM_SIZE_CLASSES];
+      };
+
+   static int32_t sizeClassOfFreeBlock(size_t size);
+
+   /**
+    * @brief Walk the free block list under the cache mutex and add its blocks to stats
+    */
+   void collectFreeSpaceStats(FreeSpaceStats &stats);
+
+   /**
+    * @brief Size of the largest block that can be allocated from this cache
+    *        without walking the free block list. Read without the cache mutex,
+    *        so the answer is only a hint.
+    */
+   size_t largestAllocatableBlock();
+
+   /**
+    * @brief Release the reservation held by a compilation. The hot code cache
+    *        is parked instead: it stays reserved so that regular compilations
+    *        never pick it, and the next hot compilation can claim it.
+    */
+   void unreserve();
+
+   /**
+    * @brief Claim the parked hot code cache for a compilation thread.
+    *        Caller must hold codeCacheList.mutex.
+    *
+    * @return false if another compilation is using the hot code cache
+    */
+   bool claimHotCodeCache(int32_t compThreadID);
+
+   /**
+    * @brief Reservation ID of the hot code cache while no compilation uses it
+    */
+   static const int32_t PARKED_HOT_CODE_CACHE_ID = -3;
+
    private:
    /**
     * @brief Restore trampoline pointers to their initial positions
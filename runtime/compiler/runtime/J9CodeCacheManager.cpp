@@ -23,6 +23,9 @@
 #include <algorithm>
 #include <stdlib.h>
 #include <string.h>
+#if defined(LINUX)
+#include <sys/mman.h>
+#endif
 #include "j9.h"
 #include "j9protos.h"
 #include "j9thread.h"
@@ -44,6 +47,8 @@
 #include "runtime/ArtifactManager.hpp"
 #include "env/IO.hpp"
 #include "env/VerboseLog.hpp"
+#include "omrformatconsts.h"
+#include "AtomicSupport.hpp"
 
 TR::CodeCacheManager *J9::CodeCacheManager::_codeCacheManager = NULL;
 J9JavaVM *J9::CodeCacheManager::_javaVM = NULL;
@@ -156,7 +161,10 @@ void
 J9::CodeCacheManager::setCodeCacheFull()
    {
    self()->OMR::CodeCacheManager::setCodeCacheFull();
+   bool wasFull = (_jitConfig->runtimeFlags & J9JIT_CODE_CACHE_FULL) != 0;
    _jitConfig->runtimeFlags |= J9JIT_CODE_CACHE_FULL;
+   if (!wasFull && self()->codeCacheConfig().verboseCodeCache())
+      self()->reportFreeSpaceStats("code cache full");
    }
 
 
@@ -224,7 +232,10 @@ J9::CodeCacheManager::reserveCodeCache(bool compilationCodeAllocationsMustBeCont
    if (codeCache == NULL)
       {
       J9JITConfig *jitConfig = self()->fej9()->getJ9JITConfig();
+      bool wasFull = (jitConfig->runtimeFlags & J9JIT_CODE_CACHE_FULL) != 0;
       jitConfig->runtimeFlags |= J9JIT_CODE_CACHE_FULL;
+      if (!wasFull && self()->codeCacheConfig().verboseCodeCache())
+         self()->reportFreeSpaceStats("no code cache could be reserved");
       }
    return codeCache;
    }
@@ -723,3 +734,117 @@ J9::CodeCacheManager::printOccupancyStats()
       codeCache->printOccupancyStats();
       }
    }
+
+
+bool
+J9::CodeCacheManager::canAllocateCodeBlock(size_t size)
+   {
+   if (self()->canAddNewCodeCache())
+      return true;
+
+   // Only hot compilations can use the hot code cache, so its free space
+   // does not let the regular compilations resume
+   CacheListCriticalSection scanCacheList(self());
+   for (TR::CodeCache *codeCache = self()->getFirstCodeCache(); codeCache; codeCache = codeCache->next())
+      {
+      if (codeCache != _hotCodeCache && codeCache->largestAllocatableBlock() >= size)
+         return true;
+      }
+   return false;
+   }
+
+
+void
+J9::CodeCacheManager::reportFreeSpaceStats(const char *reason)
+   {
+   TR::CodeCache::FreeSpaceStats stats;
+   int32_t numCaches = 0;
+      {
+      CacheListCriticalSection scanCacheList(self());
+      for (TR::CodeCache *codeCache = self()->getFirstCodeCache(); codeCache; codeCache = codeCache->next())
+         {
+         codeCache->collectFreeSpaceStats(stats);
+         numCaches++;
+         }
+      }
+
+   TR_VerboseLog::vlogAcquire();
+   TR_VerboseLog::writeLine(TR_Vlog_CODECACHE,
+      "Free space (%s): %d caches, contiguous=%" OMR_PRIuSIZE " bytes, free blocks=%u totaling %" OMR_PRIuSIZE " bytes, largest=%" OMR_PRIuSIZE " bytes, fragmentation=%u%%",
+      reason, numCaches, stats._freeContiguousSpace, stats._numFreeBlocks, stats._freeBlockBytes, stats._largestFreeBlock, stats.fragmentation());
+   TR_VerboseLog::writeLine(TR_Vlog_CODECACHE,
+      "Free blocks by size: <256B %u (%" OMR_PRIuSIZE " bytes), <1KB %u (%" OMR_PRIuSIZE " bytes), <4KB %u (%" OMR_PRIuSIZE " bytes), <16KB %u (%" OMR_PRIuSIZE " bytes), >=16KB %u (%" OMR_PRIuSIZE " bytes)",
+      stats._numBlocksInSizeClass[0], stats._bytesInSizeClass[0],
+      stats._numBlocksInSizeClass[1], stats._bytesInSizeClass[1],
+      stats._numBlocksInSizeClass[2], stats._bytesInSizeClass[2],
+      stats._numBlocksInSizeClass[3], stats._bytesInSizeClass[3],
+      stats._numBlocksInSizeClass[4], stats._bytesInSizeClass[4]);
+   TR_VerboseLog::vlogRelease();
+   }
+
+
+TR::CodeCache *
+J9::CodeCacheManager::reserveHotCodeCache(int32_t compThreadID)
+   {
+   if (TR::Options::_hotCodeCacheKB == 0)
+      return NULL;
+
+   TR::CodeCache *hotCodeCache = _hotCodeCache;
+   if (!hotCodeCache)
+      {
+      // The first hot compilation allocates the hot code cache; hot compilations
+      // that come meanwhile, or after the allocation failed, use regular caches
+      if (_hotCodeCacheAllocationStarted ||
+          VM_AtomicSupport::lockCompareExchangeU32(&_hotCodeCacheAllocationStarted, 0, 1) != 0)
+         return NULL;
+      if (!self()->canAddNewCodeCache())
+         return NULL;
+
+      TR::CodeCacheConfig &config = self()->codeCacheConfig();
+      size_t hotCodeCacheSize = (TR::Options::_hotCodeCacheKB > 0 ? TR::Options::_hotCodeCacheKB : config.codeCacheKB()) * 1024;
+
+#if defined(LINUX) && defined(MADV_HUGEPAGE)
+      // Transparent huge pages are wanted unless the code cache repository
+      // already uses large pages (-Xlp:codecache)
+      const uintptr_t hugePageSize = 2 * 1024 * 1024;
+      bool wantHugePages = config.largeCodePageSize() == 0;
+      if (wantHugePages)
+         {
+         // The cache can start anywhere within a huge page, so round its size up
+         // and add one more huge page; the 2 MB-aligned part of the segment is
+         // then at least as large as the requested size
+         hotCodeCacheSize = OMR::align(hotCodeCacheSize, hugePageSize) + hugePageSize;
+         }
+#endif
+
+      hotCodeCache = TR::CodeCache::allocate(self(), hotCodeCacheSize, compThreadID);
+      if (!hotCodeCache)
+         return NULL;
+
+#if defined(LINUX) && defined(MADV_HUGEPAGE)
+      if (wantHugePages)
+         {
+         TR::CodeCacheMemorySegment *segment = hotCodeCache->trj9segment();
+         uintptr_t start = OMR::align((uintptr_t)segment->segmentBase(), hugePageSize);
+         uintptr_t end = (uintptr_t)segment->segmentTop() & ~(hugePageSize - 1);
+         if (start < end)
+            madvise((void *)start, end - start, MADV_HUGEPAGE);
+         }
+#endif
+
+      if (config.verboseCodeCache())
+         TR_VerboseLog::writeLineLocked(TR_Vlog_CODECACHE, "Allocated hot code cache %p between addresses %p and %p",
+            hotCodeCache, hotCodeCache->getCodeBase(), hotCodeCache->getCodeTop());
+
+      // The new cache is reserved by this compilation thread; publishing it
+      // makes unreserve() park it for the next hot compilation
+      VM_AtomicSupport::writeBarrier();
+      _hotCodeCache = hotCodeCache;
+      return hotCodeCache;
+      }
+
+   CacheListCriticalSection reservingHotCodeCache(self());
+   if (hotCodeCache->largestAllocatableBlock() < (size_t)TR::Options::_minFreeCodeCacheBlockToResumeCompilations)
+      return NULL;
+   return hotCodeCache->claimHotCodeCache(compThreadID) ? hotCodeCache : NULL;
+   }
@@ -53,7 +53,9 @@ class OMR_EXTENSIBLE CodeCacheManager : public OMR::CodeCacheManagerConnector
 public:
    CodeCacheManager(TR_FrontEnd *fe, TR::RawAllocator rawAllocator) :
       OMR::CodeCacheManagerConnector(rawAllocator),
-      _fe(fe)
+      _fe(fe),
+      _hotCodeCache(NULL),
+      _hotCodeCacheAllocationStarted(0)
       {
       _codeCacheManager = reinterpret_cast<TR::CodeCacheManager *>(this);
       }
@@ -151,8 +153,42 @@ public:
     */
    void printOccupancyStats();
 
+   /**
+    * @brief Answers whether a block of the given size can still be allocated,
+    *        either in an existing code cache (from its free contiguous space or
+    *        from a reclaimed block) or by adding a new code cache. The hot code
+    *        cache is not considered since regular compilations cannot use it.
+    *        Acquires codeCacheList.mutex.
+    */
+   bool canAllocateCodeBlock(size_t size);
+
+   /**
+    * @brief Write the free space and fragmentation of all code caches to the
+    *        verbose log
+    *
+    * @param[in] reason : the event that triggered the report
+    */
+   void reportFreeSpaceStats(const char *reason);
+
+   /**
+    * @brief Reserve the code cache dedicated to hot and scorching method bodies,
+    *        allocating it on first use. Keeping these bodies together lets the
+    *        hottest code of the application share a few pages and iTLB entries
+    *        instead of being scattered among cold bodies in compile order.
+    *
+    * @param[in] compThreadID : ID of the compilation thread reserving the cache
+    *
+    * @return NULL if the hot code cache is disabled, full, or in use by another
+    *         compilation; the caller then reserves a regular code cache
+    */
+   TR::CodeCache *reserveHotCodeCache(int32_t compThreadID);
+
+   TR::CodeCache *hotCodeCache() { return _hotCodeCache; }
+
 private :
    TR_FrontEnd *_fe;
+   TR::CodeCache * volatile _hotCodeCache;
+   volatile uint32_t _hotCodeCacheAllocationStarted;
    static TR::CodeCacheManager *_codeCacheManager;
    static J9JITConfig *_jitConfig;
    static J9JavaVM *_javaVM;
@@ -274,6 +274,8 @@ typedef struct TR_AOTStats
    TR_FailedPerfAssumptionCode failedPerfAssumptionCode;
 
    uint32_t numRelocationsFailedByType[TR_NumExternalRelocationKinds];
+   uint32_t numRelocationsByType[TR_NumExternalRelocationKinds];
+   uint64_t relocationTimeByType[TR_NumExternalRelocationKinds]; // microseconds
 
    } TR_AOTStats;
 
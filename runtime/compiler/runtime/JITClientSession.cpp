@@ -22,6 +22,8 @@
 
 #include "runtime/JITClientSession.hpp"
 
+#include "AtomicSupport.hpp"
+
 #include "control/CompilationRuntime.hpp" // for CompilationInfo
 #include "control/MethodToBeCompiled.hpp" // for TR_MethodToBeCompiled
 #include "control/JITServerHelpers.hpp"
@@ -41,6 +43,9 @@ ClientSessionData::ClientSessionData(uint64_t clientUID, uint32_t seqNo) :
    _classBySignatureMap(decltype(_classBySignatureMap)::allocator_type(TR::Compiler->persistentAllocator())),
    _classChainDataMap(decltype(_classChainDataMap)::allocator_type(TR::Compiler->persistentAllocator())),
    _constantPoolToClassMap(decltype(_constantPoolToClassMap)::allocator_type(TR::Compiler->persistentAllocator())),
+   _J9MethodMapRWMutex("JITServer J9Method map RWMutex"),
+   _classMapRWMutex("JITServer class map RWMutex"),
+   _constantPoolMapRWMutex("JITServer constant pool map RWMutex"),
    _unloadedClassAddresses(NULL),
    _requestUnloadedClasses(true),
    _staticFinalDataMap(decltype(_staticFinalDataMap)::allocator_type(TR::Compiler->persistentAllocator())),
@@ -48,17 +53,24 @@ ClientSessionData::ClientSessionData(uint64_t clientUID, uint32_t seqNo) :
    _registeredJ2IThunksMap(decltype(_registeredJ2IThunksMap)::allocator_type(TR::Compiler->persistentAllocator())),
    _registeredInvokeExactJ2IThunksSet(decltype(_registeredInvokeExactJ2IThunksSet)::allocator_type(TR::Compiler->persistentAllocator())),
    _wellKnownClasses(),
-   _isInStartupPhase(false)
+   _isInStartupPhase(false),
+   _numROMClassHashLookups(0),
+   _numROMClassHashHits(0),
+   _numROMClassRequestsWithoutHash(0),
+   _numCompilationRequests(0),
+   _numPrefetchedClasses(0),
+   _numPrefetchedClassesUsed(0),
+   _numQueuedRequests(0),
+   _totalQueueWaitMs(0),
+   _maxQueueWaitMs(0)
    {
    updateTimeOfLastAccess();
    _javaLangClassPtr = NULL;
    _inUse = 1;
    _numActiveThreads = 0;
    _romMapMonitor = TR::Monitor::create("JIT-JITServerROMMapMonitor");
-   _classMapMonitor = TR::Monitor::create("JIT-JITServerClassMapMonitor");
    _classChainDataMapMonitor = TR::Monitor::create("JIT-JITServerClassChainDataMapMonitor");
    _sequencingMonitor = TR::Monitor::create("JIT-JITServerSequencingMonitor");
-   _constantPoolMapMonitor = TR::Monitor::create("JIT-JITServerConstantPoolMonitor");
    _vmInfo = NULL;
    _staticMapMonitor = TR::Monitor::create("JIT-JITServerStaticMapMonitor");
    _markedForDeletion = false;
@@ -74,16 +86,21 @@ ClientSessionData::ClientSessionData(uint64_t clientUID, uint32_t seqNo) :
    TR::SymbolValidationManager::populateSystemClassesNotWorthRemembering(this);
 
    _wellKnownClassesMonitor = TR::Monitor::create("JIT-JITServerWellKnownClassesMonitor");
+
+   _romMapMonitor->enableContentionStats();
+   _classChainDataMapMonitor->enableContentionStats();
+   _sequencingMonitor->enableContentionStats();
+   _staticMapMonitor->enableContentionStats();
+   _thunkSetMonitor->enableContentionStats();
+   _wellKnownClassesMonitor->enableContentionStats();
    }
 
 ClientSessionData::~ClientSessionData()
    {
    clearCaches();
    _romMapMonitor->destroy();
-   _classMapMonitor->destroy();
    _classChainDataMapMonitor->destroy();
    _sequencingMonitor->destroy();
-   _constantPoolMapMonitor->destroy();
    _staticMapMonitor->destroy();
    if (_vmInfo)
       {
@@ -193,6 +210,7 @@ ClientSessionData::processUnloadedClasses(const std::vector<TR_OpaqueClassBlock*
 
          J9Method *methods = it->second._methodsOfClass;
          // delete all the cached J9Methods belonging to this unloaded class
+         JITServerRWMutex::WriteCriticalSection eraseJ9Methods(getJ9MethodMapRWMutex());
          for (size_t i = 0; i < romClass->romMethodCount; i++)
             {
             J9Method *j9method = methods + i;
@@ -230,13 +248,13 @@ ClientSessionData::processUnloadedClasses(const std::vector<TR_OpaqueClassBlock*
 
    // purge Class by name cache
    {
-   OMR::CriticalSection classMapCS(getClassMapMonitor());
+   JITServerRWMutex::WriteCriticalSection classMapCS(getClassMapRWMutex());
    purgeCache(&unloadedClasses, getClassBySignatureMap(), &ClassUnloadedData::_pair);
    }
 
    // purge Constant pool to class cache
    {
-   OMR::CriticalSection constantPoolToClassMap(getConstantPoolMonitor());
+   JITServerRWMutex::WriteCriticalSection constantPoolToClassMap(getConstantPoolMapRWMutex());
    purgeCache(&unloadedClasses, getConstantPoolToClassMap(), &ClassUnloadedData::_cp);
    }
 
@@ -355,6 +373,95 @@ ClientSessionData::printStats()
       total += it.second._romClass->romSize;
 
    j9tty_printf(PORTLIB, "\tTotal size of cached ROM classes + methods: %d bytes\n", total);
+   j9tty_printf(PORTLIB, "\tCompilation queue wait: requests: %llu avg: %.1f ms max: %llu ms\n",
+                (unsigned long long)_numQueuedRequests,
+                _numQueuedRequests ? _totalQueueWaitMs / (double)_numQueuedRequests : 0.0,
+                (unsigned long long)_maxQueueWaitMs);
+   j9tty_printf(PORTLIB, "\tPrefetched classes: %llu used: %llu (%.1f%%) round trips saved per compilation request: %.2f\n",
+                (unsigned long long)_numPrefetchedClasses, (unsigned long long)_numPrefetchedClassesUsed,
+                _numPrefetchedClasses ? 100.0 * _numPrefetchedClassesUsed / _numPrefetchedClasses : 0.0,
+                _numCompilationRequests ? (double)_numPrefetchedClassesUsed / _numCompilationRequests : 0.0);
+
+   j9tty_printf(PORTLIB, "\tLock contention:\n");
+   printMonitorStats(_romMapMonitor, "ROMMapMonitor");
+   printMonitorStats(_classChainDataMapMonitor, "ClassChainDataMapMonitor");
+   printMonitorStats(_sequencingMonitor, "SequencingMonitor");
+   printMonitorStats(_staticMapMonitor, "StaticMapMonitor");
+   printMonitorStats(_thunkSetMonitor, "ThunkSetMonitor");
+   printMonitorStats(_wellKnownClassesMonitor, "WellKnownClassesMonitor");
+   _J9MethodMapRWMutex.printStats("J9MethodMapRWMutex");
+   _classMapRWMutex.printStats("ClassMapRWMutex");
+   _constantPoolMapRWMutex.printStats("ConstantPoolMapRWMutex");
+   }
+
+void
+ClientSessionData::printMonitorStats(TR::Monitor *monitor, const char *name)
+   {
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   j9tty_printf(PORTLIB, "\t\t%s: enters: %llu contended: %llu wait time: %llu us\n", name,
+                (unsigned long long)monitor->getNumEnters(), (unsigned long long)monitor->getNumContendedEnters(),
+                (unsigned long long)(monitor->getContendedWaitTimeNs() / 1000));
+   }
+
+JITServerRWMutex::JITServerRWMutex(const char *name) :
+   _mutex(NULL),
+   _numContendedReads(0),
+   _contendedReadWaitTimeNs(0),
+   _numWrites(0),
+   _numContendedWrites(0),
+   _contendedWriteWaitTimeNs(0)
+   {
+   if (omrthread_rwmutex_init(&_mutex, 0, name))
+      {
+      TR_ASSERT_FATAL(false, "Failed to initialize %s", name);
+      }
+   }
+
+JITServerRWMutex::~JITServerRWMutex()
+   {
+   omrthread_rwmutex_destroy(_mutex);
+   _mutex = NULL;
+   }
+
+void
+JITServerRWMutex::enterRead()
+   {
+   // There is no try_enter_read; a writer holding the lock is what makes readers wait
+   if (!omrthread_rwmutex_is_writelocked(_mutex))
+      {
+      omrthread_rwmutex_enter_read(_mutex);
+      return;
+      }
+
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   uint64_t startTime = j9time_nano_time();
+   omrthread_rwmutex_enter_read(_mutex);
+   VM_AtomicSupport::add(&_contendedReadWaitTimeNs, (uintptr_t)(j9time_nano_time() - startTime));
+   VM_AtomicSupport::add(&_numContendedReads, 1);
+   }
+
+void
+JITServerRWMutex::enterWrite()
+   {
+   if (omrthread_rwmutex_try_enter_write(_mutex) != 0)
+      {
+      PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+      uint64_t startTime = j9time_nano_time();
+      omrthread_rwmutex_enter_write(_mutex);
+      _contendedWriteWaitTimeNs += j9time_nano_time() - startTime;
+      _numContendedWrites++;
+      }
+   _numWrites++;
+   }
+
+void
+JITServerRWMutex::printStats(const char *name)
+   {
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   j9tty_printf(PORTLIB, "\t\t%s: contended reads: %llu wait time: %llu us; writes: %llu contended: %llu wait time: %llu us\n", name,
+                (unsigned long long)_numContendedReads, (unsigned long long)(_contendedReadWaitTimeNs / 1000),
+                (unsigned long long)_numWrites, (unsigned long long)_numContendedWrites,
+                (unsigned long long)(_contendedWriteWaitTimeNs / 1000));
    }
 
 ClientSessionData::ClassInfo::ClassInfo() :
@@ -386,18 +493,20 @@ ClientSessionData::ClassInfo::ClassInfo() :
    _staticAttributesCache(decltype(_staticAttributesCache)::allocator_type(TR::Compiler->persistentAllocator())),
    _fieldAttributesCacheAOT(decltype(_fieldAttributesCacheAOT)::allocator_type(TR::Compiler->persistentAllocator())),
    _staticAttributesCacheAOT(decltype(_fieldAttributesCacheAOT)::allocator_type(TR::Compiler->persistentAllocator())),
+   _resolvedStringsCache(decltype(_resolvedStringsCache)::allocator_type(TR::Compiler->persistentAllocator())),
    _jitFieldsCache(decltype(_jitFieldsCache)::allocator_type(TR::Compiler->persistentAllocator())),
    _fieldOrStaticDeclaringClassCache(decltype(_fieldOrStaticDeclaringClassCache)::allocator_type(TR::Compiler->persistentAllocator())),
    _fieldOrStaticDefiningClassCache(decltype(_fieldOrStaticDefiningClassCache)::allocator_type(TR::Compiler->persistentAllocator())),
    _J9MethodNameCache(decltype(_J9MethodNameCache)::allocator_type(TR::Compiler->persistentAllocator())),
-   _referencingClassLoaders(decltype(_referencingClassLoaders)::allocator_type(TR::Compiler->persistentAllocator()))
+   _referencingClassLoaders(decltype(_referencingClassLoaders)::allocator_type(TR::Compiler->persistentAllocator())),
+   _prefetched(false)
    {
    }
 
 void
 ClientSessionData::ClassInfo::freeClassInfo()
    {
-   TR_Memory::jitPersistentFree(_romClass);
+   JITServerHelpers::freeRemoteROMClass(_romClass);
 
    // free cached _interfaces
    _interfaces->~PersistentVector<TR_OpaqueClassBlock *>();
@@ -471,7 +580,7 @@ void
 ClientSessionData::clearCaches()
    {
       {
-      OMR::CriticalSection clearCache(getClassMapMonitor());
+      JITServerRWMutex::WriteCriticalSection clearCache(getClassMapRWMutex());
       _classBySignatureMap.clear();
       }
    OMR::CriticalSection getRemoteROMClass(getROMMapMonitor());
@@ -503,7 +612,10 @@ ClientSessionData::clearCaches()
          }
       }
 
-   _J9MethodMap.clear();
+      {
+      JITServerRWMutex::WriteCriticalSection clearJ9MethodMap(getJ9MethodMapRWMutex());
+      _J9MethodMap.clear();
+      }
    // Free memory for j9class info
    for (auto& it : _romClassMap)
       it.second.freeClassInfo();
@@ -870,6 +982,19 @@ ClientSessionHT::purgeOldDataIfNeeded()
 // set the env var `TR_PrintJITServerCacheStats=1`
 // run the server with `-Xdump:jit:events=user`
 // then `kill -3` it when you want to print them
+void
+ClientSessionHT::printQueueWaitStats()
+   {
+   for (auto &session : _clientSessionMap)
+      {
+      ClientSessionData *data = session.second;
+      TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "clientUID=%llu compilation queue wait: requests=%llu avg=%.1f ms max=%llu ms",
+                                     (unsigned long long)session.first, (unsigned long long)data->getNumQueuedRequests(),
+                                     data->getNumQueuedRequests() ? data->getTotalQueueWaitMs() / (double)data->getNumQueuedRequests() : 0.0,
+                                     (unsigned long long)data->getMaxQueueWaitMs());
+      }
+   }
+
 void
 ClientSessionHT::printStats()
    {
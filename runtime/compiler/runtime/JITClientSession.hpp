@@ -130,6 +130,8 @@ class TR_J9MethodFieldAttributes
 
 
 using TR_FieldAttributesCache = PersistentUnorderedMap<int32_t, TR_J9MethodFieldAttributes>;
+// Maps the cpIndex of a resolved string constant to the client address returned by stringConstant()
+using TR_ResolvedStringsCache = PersistentUnorderedMap<int32_t, void *>;
 
 struct ClassLoaderStringPair
    {
@@ -202,6 +204,61 @@ struct J9MethodNameAndSignature
    std::string _methodSignatureStr;
    };
 
+/**
+   @class JITServerRWMutex
+   @brief Reader/writer lock for the read-mostly caches of a client session
+
+   Once warmed up, the caches guarded by these locks are almost only read by
+   compilation threads, so readers proceed in parallel and only inserts and
+   purges are exclusive. Unlike TR::Monitor the lock is not reentrant:
+   a thread holding it must not acquire it again and must not upgrade
+   a read lock to a write lock.
+
+   Contention statistics are kept for both kinds of acquisitions. Readers only
+   count acquisitions that had to wait, so that uncontended reads do not write
+   to a shared cache line.
+ */
+class JITServerRWMutex
+   {
+public:
+   JITServerRWMutex(const char *name);
+   ~JITServerRWMutex();
+
+   void enterRead();
+   void exitRead() { omrthread_rwmutex_exit_read(_mutex); }
+   void enterWrite();
+   void exitWrite() { omrthread_rwmutex_exit_write(_mutex); }
+
+   void printStats(const char *name);
+
+   class ReadCriticalSection
+      {
+   public:
+      ReadCriticalSection(JITServerRWMutex *mutex) : _mutex(mutex) { _mutex->enterRead(); }
+      ~ReadCriticalSection() { _mutex->exitRead(); }
+   private:
+      JITServerRWMutex *_mutex;
+      };
+
+   class WriteCriticalSection
+      {
+   public:
+      WriteCriticalSection(JITServerRWMutex *mutex) : _mutex(mutex) { _mutex->enterWrite(); }
+      ~WriteCriticalSection() { _mutex->exitWrite(); }
+   private:
+      JITServerRWMutex *_mutex;
+      };
+
+private:
+   omrthread_rwmutex_t _mutex;
+   // Statistics
+   uintptr_t _numContendedReads; // updated atomically
+   uintptr_t _contendedReadWaitTimeNs; // updated atomically
+   uint64_t _numWrites;
+   uint64_t _numContendedWrites;
+   uint64_t _contendedWriteWaitTimeNs;
+   };
+
 /**
    @class ClientSessionData
    @brief Data structure that holds data specific to a client
@@ -264,6 +321,7 @@ class ClientSessionData
       TR_FieldAttributesCache _staticAttributesCache;
       TR_FieldAttributesCache _fieldAttributesCacheAOT;
       TR_FieldAttributesCache _staticAttributesCacheAOT;
+      TR_ResolvedStringsCache _resolvedStringsCache; // only populated by regular JIT compilations
       TR_JitFieldsCache _jitFieldsCache;
       PersistentUnorderedMap<int32_t, TR_OpaqueClassBlock *> _fieldOrStaticDeclaringClassCache;
       // The following cache is very similar to _fieldOrStaticDeclaringClassCache but it uses
@@ -271,6 +329,7 @@ class ClientSessionData
       PersistentUnorderedMap<int32_t, TR_OpaqueClassBlock *> _fieldOrStaticDefiningClassCache;
       PersistentUnorderedMap<int32_t, J9MethodNameAndSignature> _J9MethodNameCache; // key is a cpIndex
       PersistentUnorderedSet<J9ClassLoader *> _referencingClassLoaders;
+      bool _prefetched; // sent ahead by the client and not used by any compilation yet
 
       char* getROMString(int32_t& len, void *basePtr, std::initializer_list<size_t> offsets);
       char* getRemoteROMString(int32_t& len, void *basePtr, std::initializer_list<size_t> offsets);
@@ -375,8 +434,60 @@ class ClientSessionData
    void processUnloadedClasses(const std::vector<TR_OpaqueClassBlock*> &classes, bool updateUnloadedClasses);
    void processIllegalFinalFieldModificationList(const std::vector<TR_OpaqueClassBlock*> &classes);
    TR::Monitor *getROMMapMonitor() { return _romMapMonitor; }
-   TR::Monitor *getClassMapMonitor() { return _classMapMonitor; }
+   // Inserting into or erasing from _J9MethodMap requires both the ROMMapMonitor and the write lock below.
+   // Readers that only look at the fields set when a method is cached can hold just the read lock;
+   // the remaining fields (e.g. the IProfiler data) are only accessed with the ROMMapMonitor in hand.
+   JITServerRWMutex *getJ9MethodMapRWMutex() { return &_J9MethodMapRWMutex; }
+   JITServerRWMutex *getClassMapRWMutex() { return &_classMapRWMutex; }
    TR::Monitor *getClassChainDataMapMonitor() { return _classChainDataMapMonitor; }
+   // Asking the client for the hash of a ROM class instead of its content saves a transfer when
+   // the shared ROM class cache holds the class, and costs an extra round trip when it does not.
+   // Stop asking for hashes if most of the recent lookups for this client fail (e.g. first client of its kind),
+   // except for one request in ROM_CLASS_HASH_SAMPLING_PERIOD, so that the decision is revisited once
+   // other clients have filled the shared ROM class cache with the classes of this one.
+   bool shouldRequestROMClassHashOnly()
+      {
+      if ((_numROMClassHashLookups < ROM_CLASS_HASH_LOOKUPS_BEFORE_DECISION) ||
+          (2 * _numROMClassHashHits >= _numROMClassHashLookups))
+         return true;
+      return (++_numROMClassRequestsWithoutHash % ROM_CLASS_HASH_SAMPLING_PERIOD) == 0;
+      }
+   void recordROMClassHashLookup(bool hit)
+      {
+      // Halve the counts periodically so that the hit ratio follows recent lookups
+      if (_numROMClassHashLookups >= ROM_CLASS_HASH_LOOKUP_WINDOW)
+         {
+         _numROMClassHashLookups /= 2;
+         _numROMClassHashHits /= 2;
+         }
+      _numROMClassHashLookups++;
+      if (hit)
+         _numROMClassHashHits++;
+      }
+   // Time the requests of this client spent in the compilation queue; must be called with the compilation monitor in hand
+   uint64_t getNumQueuedRequests() const { return _numQueuedRequests; }
+   uint64_t getTotalQueueWaitMs() const { return _totalQueueWaitMs; }
+   uint64_t getMaxQueueWaitMs() const { return _maxQueueWaitMs; }
+   void recordQueueWait(uint64_t waitMs)
+      {
+      _numQueuedRequests++;
+      _totalQueueWaitMs += waitMs;
+      if (waitMs > _maxQueueWaitMs)
+         _maxQueueWaitMs = waitMs;
+      }
+   // The following must be called with the ROMMapMonitor in hand
+   void recordCompilationRequest() { _numCompilationRequests++; }
+   void recordPrefetchedClass() { _numPrefetchedClasses++; }
+   // Called when a compilation finds a class in _romClassMap; a prefetched class counts once,
+   // as the round trip that the server would have made to fetch it on demand
+   void recordClassInfoUse(ClassInfo &classInfo)
+      {
+      if (classInfo._prefetched)
+         {
+         classInfo._prefetched = false;
+         _numPrefetchedClassesUsed++;
+         }
+      }
    TR_IPBytecodeHashTableEntry *getCachedIProfilerInfo(TR_OpaqueMethodBlock *method, uint32_t byteCodeIndex, bool *methodInfoPresent);
    bool cacheIProfilerInfo(TR_OpaqueMethodBlock *method, uint32_t byteCodeIndex, TR_IPBytecodeHashTableEntry *entry, bool isCompiled);
    VMInfo *getOrCacheVMInfo(JITServer::ServerStream *stream);
@@ -398,7 +509,7 @@ class ClientSessionData
    int64_t getTimeOflastAccess() const { return _timeOfLastAccess; }
 
    TR::Monitor *getSequencingMonitor() { return _sequencingMonitor; }
-   TR::Monitor *getConstantPoolMonitor() { return _constantPoolMapMonitor; }
+   JITServerRWMutex *getConstantPoolMapRWMutex() { return &_constantPoolMapRWMutex; }
    TR_MethodToBeCompiled *getOOSequenceEntryList() const { return _OOSequenceEntryList; }
    void setOOSequenceEntryList(TR_MethodToBeCompiled *m) { _OOSequenceEntryList = m; }
    TR_MethodToBeCompiled *notifyAndDetachFirstWaitingThread();
@@ -457,6 +568,8 @@ class ClientSessionData
    void setIsInStartupPhase(bool isInStartupPhase) { _isInStartupPhase = isInStartupPhase; }
  
    private:
+   static void printMonitorStats(TR::Monitor *monitor, const char *name);
+
    const uint64_t _clientUID;
    int64_t  _timeOfLastAccess; // in ms
    TR_OpaqueClassBlock *_javaLangClassPtr; // NULL means not set
@@ -474,12 +587,13 @@ class ClientSessionData
    //Constant pool to class map
    PersistentUnorderedMap<J9ConstantPool *, TR_OpaqueClassBlock *> _constantPoolToClassMap;
    TR::Monitor *_romMapMonitor;
-   TR::Monitor *_classMapMonitor;
+   JITServerRWMutex _J9MethodMapRWMutex;
+   JITServerRWMutex _classMapRWMutex;
    TR::Monitor *_classChainDataMapMonitor;
    // The following monitor is used to protect access to _lastProcessedCriticalSeqNo and
    // the list of out-of-sequence compilation requests (_OOSequenceEntryList)
    TR::Monitor *_sequencingMonitor;
-   TR::Monitor *_constantPoolMapMonitor;
+   JITServerRWMutex _constantPoolMapRWMutex;
    // Compilation requests that arrived out-of-sequence wait in
    // _OOSequenceEntryList for their turn to be processed
    TR_MethodToBeCompiled *_OOSequenceEntryList;
@@ -526,6 +640,22 @@ class ClientSessionData
    TR::Monitor *_wellKnownClassesMonitor;
    
    bool _isInStartupPhase;
+
+   static const uint32_t ROM_CLASS_HASH_LOOKUPS_BEFORE_DECISION = 64;
+   static const uint32_t ROM_CLASS_HASH_LOOKUP_WINDOW = 4 * ROM_CLASS_HASH_LOOKUPS_BEFORE_DECISION;
+   static const uint32_t ROM_CLASS_HASH_SAMPLING_PERIOD = 16;
+   // Not synchronized; only used as a heuristic by shouldRequestROMClassHashOnly()
+   uint32_t _numROMClassHashLookups;
+   uint32_t _numROMClassHashHits;
+   uint32_t _numROMClassRequestsWithoutHash;
+   // Effectiveness of the classes sent ahead with compilation requests; protected by the ROMMapMonitor
+   uint64_t _numCompilationRequests;
+   uint64_t _numPrefetchedClasses;
+   uint64_t _numPrefetchedClassesUsed;
+   // Queue wait of the requests from this client; protected by the compilation monitor
+   uint64_t _numQueuedRequests;
+   uint64_t _totalQueueWaitMs;
+   uint64_t _maxQueueWaitMs;
    }; // class ClientSessionData
 
 
@@ -553,6 +683,7 @@ class ClientSessionHT
    void purgeOldDataIfNeeded();
    void printStats();
    uint32_t size() const { return _clientSessionMap.size(); }
+   void printQueueWaitStats(); // to vlog; must be called with the compilation monitor in hand
 
    private:
    PersistentUnorderedMap<uint64_t, ClientSessionData*> _clientSessionMap;
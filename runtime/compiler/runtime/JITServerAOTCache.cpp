@@ -0,0 +1,182 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/JITServerAOTCache.hpp"
+
+#include <string.h>
+#include "j9.h"
+#include "env/CompilerEnv.hpp"
+#include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+
+
+JITServerAOTCache::JITServerAOTCache(const std::string &name, JITServerAOTCacheMap *cacheMap) :
+   _name(name),
+   _cacheMap(cacheMap),
+   _map(decltype(_map)::allocator_type(TR::Compiler->persistentAllocator())),
+   _monitor(TR::Monitor::create("JIT-JITServerAOTCacheMonitor")),
+   _numLookups(0), _numHits(0), _numStores(0), _numStoresOverLimit(0), _totalSize(0)
+   {
+   }
+
+// The destructor is currently never called because the server does not exit cleanly
+JITServerAOTCache::~JITServerAOTCache()
+   {
+   for (auto &it : _map)
+      TR_Memory::jitPersistentFree(it.second);
+   TR::Monitor::destroy(_monitor);
+   }
+
+bool
+JITServerAOTCache::get(const JITServerAOTCacheKey &key, std::string &codeCacheStr, std::string &dataCacheStr)
+   {
+   OMR::CriticalSection get(_monitor);
+   ++_numLookups;
+   auto it = _map.find(key);
+   if (it == _map.end())
+      return false;
+   CachedMethod *method = it->second;
+   codeCacheStr.assign((const char *)method->code(), method->_codeSize);
+   dataCacheStr.assign((const char *)method->data(), method->_dataSize);
+   ++_numHits;
+   return true;
+   }
+
+bool
+JITServerAOTCache::store(const JITServerAOTCacheKey &key, const std::string &codeCacheStr, const std::string &dataCacheStr)
+   {
+      {
+      OMR::CriticalSection store(_monitor);
+      if (_map.find(key) != _map.end())
+         return false;
+      }
+
+   size_t size = codeCacheStr.size() + dataCacheStr.size();
+   if (!_cacheMap->reserveSpace(sizeof(CachedMethod) + size))
+      {
+      OMR::CriticalSection store(_monitor);
+      ++_numStoresOverLimit;
+      return false;
+      }
+
+   // Copy the body outside of the critical section
+   CachedMethod *method = (CachedMethod *)TR_Memory::jitPersistentAlloc(sizeof(CachedMethod) + size, TR_Memory::ClientSessionData);
+   if (!method)
+      {
+      _cacheMap->releaseSpace(sizeof(CachedMethod) + size);
+      return false; // Caching is an optimization; the compilation itself succeeded
+      }
+   method->_codeSize = codeCacheStr.size();
+   method->_dataSize = dataCacheStr.size();
+   memcpy(method->code(), codeCacheStr.data(), codeCacheStr.size());
+   memcpy(method->data(), dataCacheStr.data(), dataCacheStr.size());
+
+   OMR::CriticalSection store(_monitor);
+   // Another compilation of the same method may have been stored in the meantime
+   if (!_map.insert({ key, method }).second)
+      {
+      TR_Memory::jitPersistentFree(method);
+      _cacheMap->releaseSpace(sizeof(CachedMethod) + size);
+      return false;
+      }
+   ++_numStores;
+   _totalSize += size;
+   return true;
+   }
+
+void
+JITServerAOTCache::printStats()
+   {
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   OMR::CriticalSection printStats(_monitor);
+   j9tty_printf(PORTLIB, "JITServer AOT cache \"%s\":\n", _name.c_str());
+   j9tty_printf(PORTLIB, "\tNum cached methods: %zu\n", _map.size());
+   j9tty_printf(PORTLIB, "\tTotal size of cached methods: %llu bytes\n", (unsigned long long)_totalSize);
+   j9tty_printf(PORTLIB, "\tLookups: %llu hits: %llu stores: %llu stores over size limit: %llu\n",
+                (unsigned long long)_numLookups, (unsigned long long)_numHits, (unsigned long long)_numStores,
+                (unsigned long long)_numStoresOverLimit);
+   }
+
+
+JITServerAOTCacheMap::JITServerAOTCacheMap(size_t maxSize) :
+   _map(decltype(_map)::allocator_type(TR::Compiler->persistentAllocator())),
+   _monitor(TR::Monitor::create("JIT-JITServerAOTCacheMapMonitor")),
+   _maxSize(maxSize),
+   _totalSize(0)
+   {
+   }
+
+// The destructor is currently never called because the server does not exit cleanly
+JITServerAOTCacheMap::~JITServerAOTCacheMap()
+   {
+   for (auto &it : _map)
+      {
+      it.second->~JITServerAOTCache();
+      TR_Memory::jitPersistentFree(it.second);
+      }
+   TR::Monitor::destroy(_monitor);
+   }
+
+JITServerAOTCache *
+JITServerAOTCacheMap::get(const std::string &identity)
+   {
+   OMR::CriticalSection get(_monitor);
+   auto it = _map.find(identity);
+   if (it != _map.end())
+      return it->second;
+
+   // The name is the part of the identity up to the first '\0'
+   auto cache = new (PERSISTENT_NEW) JITServerAOTCache(std::string(identity.c_str()), this);
+   if (!cache)
+      throw std::bad_alloc();
+   _map.insert({ identity, cache });
+   return cache;
+   }
+
+bool
+JITServerAOTCacheMap::reserveSpace(size_t size)
+   {
+   OMR::CriticalSection reserveSpace(_monitor);
+   if (size > _maxSize - _totalSize)
+      return false;
+   _totalSize += size;
+   return true;
+   }
+
+void
+JITServerAOTCacheMap::releaseSpace(size_t size)
+   {
+   OMR::CriticalSection releaseSpace(_monitor);
+   TR_ASSERT(size <= _totalSize, "Releasing more AOT cache space than reserved");
+   _totalSize -= size;
+   }
+
+void
+JITServerAOTCacheMap::printStats()
+   {
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   OMR::CriticalSection printStats(_monitor);
+   j9tty_printf(PORTLIB, "JITServer AOT caches: %zu bytes used of %zu\n", _totalSize, _maxSize);
+   for (auto &it : _map)
+      it.second->printStats();
+   }
@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITSERVER_AOT_CACHE_H
+#define JITSERVER_AOT_CACHE_H
+
+#include <string>
+#include "env/PersistentCollections.hpp" // for PersistentUnorderedMap
+#include "env/TRMemory.hpp"
+#include "runtime/JITServerROMClassCache.hpp" // for JITServerROMClassHash
+
+namespace TR { class Monitor; }
+class JITServerAOTCacheMap;
+
+/**
+   @brief Identity of a method compiled by the server, independent of the client
+*/
+struct JITServerAOTCacheKey
+   {
+   bool operator==(const JITServerAOTCacheKey &other) const
+      {
+      return (_romClassHash == other._romClassHash) &&
+             (_romMethodOffset == other._romMethodOffset) &&
+             (_optLevel == other._optLevel);
+      }
+
+   JITServerROMClassHash _romClassHash; // SHA-256 digest of the ROM class defining the method
+   uint32_t _romMethodOffset; // offset of the ROM method from the start of its ROM class
+   int32_t _optLevel;
+   };
+
+namespace std
+   {
+   template <> struct hash<JITServerAOTCacheKey>
+      {
+      std::size_t operator()(const JITServerAOTCacheKey &k) const noexcept
+         {
+         return (std::size_t)(k._romClassHash._words[0] ^ ((uint64_t)k._romMethodOffset << 8) ^ (uint64_t)k._optLevel);
+         }
+      };
+   }
+
+/**
+   @class JITServerAOTCache
+   @brief Relocatable method bodies produced by remote AOT compilations
+
+   A cache is shared by all clients that announce the same cache identity, i.e. the
+   same -XX:JITServerAOTCacheName, the same code generation options, the same read-only
+   shared class cache (name, layout and content digests), the same compressed refs shift
+   and the same processor features. The code and the relocation records produced for one of them
+   can then be relocated by any other. Relocation at the client still validates the
+   classes and methods the body depends on, as for any AOT body loaded from the shared
+   class cache.
+
+   Only bodies that do not depend on the state of a particular client are stored:
+   no runtime assumptions and no symbol validation manager.
+*/
+class JITServerAOTCache
+   {
+public:
+   TR_PERSISTENT_ALLOC(TR_Memory::ClientSessionData)
+
+   JITServerAOTCache(const std::string &name, JITServerAOTCacheMap *cacheMap);
+   ~JITServerAOTCache();
+
+   const std::string &name() const { return _name; }
+
+   /**
+      @brief Copy the body cached for key into codeCacheStr and dataCacheStr
+      @return false if the method is not cached
+   */
+   bool get(const JITServerAOTCacheKey &key, std::string &codeCacheStr, std::string &dataCacheStr);
+
+   /**
+      @brief Cache the body of a method compiled for one of the clients using this cache
+      @return false if a body for the same key was already cached, the size limit of the
+              AOT caches is reached, or memory is exhausted
+   */
+   bool store(const JITServerAOTCacheKey &key, const std::string &codeCacheStr, const std::string &dataCacheStr);
+
+   void printStats();
+
+private:
+   struct CachedMethod
+      {
+      uint8_t *code() { return (uint8_t *)(this + 1); }
+      uint8_t *data() { return code() + _codeSize; }
+
+      size_t _codeSize;
+      size_t _dataSize;
+      // Code followed by data
+      };
+
+   const std::string _name;
+   JITServerAOTCacheMap *const _cacheMap; // accounts for the size of all caches
+   PersistentUnorderedMap<JITServerAOTCacheKey, CachedMethod *> _map;
+   TR::Monitor *_monitor;
+   // Statistics
+   uint64_t _numLookups;
+   uint64_t _numHits;
+   uint64_t _numStores;
+   uint64_t _numStoresOverLimit;
+   size_t _totalSize;
+   };
+
+/**
+   @class JITServerAOTCacheMap
+   @brief Server-wide collection of AOT caches indexed by the identity announced by clients
+
+   The total size of the bodies stored in all caches is limited by -XX:JITServerAOTCacheMaxBytes;
+   once the limit is reached, new bodies are no longer stored.
+*/
+class JITServerAOTCacheMap
+   {
+public:
+   TR_PERSISTENT_ALLOC(TR_Memory::ClientSessionData)
+
+   JITServerAOTCacheMap(size_t maxSize);
+   ~JITServerAOTCacheMap();
+
+   /**
+      @brief Return the cache for a client identity, creating it if needed
+      @param identity Cache name followed by '\0' and the code generation options of the client
+   */
+   JITServerAOTCache *get(const std::string &identity);
+
+   /**
+      @brief Account for a body about to be stored in one of the caches
+      @return false if storing the body would exceed the size limit
+   */
+   bool reserveSpace(size_t size);
+   /**
+      @brief Undo reserveSpace() for a body that was not stored
+   */
+   void releaseSpace(size_t size);
+
+   void printStats();
+
+private:
+   PersistentUnorderedMap<std::string, JITServerAOTCache *> _map;
+   TR::Monitor *_monitor;
+   const size_t _maxSize;
+   size_t _totalSize; // bytes reserved by all caches
+   };
+
+#endif /* defined(JITSERVER_AOT_CACHE_H) */
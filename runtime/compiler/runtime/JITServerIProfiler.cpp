@@ -125,6 +125,19 @@ JITServerIProfiler::ipBytecodeHashTableEntryFactory(TR_IPBCDataStorageHeader *st
       entry = (TR_IPBytecodeHashTableEntry*)mem->allocateMemory(sizeof(TR_IPBCDataCallGraph), allocKind, TR_Memory::IPBCDataCallGraph);
       entry = new (entry) TR_IPBCDataCallGraph(pc);
       }
+   else if (entryType == TR_IPBCD_CALL_GRAPH_EXTENDED)
+      {
+      TR_ASSERT(storage->left == 0 || storage->left == sizeof(TR_IPBCDataCallGraphExtendedStorage), "Wrong size for serialized IP entry %u != %u", storage->left, sizeof(TR_IPBCDataCallGraphExtendedStorage));
+      // Allocate the extended slots together with the entry, so that both are freed at once
+      void *space = mem->allocateMemory(sizeof(TR_IPBCDataCallGraph) + sizeof(CallSiteExtendedProfileInfo), allocKind, TR_Memory::IPBCDataCallGraph);
+      if (space)
+         {
+         TR_IPBCDataCallGraph *cgEntry = new (space) TR_IPBCDataCallGraph(pc);
+         cgEntry->setExtendedCGData((CallSiteExtendedProfileInfo *)(cgEntry + 1));
+         cgEntry->getExtendedCGData()->initialize();
+         entry = cgEntry;
+         }
+      }
    else if (entryType == TR_IPBCD_EIGHT_WORDS)
       {
       TR_ASSERT(storage->left == 0 || storage->left == sizeof(TR_IPBCDataEightWordsStorage), "Wrong size for serialized IP entry %u != %u", storage->left, sizeof(TR_IPBCDataEightWordsStorage));
@@ -221,6 +234,7 @@ JITServerIProfiler::profilingSample(TR_OpaqueMethodBlock *method, uint32_t byteC
             bool isCompiledWhenProfiling = false;
             if(!entryFromPerCompilationCache)
                {
+               JITServerRWMutex::ReadCriticalSection getJ9MethodInfo(clientSessionData->getJ9MethodMapRWMutex());
                auto & j9methodMap = clientSessionData->getJ9MethodMap();
                auto it = j9methodMap.find((J9Method*)method);
                if (it != j9methodMap.end())
@@ -290,7 +304,7 @@ JITServerIProfiler::profilingSample(TR_OpaqueMethodBlock *method, uint32_t byteC
             // Interfaces are weird; we may have to add 2 to the bci that is going to be the key
             //
             uint32_t bci = storage->pc;
-            if (storage->ID == TR_IPBCD_CALL_GRAPH)
+            if (storage->ID == TR_IPBCD_CALL_GRAPH || storage->ID == TR_IPBCD_CALL_GRAPH_EXTENDED)
                {
                U_8* pc = (U_8*)entry->getPC();
                uint32_t methodSize = TR::Compiler->mtd.bytecodeSize(method); 
@@ -347,7 +361,7 @@ JITServerIProfiler::profilingSample(TR_OpaqueMethodBlock *method, uint32_t byteC
             if (entry)
                entry->deserialize(storage);
 
-            if (storage->ID == TR_IPBCD_CALL_GRAPH)
+            if (storage->ID == TR_IPBCD_CALL_GRAPH || storage->ID == TR_IPBCD_CALL_GRAPH_EXTENDED)
                {
                U_8* pc = (U_8*)entry->getPC();
                uint32_t methodSize = TR::Compiler->mtd.bytecodeSize(method); 
@@ -457,6 +471,7 @@ JITServerIProfiler::validateCachedIPEntry(TR_IPBytecodeHashTableEntry *entry, TR
                }
                break;
             case TR_IPBCD_CALL_GRAPH:
+            case TR_IPBCD_CALL_GRAPH_EXTENDED:
                {
                TR_IPBCDataCallGraph *concreteEntry = entry->asIPBCDataCallGraph();
                TR_ASSERT(concreteEntry, "Cached IP entry is not of type TR_IPBCDataCallGraph");
@@ -638,7 +653,7 @@ JITClientIProfiler::walkILTreeForIProfilingEntries(uintptr_t *pcEntries, uint32_
             uint32_t canPersist = entry->canBeSerialized(getCompInfo()->getPersistentInfo());
             if (canPersist == IPBC_ENTRY_CAN_PERSIST)
                {
-               bytesFootprint += entry->getBytesFootprint();
+               bytesFootprint += entry->getSerializedBytesFootprint();
                // doing insertion sort as we go.
                int32_t i;
                for (i = numEntries; i > 0 && pcEntries[i - 1] > thisPC; i--)
@@ -717,7 +732,7 @@ JITClientIProfiler::serializeIProfilerMethodEntries(uintptr_t *pcEntries, uint32
       entry->serialize(methodStartAddress, storage, getCompInfo()->getPersistentInfo());
 
       // optimistically set link to next entry
-      uint32_t bytes = entry->getBytesFootprint();
+      uint32_t bytes = entry->getSerializedBytesFootprint();
       TR_ASSERT(bytes < 1 << 8, "Error storing iprofile information: left child too far away"); // current size of left child
       storage->left = bytes;
 
@@ -768,7 +783,8 @@ JITClientIProfiler::serializeAndSendIProfileInfoForMethod(TR_OpaqueMethodBlock *
          intptr_t writtenBytes = serializeIProfilerMethodEntries(pcEntries, numEntries, (uintptr_t)&buffer[0], methodStart);
          TR_ASSERT(writtenBytes == bytesFootprint, "BST doesn't match expected footprint");
          // send the information to the server
-         client->write(JITServer::MessageType::IProfiler_profilingSample, buffer, true, usePersistentCache, isCompiled);
+         // the serialized entries are gathered directly from this buffer when the message is sent
+         client->write(JITServer::MessageType::IProfiler_profilingSample, JITServer::StringRef(buffer), true, usePersistentCache, isCompiled);
          }
       else if (!numEntries && !abort)// Empty IProfiler data for this method
          {
@@ -0,0 +1,179 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/JITServerROMClassCache.hpp"
+
+#include <string.h>
+#include <openssl/sha.h>
+#include "j9.h"
+#include "env/CompilerEnv.hpp"
+#include "infra/Assert.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+#include "net/LoadSSLLibs.hpp"
+
+
+bool
+JITServerROMClassHash::init()
+   {
+   return JITServer::loadLibsslDigestSymbols();
+   }
+
+JITServerROMClassHash
+JITServerROMClassHash::compute(const void *data, size_t size)
+   {
+   static_assert(sizeof(_words) == SHA256_DIGEST_LENGTH, "Unexpected digest size");
+   JITServerROMClassHash hash = {};
+   if (!OEVP_sha256 || !OEVP_Digest)
+      return hash;
+
+   unsigned int digestSize = 0;
+   if (!(*OEVP_Digest)(data, size, (unsigned char *)hash._words, &digestSize, (*OEVP_sha256)(), NULL) ||
+       (digestSize != sizeof(hash._words)))
+      return JITServerROMClassHash();
+   return hash;
+   }
+
+
+JITServerSharedROMClassCache::JITServerSharedROMClassCache() :
+   _map(decltype(_map)::allocator_type(TR::Compiler->persistentAllocator())),
+   _monitor(TR::Monitor::create("JIT-JITServerSharedROMClassCacheMonitor")),
+   _numLookups(0), _numHits(0), _numHashMisses(0), _numCollisions(0),
+   _totalSize(0), _totalSizeWithoutSharing(0)
+   {
+   }
+
+// The destructor is currently never called because the server does not exit cleanly
+JITServerSharedROMClassCache::~JITServerSharedROMClassCache()
+   {
+   for (auto &it : _map)
+      TR_Memory::jitPersistentFree(it.second);
+   TR::Monitor::destroy(_monitor);
+   }
+
+J9ROMClass *
+JITServerSharedROMClassCache::getOrCreate(const std::string &packedROMClass)
+   {
+   JITServerROMClassHash hash = JITServerROMClassHash::compute(packedROMClass.data(), packedROMClass.size());
+   bool isShared = true;
+      {
+      OMR::CriticalSection getOrCreate(_monitor);
+      ++_numLookups;
+      auto it = _map.find(hash);
+      if (it != _map.end())
+         {
+         Entry *entry = it->second;
+         J9ROMClass *romClass = entry->romClass();
+         if ((romClass->romSize == packedROMClass.size()) &&
+             !memcmp(romClass, packedROMClass.data(), packedROMClass.size()))
+            {
+            ++entry->_refCount;
+            ++_numHits;
+            _totalSizeWithoutSharing += romClass->romSize;
+            return romClass;
+            }
+         // Different content with the same hash; keep a private copy outside the map
+         ++_numCollisions;
+         isShared = false;
+         }
+      }
+
+   // Copy the ROM class outside of the critical section
+   Entry *entry = (Entry *)TR_Memory::jitPersistentAlloc(sizeof(Entry) + packedROMClass.size(), TR_Memory::ROMClass);
+   if (!entry)
+      throw std::bad_alloc();
+   entry->_hash = hash;
+   entry->_refCount = 1;
+   entry->_isShared = isShared;
+   memcpy(entry->romClass(), packedROMClass.data(), packedROMClass.size());
+
+   OMR::CriticalSection getOrCreate(_monitor);
+   _totalSizeWithoutSharing += packedROMClass.size();
+   if (isShared)
+      {
+      // Another thread may have cached the same ROM class in the meantime
+      auto result = _map.insert({ hash, entry });
+      if (!result.second)
+         {
+         Entry *existing = result.first->second;
+         if ((existing->romClass()->romSize == packedROMClass.size()) &&
+             !memcmp(existing->romClass(), packedROMClass.data(), packedROMClass.size()))
+            {
+            ++existing->_refCount;
+            TR_Memory::jitPersistentFree(entry);
+            return existing->romClass();
+            }
+         entry->_isShared = false;
+         }
+      }
+   _totalSize += packedROMClass.size();
+   return entry->romClass();
+   }
+
+J9ROMClass *
+JITServerSharedROMClassCache::get(const JITServerROMClassHash &hash)
+   {
+   OMR::CriticalSection get(_monitor);
+   ++_numLookups;
+   auto it = _map.find(hash);
+   if (it == _map.end())
+      {
+      ++_numHashMisses;
+      return NULL;
+      }
+   Entry *entry = it->second;
+   ++entry->_refCount;
+   ++_numHits;
+   _totalSizeWithoutSharing += entry->romClass()->romSize;
+   return entry->romClass();
+   }
+
+void
+JITServerSharedROMClassCache::release(J9ROMClass *romClass)
+   {
+   Entry *entry = Entry::get(romClass);
+      {
+      OMR::CriticalSection release(_monitor);
+      TR_ASSERT(entry->_refCount > 0, "Releasing ROM class %p with no references", romClass);
+      _totalSizeWithoutSharing -= romClass->romSize;
+      if (--entry->_refCount > 0)
+         return;
+      _totalSize -= romClass->romSize;
+      if (entry->_isShared)
+         _map.erase(entry->_hash);
+      }
+   TR_Memory::jitPersistentFree(entry);
+   }
+
+void
+JITServerSharedROMClassCache::printStats()
+   {
+   PORT_ACCESS_FROM_PORT(TR::Compiler->portLib);
+   OMR::CriticalSection printStats(_monitor);
+   j9tty_printf(PORTLIB, "Shared ROM class cache:\n");
+   j9tty_printf(PORTLIB, "\tNum distinct ROM classes: %zu\n", _map.size());
+   j9tty_printf(PORTLIB, "\tTotal size of distinct ROM classes: %llu bytes\n", (unsigned long long)_totalSize);
+   j9tty_printf(PORTLIB, "\tTotal size without sharing: %llu bytes\n", (unsigned long long)_totalSizeWithoutSharing);
+   j9tty_printf(PORTLIB, "\tLookups: %llu hits: %llu misses by hash: %llu collisions: %llu\n",
+                (unsigned long long)_numLookups, (unsigned long long)_numHits,
+                (unsigned long long)_numHashMisses, (unsigned long long)_numCollisions);
+   }
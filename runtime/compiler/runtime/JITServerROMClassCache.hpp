@@ -0,0 +1,139 @@
+/*******************************************************************************
+ * Copyright (c) 2020, 2020 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at https://www.eclipse.org/legal/epl-2.0/
+ * or the Apache License, Version 2.0 which accompanies this distribution and
+ * is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following
+ * Secondary Licenses when the conditions for such availability set
+ * forth in the Eclipse Public License, v. 2.0 are satisfied: GNU
+ * General Public License, version 2 with the GNU Classpath
+ * Exception [1] and GNU General Public License, version 2 with the
+ * OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITSERVER_ROMCLASS_CACHE_H
+#define JITSERVER_ROMCLASS_CACHE_H
+
+#include <string>
+#include <string.h>
+#include "env/PersistentCollections.hpp" // for PersistentUnorderedMap
+#include "env/TRMemory.hpp"
+
+struct J9ROMClass;
+namespace TR { class Monitor; }
+
+/**
+   @brief SHA-256 digest of a packed ROM class
+
+   Computed by the client over the bytes it would send to the server, so that
+   the server can look up a ROM class it already holds without receiving it.
+   Since the server trusts the digest without comparing content, it must be
+   cryptographic; it is computed with the dynamically loaded OpenSSL library.
+   A digest with all words equal to 0 means "not computed".
+*/
+struct JITServerROMClassHash
+   {
+   /**
+      @brief Compute the digest of the given data
+      @return The digest, or an invalid one if OpenSSL digests are not available
+   */
+   static JITServerROMClassHash compute(const void *data, size_t size);
+   /**
+      @brief Load the OpenSSL digest functions if needed
+      @return true if compute() can produce valid digests
+   */
+   static bool init();
+
+   bool isValid() const { return (_words[0] | _words[1] | _words[2] | _words[3]) != 0; }
+   bool operator==(const JITServerROMClassHash &other) const
+      {
+      return !memcmp(_words, other._words, sizeof(_words));
+      }
+
+   uint64_t _words[4];
+   };
+
+namespace std
+   {
+   template <> struct hash<JITServerROMClassHash>
+      {
+      std::size_t operator()(const JITServerROMClassHash &k) const noexcept
+         {
+         // The digest is already uniformly distributed
+         return (std::size_t)k._words[0];
+         }
+      };
+   }
+
+/**
+   @class JITServerSharedROMClassCache
+   @brief Server-wide store of ROM classes shared by all client sessions
+
+   ROM classes received from clients are deduplicated by content: sessions that
+   cache the same class (e.g. identical JVMs running the same application) share a
+   single copy. Each copy is reference counted; ClientSessionData::ClassInfo holds one
+   reference, which is dropped when the class is unloaded or the session is purged.
+
+   All ROM classes cached at the server are allocated by this class when it is active.
+   Such ROM classes must be released with release() instead of being freed directly.
+*/
+class JITServerSharedROMClassCache
+   {
+public:
+   TR_PERSISTENT_ALLOC(TR_Memory::ROMClass)
+
+   JITServerSharedROMClassCache();
+   ~JITServerSharedROMClassCache();
+
+   /**
+      @brief Return the shared copy of the packed ROM class received from a client,
+             creating it if needed. The caller owns one reference to the result.
+   */
+   J9ROMClass *getOrCreate(const std::string &packedROMClass);
+
+   /**
+      @brief Look up a ROM class by the digest computed by the client.
+      @return The shared copy with one reference acquired for the caller, or NULL
+   */
+   J9ROMClass *get(const JITServerROMClassHash &hash);
+
+   /**
+      @brief Drop one reference to a ROM class returned by getOrCreate() or get()
+   */
+   void release(J9ROMClass *romClass);
+
+   void printStats();
+
+private:
+   struct Entry
+      {
+      static Entry *get(const J9ROMClass *romClass) { return (Entry *)romClass - 1; }
+      J9ROMClass *romClass() { return (J9ROMClass *)(this + 1); }
+
+      JITServerROMClassHash _hash;
+      uint64_t _refCount;
+      bool _isShared; // false if a different ROM class with the same hash was already in the map
+      // ROM class content follows; sizeof(Entry) keeps it 8-byte aligned
+      };
+
+   PersistentUnorderedMap<JITServerROMClassHash, Entry *> _map;
+   TR::Monitor *_monitor;
+   // Statistics
+   uint64_t _numLookups;
+   uint64_t _numHits;
+   uint64_t _numHashMisses; // lookups by hash that did not find the class
+   uint64_t _numCollisions;
+   size_t _totalSize; // bytes of all distinct ROM classes currently cached
+   size_t _totalSizeWithoutSharing; // bytes that would be used if every reference had its own copy
+   };
+
+#endif /* defined(JITSERVER_ROMCLASS_CACHE_H) */
@@ -25,6 +25,7 @@
 #include "env/VMJ9.h" // for TR_JitPrivateConfig
 #include "env/VerboseLog.hpp"
 #include "control/CompilationRuntime.hpp" // for CompilatonInfo
+#include "control/JITServerHelpers.hpp" // for printJITServerMsgLatencySummary()
 
 JITServerStatisticsThread::JITServerStatisticsThread()
    : _statisticsThread(NULL), _statisticsThreadMonitor(NULL), _statisticsOSThread(NULL),
@@ -120,7 +121,16 @@ static int32_t J9THREAD_PROC statisticsThreadProc(void * entryarg)
                {
                TR_VerboseLog::writeLine(TR_Vlog_JITServer, "CpuLoad %d%% (AvgUsage %d%%) JvmCpu %d%%", cpuUsage, avgCpuUsage, vmCpuUsage);
                }
+            // Message types that dominate the time spent waiting for clients
+            if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+               JITServerHelpers::printJITServerMsgLatencySummary(compInfo);
             TR_VerboseLog::vlogRelease();
+            if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+               {
+               // The compilation monitor must be acquired before the vlog lock
+               OMR::CriticalSection compilationMonitorLock(compInfo->getCompilationMonitor());
+               compInfo->getClientSessionHT()->printQueueWaitStats();
+               }
             lastStatsTime = crtTime;
             }
          }
@@ -36,6 +36,8 @@
    2) Purges the stale client sessions periodically (every 10 seconds)
    3) Prints to vlog operational statistics like: number of clients that are connected, 
       number of active compilations threads, CPU utilization of the JITServer, etc.
+      With -Xjit:verbose={JITServer} it also prints the message types that account for most
+      of the round-trip time, and the average number of round trips per compilation.
    The period of the statistics printout is given by _statisticsFrequency. If this value is 0, 
    no statistics are printed. This value can be changed with -Xjit:statisticsFrequency=<period-in-ms>
    To disable the JITServerStatisticsThread functionality completely use -Xjit:samplingFrequency=0
@@ -22,22 +22,25 @@
 
 #include <arpa/inet.h>
 #include <chrono>
+#include <errno.h>
 #include <fcntl.h>
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>	/* for TCP_NODELAY option */
 #include <openssl/err.h>
-#include <poll.h>
+#include <sys/epoll.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h> /// gethostname, read, write
 #include "control/CompilationRuntime.hpp"
 #include "env/TRMemory.hpp"
 #include "env/VMJ9.h"
 #include "env/VerboseLog.hpp"
+#include "infra/CriticalSection.hpp"
 #include "net/CommunicationStream.hpp"
 #include "net/LoadSSLLibs.hpp"
 #include "net/ServerStream.hpp"
@@ -186,10 +189,40 @@ acceptOpenSSLConnection(SSL_CTX *sslCtx, int connfd, BIO *&bio)
 
 TR_Listener::TR_Listener()
    : _listenerThread(NULL), _listenerMonitor(NULL), _listenerOSThread(NULL),
-   _listenerThreadAttachAttempted(false), _listenerThreadExitFlag(false)
+   _listenerThreadAttachAttempted(false), _listenerThreadExitFlag(false),
+   _epollfd(-1), _parkedStreams(NULL), _numParkedConnections(0)
    {
    }
 
+bool
+TR_Listener::parkConnection(JITServer::ServerStream *stream)
+   {
+   // Data already received for the next request would never make the socket readable again
+   if (stream->hasBufferedInput() || (_epollfd < 0) || !_listenerMonitor || getListenerThreadExitFlag())
+      return false;
+
+   OMR::CriticalSection parkConnection(_listenerMonitor);
+   if ((_epollfd < 0) || getListenerThreadExitFlag())
+      return false;
+
+   // Register the stream before the fd is added to the epoll set,
+   // because the listener may receive an event for it right away
+   _parkedStreams->insert(stream);
+   struct epoll_event event;
+   memset(&event, 0, sizeof(event));
+   event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+   event.data.ptr = stream;
+   if (epoll_ctl(_epollfd, EPOLL_CTL_ADD, stream->getConnFD(), &event) < 0)
+      {
+      _parkedStreams->erase(stream);
+      if (TR::Options::getVerboseOption(TR_VerboseJITServer))
+         TR_VerboseLog::writeLineLocked(TR_Vlog_JITServer, "Cannot park connection on socket 0x%x: errno=%d", stream->getConnFD(), errno);
+      return false;
+      }
+   _numParkedConnections++;
+   return true;
+   }
+
 void
 TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
    {
@@ -203,7 +236,6 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
 
    uint32_t port = info->getJITServerPort();
    uint32_t timeoutMs = info->getSocketTimeout();
-   struct pollfd pfd = {0};
    int sockfd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
    if (sockfd < 0)
       {
@@ -241,9 +273,28 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
       exit(1);
       }
 
-   pfd.fd = sockfd;
-   pfd.events = POLLIN;
+   int epollfd = epoll_create1(EPOLL_CLOEXEC);
+   if (epollfd < 0)
+      {
+      perror("can't create epoll instance");
+      exit(1);
+      }
+   // The listening socket is identified by a NULL pointer in its events;
+   // parked connections by their ServerStream
+   struct epoll_event listenEvent;
+   memset(&listenEvent, 0, sizeof(listenEvent));
+   listenEvent.events = EPOLLIN;
+   listenEvent.data.ptr = NULL;
+   if (epoll_ctl(epollfd, EPOLL_CTL_ADD, sockfd, &listenEvent) < 0)
+      {
+      perror("can't add listening socket to epoll set");
+      exit(1);
+      }
+   _parkedStreams = new (PERSISTENT_NEW) PersistentUnorderedSet<JITServer::ServerStream *>(
+      PersistentUnorderedSet<JITServer::ServerStream *>::allocator_type(TR::Compiler->persistentAllocator()));
+   _epollfd = epollfd;
 
+   struct epoll_event events[OPENJ9_LISTENER_MAX_EVENTS];
    while (!getListenerThreadExitFlag())
       {
       int32_t rc = 0;
@@ -251,12 +302,12 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
       socklen_t clilen = sizeof(cli_addr);
       int connfd = -1;
 
-      rc = poll(&pfd, 1, OPENJ9_LISTENER_POLL_TIMEOUT);
-      if (getListenerThreadExitFlag()) // if we are exiting, no need to check poll() status
+      rc = epoll_wait(epollfd, events, OPENJ9_LISTENER_MAX_EVENTS, OPENJ9_LISTENER_POLL_TIMEOUT);
+      if (getListenerThreadExitFlag()) // if we are exiting, no need to check epoll_wait() status
          {
          break;
          }
-      else if (0 == rc) // poll() timed out and no fd is ready
+      else if (0 == rc) // epoll_wait() timed out and no fd is ready
          {
          continue;
          }
@@ -272,11 +323,36 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
             exit(1);
             }
          }
-      else if (pfd.revents != POLLIN)
+
+      bool newConnectionRequested = false;
+      for (int32_t i = 0; i < rc; ++i)
          {
-         fprintf(stderr, "Unexpected event occurred during poll for new connection: revents=%d\n", pfd.revents);
-         exit(1);
+         JITServer::ServerStream *stream = static_cast<JITServer::ServerStream *>(events[i].data.ptr);
+         if (!stream)
+            {
+            if (events[i].events != EPOLLIN)
+               {
+               fprintf(stderr, "Unexpected event occurred during poll for new connection: revents=%d\n", events[i].events);
+               exit(1);
+               }
+            newConnectionRequested = true;
+            continue;
+            }
+
+         // A parked connection received the next compilation request or was closed by the client.
+         // Either way it goes back to a compilation thread, which will read the request or
+         // notice the failure and dispose of the stream.
+            {
+            OMR::CriticalSection unparkConnection(_listenerMonitor);
+            epoll_ctl(epollfd, EPOLL_CTL_DEL, stream->getConnFD(), NULL);
+            _parkedStreams->erase(stream);
+            _numParkedConnections--;
+            }
+         compiler->compile(stream);
          }
+      if (!newConnectionRequested)
+         continue;
+
       do
          {
          /* at this stage we should have a valid request for new connection */
@@ -316,6 +392,20 @@ TR_Listener::serveRemoteCompilationRequests(BaseCompileDispatcher *compiler)
       }
 
    // The following piece of code will be executed only if the server shuts down properly
+      {
+      OMR::CriticalSection closeParkedConnections(_listenerMonitor);
+      _epollfd = -1;
+      for (auto it = _parkedStreams->begin(); it != _parkedStreams->end(); ++it)
+         {
+         JITServer::ServerStream *stream = *it;
+         stream->~ServerStream();
+         TR_Memory::jitPersistentFree(stream);
+         }
+      _parkedStreams->clear();
+      _numParkedConnections = 0;
+      }
+   close(epollfd);
+
    if (sslCtx)
       {
       (*OSSL_CTX_free)(sslCtx);
@@ -25,6 +25,7 @@
 
 #include "j9.h"
 #include "infra/Monitor.hpp"  // TR::Monitor
+#include "env/PersistentCollections.hpp"
 #include "net/ServerStream.hpp"
 
  /**
@@ -35,9 +36,16 @@
     Typical sequence executed by a JITServer is:
     (1) Create a TR_Listener object with "allocate()" function
     (2) Start a listener thread with  listener->startListenerThread(javaVM);
+
+    Connections are long-lived: when a compilation completes, the compilation thread
+    hands the connection back to the listener with parkConnection(). The listener
+    waits with epoll for the next compilation request on all parked connections and
+    only then queues the connection for a compilation thread, so idle connections
+    never occupy compilation threads.
  */
 
 #define OPENJ9_LISTENER_POLL_TIMEOUT 100 // in milliseconds
+#define OPENJ9_LISTENER_MAX_EVENTS 64 // events processed per epoll_wait() call
 
 class BaseCompileDispatcher;
 
@@ -60,11 +68,27 @@ public:
       opened socket descriptor as a parameter) and passed to the compilation handler.
       Typically, the compilation handler places the ServerStream object in a queue and
       returns immediately so that other connection requests can be accepted.
+      Parked connections are watched on the same epoll set as the listening socket
+      and are passed to the compilation handler again when they become readable.
       Note: it must be executed on a separate thread as it needs to keep listening for new connections.
 
       @param [in] compiler Object that defines the behavior when a new connection is accepted
    */
    void serveRemoteCompilationRequests(BaseCompileDispatcher *compiler);
+
+   /**
+      @brief Give back to the listener a connection on which no request is in progress
+
+      The listener will pass the connection to the compilation handler when
+      the next message from the client arrives, or when the client disconnects.
+      Can be called by any thread.
+
+      @param [in] stream Connection whose last compilation request has been fully processed
+      @return true if the listener took ownership of the connection; false if the caller
+              must handle it (e.g. the listener is not running or is shutting down)
+   */
+   bool parkConnection(JITServer::ServerStream *stream);
+   int32_t getNumParkedConnections() const { return _numParkedConnections; }
    int32_t waitForListenerThreadExit(J9JavaVM *javaVM);
    void setAttachAttempted(bool b) { _listenerThreadAttachAttempted = b; }
    bool getAttachAttempted() const { return _listenerThreadAttachAttempted; }
@@ -83,6 +107,9 @@ private:
    j9thread_t _listenerOSThread;
    volatile bool _listenerThreadAttachAttempted;
    volatile bool _listenerThreadExitFlag;
+   volatile int _epollfd; // epoll set with the listening socket and all parked connections; -1 when not active
+   PersistentUnorderedSet<JITServer::ServerStream *> *_parkedStreams; // protected by _listenerMonitor
+   int32_t _numParkedConnections;
    };
 
 /**
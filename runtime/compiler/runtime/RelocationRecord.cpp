@@ -154,16 +154,26 @@ TR_RelocationRecordGroup::applyRelocations(TR_RelocationRuntime *reloRuntime,
    TR_RelocationRecordBinaryTemplate *recordPointer = firstRecord(reloRuntime, reloTarget);
    TR_RelocationRecordBinaryTemplate *endOfRecords = pastLastRecord(reloTarget);
 
+   // Timing every record is only worth its cost when someone reads the stats
+   bool collectReloTimes = aotStats && reloRuntime->options()->getOption(TR_EnableAOTStats);
+   PORT_ACCESS_FROM_JAVAVM(reloRuntime->javaVM());
+
    while (recordPointer < endOfRecords)
       {
       TR_RelocationRecord storage;
       // Create a specific type of relocation record based on the information
       // in the binary record pointed to by `recordPointer`
       TR_RelocationRecord *reloRecord = TR_RelocationRecord::create(&storage, reloRuntime, reloTarget, recordPointer);
+      uint64_t startTime = collectReloTimes ? j9time_hires_clock() : 0;
       int32_t rc = handleRelocation(reloRuntime, reloTarget, reloRecord, reloOrigin);
+      uint8_t reloType = recordPointer->type(reloTarget);
+      if (collectReloTimes)
+         {
+         aotStats->numRelocationsByType[reloType]++;
+         aotStats->relocationTimeByType[reloType] += j9time_hires_delta(startTime, j9time_hires_clock(), J9PORT_TIME_DELTA_IN_MICROSECONDS);
+         }
       if (rc != 0)
          {
-         uint8_t reloType = recordPointer->type(reloTarget);
          aotStats->numRelocationsFailedByType[reloType]++;
          return rc;
          }
@@ -42,6 +42,23 @@ extern "C" void _patchJNICallSite(J9Method *method, uint8_t *pc, uint8_t *newAdd
 
 extern TR::Monitor *assumptionTableMutex;
 
+// Walk a bucket of the RAT without assumptionTableMutex to find out whether it holds
+// an assumption on key. Class loading notifies the RAT for every superclass and
+// interface of the new class, but few of them have assumptions; those lookups
+// should not contend with compilation threads adding assumptions.
+static bool
+bucketHasAssumption(TR_RuntimeAssumptionTable *table, TR_RuntimeAssumptionKind kind, uintptr_t key)
+   {
+   TR_RuntimeAssumptionTable::Reader reader(table);
+   OMR::RuntimeAssumption **headPtr = table->getBucketPtr(kind, TR_RuntimeAssumptionTable::hashCode(key));
+   for (OMR::RuntimeAssumption *cursor = *headPtr; cursor; cursor = cursor->getNext())
+      {
+      if (cursor->matches(key))
+         return true;
+      }
+   return false;
+   }
+
 TR_PatchNOPedGuardSiteOnClassPreInitialize *
 TR_PatchNOPedGuardSiteOnClassPreInitialize::make(
    TR_FrontEnd *fe, TR_PersistentMemory * persistentMemory, char *sig, uint32_t sigLen, uint8_t *loc, uint8_t *dest, OMR::RuntimeAssumption ** sentinel)
@@ -268,6 +285,7 @@ TR_PersistentCHTable::classGotExtended(
       cl->clearShouldNotBeNewlyExtended(); // flags are not needed anymore
       }
 
+   if (bucketHasAssumption(table, RuntimeAssumptionOnClassExtend, (uintptr_t) superClassId))
       {
       OMR::CriticalSection classGotExtended(assumptionTableMutex);
       OMR::RuntimeAssumption ** headPtr = table->getBucketPtr(RuntimeAssumptionOnClassExtend,
@@ -364,10 +382,21 @@ TR_PersistentCHTable::classGotInitialized(
    if (!sig)
       return false;
 
+   TR_RuntimeAssumptionTable *table = persistentMemory->getPersistentInfo()->getRuntimeAssumptionTable();
+   uintptr_t hashIndex = TR_PatchNOPedGuardSiteOnClassPreInitialize::hashCode(sig, sigLen);
+   bool hasAssumption = false;
+      {
+      // See bucketHasAssumption()
+      TR_RuntimeAssumptionTable::Reader reader(table);
+      OMR::RuntimeAssumption **headPtr = table->getBucketPtr(RuntimeAssumptionOnClassPreInitialize, hashIndex);
+      for (OMR::RuntimeAssumption *cursor = *headPtr; cursor && !hasAssumption; cursor = cursor->getNext())
+         hasAssumption = cursor->matches(sig, sigLen);
+      }
+
+   if (hasAssumption)
       {
       OMR::CriticalSection classGotInitialized(assumptionTableMutex);
-      TR_RuntimeAssumptionTable *table = persistentMemory->getPersistentInfo()->getRuntimeAssumptionTable();
-      OMR::RuntimeAssumption ** headPtr = table->getBucketPtr(RuntimeAssumptionOnClassPreInitialize, TR_PatchNOPedGuardSiteOnClassPreInitialize::hashCode(sig, sigLen));
+      OMR::RuntimeAssumption ** headPtr = table->getBucketPtr(RuntimeAssumptionOnClassPreInitialize, hashIndex);
 
       for (OMR::RuntimeAssumption *cursor = *headPtr; cursor; cursor = cursor->getNext())
          {
@@ -391,8 +420,11 @@ TR_PersistentCHTable::methodGotOverridden(
       TR_OpaqueMethodBlock *overriddenMethod,
       int32_t smpFlag)
    {
-   OMR::CriticalSection methodGotOverridden(assumptionTableMutex);
    TR_RuntimeAssumptionTable *table = persistentMemory->getPersistentInfo()->getRuntimeAssumptionTable();
+   if (!bucketHasAssumption(table, RuntimeAssumptionOnMethodOverride, (uintptr_t) overriddenMethod))
+      return;
+
+   OMR::CriticalSection methodGotOverridden(assumptionTableMutex);
    OMR::RuntimeAssumption ** headPtr = table->getBucketPtr(RuntimeAssumptionOnMethodOverride,
                                         TR_RuntimeAssumptionTable::hashCode((uintptr_t)overriddenMethod));
    for (OMR::RuntimeAssumption *cursor = *headPtr; cursor; cursor = cursor->getNext())
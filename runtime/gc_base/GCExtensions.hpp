@@ -121,6 +121,7 @@ public:
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 
 	U_32 _stringTableListToTreeThreshold; /**< Threshold at which we start using trees instead of lists for collision resolution in the String table */
+	UDATA stringTableCount; /**< Number of String table sub-tables, each with its own monitor (-XXgc:stringTableCount=); 0 derives it from the maximum GC thread count */
 
 #if defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING)
 	bool fvtest_forceFinalizeClassLoaders;
@@ -154,6 +155,11 @@ public:
 	MM_UnfinalizedObjectList* unfinalizedObjectLists; /**< The global linked list of unfinalized object lists. */
 	
 	UDATA objectListFragmentCount; /**< the size of Local Object Buffer(per gc thread), used by referenceObjectBuffer, UnfinalizedObjectBuffer and OwnableSynchronizerObjectBuffer */
+	UDATA deepStackScanThreshold; /**< threads using at least this many bytes of Java stack are handed out to GC threads before all others during root scanning (-XXgc:deepStackScanThreshold=, on by default at 64K); 0 disables the ordering */
+#if defined(J9VM_GC_VLHGC)
+	UDATA tarokCopyForwardPrefetchDepth; /**< number of slots whose target headers are prefetched ahead of forwarding while copy-forward scans mixed objects; 0 disables prefetching */
+	bool tarokEnableCopyForwardNodeAffinity; /**< if true (-XXgc:tarokEnableCopyForwardNodeAffinity), copy-forward keeps survivors in the allocation context (NUMA node) of their source region instead of the context of their referrer */
+#endif /* J9VM_GC_VLHGC */
 
 	MM_Wildcard* numaCommonThreadClassNamePatterns; /**< A linked list of thread class names which should be associated with the common context */
 
@@ -296,6 +302,7 @@ public:
 		, classUnloadingAnonymousClassWeight(1.0)
 #endif /* J9VM_GC_DYNAMIC_CLASS_UNLOADING */
 		, _stringTableListToTreeThreshold(1024)
+		, stringTableCount(0)
 		, maxSoftReferenceAge(32)
 #if defined(J9VM_GC_FINALIZATION)
 		, finalizeMainPriority(J9THREAD_PRIORITY_NORMAL)
@@ -307,6 +314,11 @@ public:
 #endif /* defined(J9VM_GC_DYNAMIC_CLASS_UNLOADING) */
 		, unfinalizedObjectLists(NULL)
 		, objectListFragmentCount(0)
+		, deepStackScanThreshold(64 * 1024)
+#if defined(J9VM_GC_VLHGC)
+		, tarokCopyForwardPrefetchDepth(0)
+		, tarokEnableCopyForwardNodeAffinity(false)
+#endif /* J9VM_GC_VLHGC */
 		, numaCommonThreadClassNamePatterns(NULL)
 		, stringDedupPolicy(J9_JIT_STRING_DEDUP_POLICY_UNDEFINED)
 		, _asyncCallbackKey(-1)
@@ -467,6 +467,12 @@ stackSlotIterator(J9JavaVM *javaVM, J9Object **slot, void *localData, J9StackWal
  * either true (if it took an action that requires the thread list iterator to return to
  * the beginning) or false (if the thread list iterator should just continue with the next
  * thread).
+ *
+ * When scanning in parallel, threads whose used stack is at least -XXgc:deepStackScanThreshold=
+ * bytes (64K by default) are handed out in a first pass and all others in a second one, so
+ * that the longest stack walks start first and the short ones balance the load behind them.
+ * Exclusive VM access is held, so every GC thread sees the same stack sizes and claims work
+ * units in the same order.
  */
 void
 MM_RootScanner::scanThreads(MM_EnvironmentBase *env)
@@ -477,16 +483,33 @@ MM_RootScanner::scanThreads(MM_EnvironmentBase *env)
 	 * list is also locked.
 	 */
 
-	GC_VMThreadListIterator vmThreadListIterator(static_cast<J9JavaVM*>(_omrVM->_language_vm));
+	J9JavaVM *javaVM = static_cast<J9JavaVM*>(_omrVM->_language_vm);
+	GC_VMThreadListIterator vmThreadListIterator(javaVM);
 	StackIteratorData localData;
 
 	localData.rootScanner = this;
 	localData.env = env;
 
+	UDATA deepStackThreshold = _singleThread ? 0 : _extensions->deepStackScanThreshold;
+	if (0 != deepStackThreshold) {
+		while(J9VMThread *walkThread = vmThreadListIterator.nextVMThread()) {
+			if (usedStackBytes(walkThread) >= deepStackThreshold) {
+				if (J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+					if (scanOneThreadAndRecordStats(env, walkThread, (void*) &localData)) {
+						vmThreadListIterator.reset(javaVM->mainThread);
+					}
+				}
+			}
+		}
+		vmThreadListIterator.reset(javaVM->mainThread);
+	}
+
 	while(J9VMThread *walkThread = vmThreadListIterator.nextVMThread()) {
-		if (_singleThread || J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
-			if (scanOneThread(env, walkThread, (void*) &localData)) {
-				vmThreadListIterator.reset(static_cast<J9JavaVM*>(_omrVM->_language_vm)->mainThread);
+		if ((0 == deepStackThreshold) || (usedStackBytes(walkThread) < deepStackThreshold)) {
+			if (_singleThread || J9MODRON_HANDLE_NEXT_WORK_UNIT(env)) {
+				if (scanOneThreadAndRecordStats(env, walkThread, (void*) &localData)) {
+					vmThreadListIterator.reset(javaVM->mainThread);
+				}
 			}
 		}
 	}
@@ -494,6 +517,28 @@ MM_RootScanner::scanThreads(MM_EnvironmentBase *env)
 	reportScanningEnded(RootScannerEntity_Threads);
 }
 
+bool
+MM_RootScanner::scanOneThreadAndRecordStats(MM_EnvironmentBase *env, J9VMThread *walkThread, void *localData)
+{
+	if (!_extensions->rootScannerStatsEnabled) {
+		return scanOneThread(env, walkThread, localData);
+	}
+
+	OMRPORT_ACCESS_FROM_OMRVM(_omrVM);
+	UDATA stackBytes = usedStackBytes(walkThread);
+	U_64 startTime = omrtime_hires_clock();
+	bool result = scanOneThread(env, walkThread, localData);
+	U_64 duration = omrtime_hires_clock() - startTime;
+
+	GC_Environment *gcEnv = env->getGCEnvironment();
+	gcEnv->_stacksScanned += 1;
+	if (duration > gcEnv->_maxStackScanTime) {
+		gcEnv->_maxStackScanTime = duration;
+		gcEnv->_maxStackScanBytes = stackBytes;
+	}
+	return result;
+}
+
 /**
  * This function scans exactly one thread for potential roots.  It is designed as
  *    an overridable subroutine of the primary functions scanThreads and scanSingleThread.
@@ -106,6 +106,26 @@ protected:
 	 * Function members
 	 */
 private:
+	/**
+	 * Scan one thread through scanOneThread, recording the duration of the walk in the
+	 * per-thread stack scan statistics when root scanner stats are enabled.
+	 * @return the result of scanOneThread
+	 */
+	bool scanOneThreadAndRecordStats(MM_EnvironmentBase *env, J9VMThread *walkThread, void *localData);
+
+	/**
+	 * @return the number of bytes of Java stack currently used by walkThread
+	 */
+	MMINLINE UDATA
+	usedStackBytes(J9VMThread *walkThread)
+	{
+		UDATA usedBytes = 0;
+		if (NULL != walkThread->stackObject) {
+			usedBytes = (UDATA)walkThread->stackObject->end - (UDATA)walkThread->sp;
+		}
+		return usedBytes;
+	}
+
 	/**
 	 * Scan all fields of mixed object
 	 * @param objectPtr address of object to scan
@@ -552,17 +552,46 @@ j9gc_createJavaLangString(J9VMThread *vmThread, U_8 *data, UDATA length, UDATA s
 	if ((stringFlags & (J9_STR_XLAT | J9_STR_UNICODE | J9_STR_INTERN)) == J9_STR_INTERN) {
 		UDATA hash = 0;
 
+		/* Truncate to the 32 bit Java hash so that the sub-table and cache index match the ones
+		 * computed from the String object by stringHashFn.
+		 */
 		if (J9_ARE_ANY_BITS_SET(stringFlags, J9_STR_ASCII)) {
-			hash = VM_VMHelpers::computeHashForASCII(data, length);
+			hash = (U_32)VM_VMHelpers::computeHashForASCII(data, length);
 		} else {
-			hash = VM_VMHelpers::computeHashForUTF8(data, length);
+			hash = (U_32)VM_VMHelpers::computeHashForUTF8(data, length);
 		}
 
-		UDATA tableIndex = stringTable->getTableIndex(hash);
+		/* Check the intern cache first, without taking the sub-table monitor. The caller holds
+		 * VM access, so the cached String cannot be cleared or moved during the comparison.
+		 */
+		j9object_t *candidatePtr = stringTable->getStringInternCache(hash);
+		j9object_t candidate = *candidatePtr;
 
-		stringTable->lockTable(tableIndex);
-		result = stringTable->hashAtUTF8(tableIndex, data, length, (U_32)hash);
-		stringTable->unlockTable(tableIndex);
+		if (NULL != candidate) {
+			stringTableUTF8Query query;
+			void *queryPtr = NULL;
+
+			query.utf8Data = data;
+			query.utf8Length = length;
+			query.hash = (U_32)hash;
+			queryPtr = (void *) ((UDATA) &query | TYPE_UTF8);
+			if (stringHashEqualFn(&candidate, &queryPtr, vm)) {
+				Trc_MM_stringTableCacheHit(vmThread, candidate);
+				result = candidate;
+			}
+		}
+
+		if (NULL == result) {
+			UDATA tableIndex = stringTable->getTableIndex(hash);
+
+			stringTable->lockTable(tableIndex);
+			result = stringTable->hashAtUTF8(tableIndex, data, length, (U_32)hash);
+			stringTable->unlockTable(tableIndex);
+
+			if (NULL != result) {
+				*candidatePtr = result;
+			}
+		}
 	}
 
 	if (NULL == result) {
@@ -687,6 +716,7 @@ j9gc_createJavaLangString(J9VMThread *vmThread, U_8 *data, UDATA length, UDATA s
 			if (NULL == result) {
 				goto nomem;
 			}
+			*stringTable->getStringInternCache((U_32)J9VMJAVALANGSTRING_HASHCODE(vmThread, result)) = result;
 		}
 	}
 
@@ -43,6 +43,7 @@ private:
     ddr_constant(cacheSize, 511);
 	j9object_t _cache[cacheSize];   /**< interned string table cash */
 public:
+	enum { MAX_TABLE_COUNT = 4096 }; /**< upper bound of -XXgc:stringTableCount= */
 
 private:
 	bool initialize(MM_EnvironmentBase *env);
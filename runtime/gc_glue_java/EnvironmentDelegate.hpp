@@ -51,6 +51,9 @@ public:
 	MM_ReferenceObjectBuffer *_referenceObjectBuffer; /**< The thread-specific buffer of recently discovered reference objects */
 	MM_UnfinalizedObjectBuffer *_unfinalizedObjectBuffer; /**< The thread-specific buffer of recently allocated unfinalized objects */
 	MM_OwnableSynchronizerObjectBuffer *_ownableSynchronizerObjectBuffer; /**< The thread-specific buffer of recently allocated ownable synchronizer objects */
+	UDATA _stacksScanned; /**< Number of thread stacks walked by this GC thread (collected only while root scanner stats are enabled) */
+	U_64 _maxStackScanTime; /**< Longest single thread stack walk by this GC thread, in hires ticks */
+	UDATA _maxStackScanBytes; /**< Used stack size of the thread whose walk took _maxStackScanTime */
 
 	/* Function members */
 private:
@@ -60,7 +63,20 @@ public:
 		:_referenceObjectBuffer(NULL)
 		,_unfinalizedObjectBuffer(NULL)
 		,_ownableSynchronizerObjectBuffer(NULL)
+		,_stacksScanned(0)
+		,_maxStackScanTime(0)
+		,_maxStackScanBytes(0)
 	{}
+
+	/**
+	 * Clear the per-thread stack scan statistics once they have been reported.
+	 */
+	void clearStackScanStats()
+	{
+		_stacksScanned = 0;
+		_maxStackScanTime = 0;
+		_maxStackScanBytes = 0;
+	}
 };
 
 class MM_EnvironmentDelegate
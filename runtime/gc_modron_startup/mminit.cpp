@@ -473,7 +473,13 @@ j9gc_initialize_heap(J9JavaVM *vm, IDATA *memoryParameterTable, UDATA heapBytesR
 		goto error_no_memory;
 	}
 
-	extensions->stringTable = MM_StringTable::newInstance(&env, extensions->dispatcher->threadCountMaximum());
+	if (0 == extensions->stringTableCount) {
+		/* Mutators contend on the sub-table monitors independently of the GC thread count, and
+		 * the sub-tables are also the work units for parallel clearing, so use several per GC thread.
+		 */
+		extensions->stringTableCount = extensions->dispatcher->threadCountMaximum() * 4;
+	}
+	extensions->stringTable = MM_StringTable::newInstance(&env, extensions->stringTableCount);
 	if (NULL == extensions->stringTable) {
 		goto error_no_memory;
 	}
@@ -38,9 +38,13 @@
 #include "mmparse.h"
 
 #include "GCExtensions.hpp"
+#if defined(J9VM_GC_VLHGC)
+#include "CopyForwardScheme.hpp"
+#endif /* J9VM_GC_VLHGC */
 #if defined(J9VM_GC_REALTIME)
 #include "Scheduler.hpp"
 #endif /* J9VM_GC_REALTIME */
+#include "StringTable.hpp"
 #include "Wildcard.hpp"
 
 /**
@@ -320,6 +324,19 @@ gcParseXXgcArguments(J9JavaVM *vm, char *optArg)
 			continue;
 		}
 
+		if (try_scan(&scan_start, "tarokCopyForwardPrefetchDepth=")) {
+			if(!scan_udata_helper(vm, &scan_start, &(extensions->tarokCopyForwardPrefetchDepth), "tarokCopyForwardPrefetchDepth=")) {
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			if (MM_CopyForwardScheme::MAX_PREFETCH_DEPTH < extensions->tarokCopyForwardPrefetchDepth) {
+				j9nls_printf(PORTLIB, J9NLS_ERROR, J9NLS_GC_OPTIONS_INTEGER_OUT_OF_RANGE, "-XXgc:tarokCopyForwardPrefetchDepth=", (UDATA)0, (UDATA)MM_CopyForwardScheme::MAX_PREFETCH_DEPTH);
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			continue;
+		}
+
 		if (try_scan(&scan_start, "tarokKickoffHeadroomInBytes=")) {
 			if(!scan_udata_memory_size_helper(vm, &scan_start, &(extensions->tarokKickoffHeadroomInBytes), "tarokKickoffHeadroomInBytes=")) {
 				returnValue = JNI_EINVAL;
@@ -551,6 +568,14 @@ gcParseXXgcArguments(J9JavaVM *vm, char *optArg)
 			extensions->tarokEnableLeafFirstCopying = false;
 			continue;
 		}
+		if (try_scan(&scan_start, "tarokEnableCopyForwardNodeAffinity")) {
+			extensions->tarokEnableCopyForwardNodeAffinity = true;
+			continue;
+		}
+		if (try_scan(&scan_start, "tarokDisableCopyForwardNodeAffinity")) {
+			extensions->tarokEnableCopyForwardNodeAffinity = false;
+			continue;
+		}
 		if (try_scan(&scan_start, "tarokEnableStableRegionDetection")) {
 			extensions->tarokEnableStableRegionDetection = true;
 			continue;
@@ -1418,6 +1443,20 @@ gcParseXXgcArguments(J9JavaVM *vm, char *optArg)
 			continue;
 		}
 
+		if (try_scan(&scan_start, "stringTableCount=")) {
+			if(!scan_udata_helper(vm, &scan_start, &(extensions->stringTableCount), "stringTableCount=")) {
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			/* 0 is the internal default, derived from the GC thread count */
+			if ((0 == extensions->stringTableCount) || (MM_StringTable::MAX_TABLE_COUNT < extensions->stringTableCount)) {
+				j9nls_printf(PORTLIB, J9NLS_ERROR, J9NLS_GC_OPTIONS_INTEGER_OUT_OF_RANGE, "-XXgc:stringTableCount=", (UDATA)1, (UDATA)MM_StringTable::MAX_TABLE_COUNT);
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			continue;
+		}
+
 		if (try_scan(&scan_start, "objectListFragmentCount=")) {
 			if(!scan_udata_helper(vm, &scan_start, &(extensions->objectListFragmentCount), "objectListFragmentCount=")) {
 				returnValue = JNI_EINVAL;
@@ -1425,6 +1464,14 @@ gcParseXXgcArguments(J9JavaVM *vm, char *optArg)
 			}
 			continue;
 		}
+		if (try_scan(&scan_start, "deepStackScanThreshold=")) {
+			if(!scan_udata_memory_size_helper(vm, &scan_start, &(extensions->deepStackScanThreshold), "deepStackScanThreshold=")) {
+				returnValue = JNI_EINVAL;
+				break;
+			}
+			continue;
+		}
+
 		if (try_scan(&scan_start, "stringDedupPolicy=")) {
 			if (try_scan(&scan_start, "disabled")) {
 				extensions->stringDedupPolicy = MM_GCExtensions::J9_JIT_STRING_DEDUP_POLICY_DISABLED;
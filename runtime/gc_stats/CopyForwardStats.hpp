@@ -72,6 +72,13 @@ public:
 	UDATA _doubleMappedArrayletsCandidates; /**< The number of double mapped arraylets that have been visited during marking */
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
 
+	U_64 _rootScanTime; /**< hi-res time spent scanning roots, including memory stalls on the objects copied from them */
+	U_64 _cardCleanTime; /**< hi-res time spent scanning dirty cards */
+	U_64 _completeScanTime; /**< hi-res time spent draining copy caches and work packets, including the work and complete stall times */
+	UDATA _slotsPrefetched; /**< The number of slots whose target header was prefetched before the slot was forwarded */
+	UDATA _crossNodeCopyObjects; /**< The number of objects copied to a region on a different NUMA node than their source region */
+	UDATA _crossNodeCopyBytes; /**< The number of bytes copied to a region on a different NUMA node than their source region */
+
 private:
 	
 	/* 
@@ -103,6 +110,13 @@ public:
 		_doubleMappedArrayletsCleared = 0;
 		_doubleMappedArrayletsCandidates = 0;
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
+
+		_rootScanTime = 0;
+		_cardCleanTime = 0;
+		_completeScanTime = 0;
+		_slotsPrefetched = 0;
+		_crossNodeCopyObjects = 0;
+		_crossNodeCopyBytes = 0;
 	}
 	
 	/**
@@ -130,6 +144,13 @@ public:
 		_doubleMappedArrayletsCleared += stats->_doubleMappedArrayletsCleared;
 		_doubleMappedArrayletsCandidates += stats->_doubleMappedArrayletsCandidates;
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
+
+		_rootScanTime += stats->_rootScanTime;
+		_cardCleanTime += stats->_cardCleanTime;
+		_completeScanTime += stats->_completeScanTime;
+		_slotsPrefetched += stats->_slotsPrefetched;
+		_crossNodeCopyObjects += stats->_crossNodeCopyObjects;
+		_crossNodeCopyBytes += stats->_crossNodeCopyBytes;
 	}
 
 	MM_CopyForwardStats() :
@@ -149,6 +170,12 @@ public:
 		, _doubleMappedArrayletsCleared(0)
 		, _doubleMappedArrayletsCandidates(0)
 #endif /* J9VM_GC_ENABLE_DOUBLE_MAP */
+		, _rootScanTime(0)
+		, _cardCleanTime(0)
+		, _completeScanTime(0)
+		, _slotsPrefetched(0)
+		, _crossNodeCopyObjects(0)
+		, _crossNodeCopyBytes(0)
 	{}
 };
 
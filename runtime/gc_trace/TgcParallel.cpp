@@ -403,6 +403,26 @@ tgcHookCopyForwardEnd(J9HookInterface** hook, uintptr_t eventNum, void* eventDat
 			}
 		}
 	}
+
+	tgcExtensions->printf("CP-FW phases:  roots   cards   scan    scan    prefetched\n");
+	tgcExtensions->printf("               (ms)    (ms)    (ms)    stall   slots\n");
+	tgcExtensions->printf("                                       (ms)\n");
+
+	GC_VMThreadListIterator phaseThreadListIterator(vmThread);
+	while ((walkThread = phaseThreadListIterator.nextVMThread()) != NULL) {
+		MM_EnvironmentVLHGC *env = MM_EnvironmentVLHGC::getEnvironment(walkThread);
+		if ((walkThread == vmThread) || (env->getThreadType() == GC_WORKER_THREAD)) {
+			if (env->_copyForwardStats._gcCount == MM_GCExtensions::getExtensions(env)->globalVLHGCStats.gcCount) {
+				tgcExtensions->printf("%4zu:          %5llu   %5llu   %5llu   %5llu   %10zu\n",
+					env->getWorkerID(),
+					j9time_hires_delta(0, env->_copyForwardStats._rootScanTime, J9PORT_TIME_DELTA_IN_MILLISECONDS),
+					j9time_hires_delta(0, env->_copyForwardStats._cardCleanTime, J9PORT_TIME_DELTA_IN_MILLISECONDS),
+					j9time_hires_delta(0, env->_copyForwardStats._completeScanTime, J9PORT_TIME_DELTA_IN_MILLISECONDS),
+					j9time_hires_delta(0, env->_copyForwardStats._workStallTime + env->_copyForwardStats._completeStallTime, J9PORT_TIME_DELTA_IN_MILLISECONDS),
+					env->_copyForwardStats._slotsPrefetched);
+			}
+		}
+	}
 }
 #endif /* J9VM_GC_VLHGC */
 
@@ -100,6 +100,9 @@ printRootScannerStats(OMR_VMThread *omrVMThread)
 	MM_TgcExtensions *tgcExtensions = MM_TgcExtensions::getExtensions(currentThread);
 	char timestamp[32];
 	U_64 entityScanTimeTotal[RootScannerEntity_Count] = { 0 };
+	UDATA stacksScannedTotal = 0;
+	U_64 maxStackScanTime = 0;
+	UDATA maxStackScanBytes = 0;
 	J9VMThread *thread;
 	
 	/* print only if at least one thread reported stats on at least one of its roots */
@@ -137,11 +140,30 @@ printRootScannerStats(OMR_VMThread *omrVMThread)
 								attributeNames[env->_rootScannerStats._maxIncrementEntity]);
 				}
 
+				/* Report how many stacks this thread walked and its slowest walk */
+				GC_Environment *gcEnv = env->getGCEnvironment();
+				if (0 != gcEnv->_stacksScanned) {
+					U_64 stackScanTime = j9time_hires_delta(0, gcEnv->_maxStackScanTime, J9PORT_TIME_DELTA_IN_MICROSECONDS);
+
+					tgcExtensions->printf(" stacks=\"%zu\" maxstack=\"%llu.%03.3llu\" maxstackbytes=\"%zu\"",
+							gcEnv->_stacksScanned,
+							stackScanTime / 1000,
+							stackScanTime % 1000,
+							gcEnv->_maxStackScanBytes);
+
+					stacksScannedTotal += gcEnv->_stacksScanned;
+					if (gcEnv->_maxStackScanTime > maxStackScanTime) {
+						maxStackScanTime = gcEnv->_maxStackScanTime;
+						maxStackScanBytes = gcEnv->_maxStackScanBytes;
+					}
+				}
+
 				tgcExtensions->printf("/>\n");
 
 				/* Clear root scanner statistics collected for this thread, so data printed during
 				 * this pass will not be duplicated */
 				env->_rootScannerStats.clear();
+				gcEnv->clearStackScanStats();
 			}
 		}
 
@@ -158,6 +180,16 @@ printRootScannerStats(OMR_VMThread *omrVMThread)
 			}
 		}
 
+		if (0 != stacksScannedTotal) {
+			U_64 stackScanTime = j9time_hires_delta(0, maxStackScanTime, J9PORT_TIME_DELTA_IN_MICROSECONDS);
+
+			tgcExtensions->printf(" stacks=\"%zu\" maxstack=\"%llu.%03.3llu\" maxstackbytes=\"%zu\"",
+					stacksScannedTotal,
+					stackScanTime / 1000,
+					stackScanTime % 1000,
+					maxStackScanBytes);
+		}
+
 		tgcExtensions->printf("/>\n</scan>\n");
 		extensions->rootScannerStatsUsed = false;
 	}
@@ -231,14 +231,31 @@ tgcHookReportInterRegionRememberedSetHistogram(J9HookInterface** hookInterface,
 
 	UDATA maxCardsToRegion = 0;
 	UDATA totalCardsToRegions = 0;
+	UDATA overflowedRegions = 0;
+	UDATA repeatedlyOverflowedRegions = 0;
+	UDATA maxOverflowCount = 0;
 
 	for (UDATA i = 0; i < regionCount; i++) {
 		MM_HeapRegionDescriptorVLHGC *region = (MM_HeapRegionDescriptorVLHGC *)regionManager->physicalTableDescriptorForIndex(i);
 		maxCardsToRegion = OMR_MAX(maxCardsToRegion, region->getRememberedSetCardList()->getSize(&env));
 		totalCardsToRegions += region->getRememberedSetCardList()->getSize(&env);
+
+		UDATA overflowCount = region->getRememberedSetCardList()->getOverflowCount();
+		if (0 != overflowCount) {
+			overflowedRegions += 1;
+			if (1 < overflowCount) {
+				repeatedlyOverflowedRegions += 1;
+			}
+			maxOverflowCount = OMR_MAX(maxOverflowCount, overflowCount);
+		}
 	}
 
 	calculateAndPrintHistogram(vmThread, regionManager, eventString, totalCardsToRegions, maxCardsToRegion);
+
+	MM_InterRegionRememberedSet *interRegionRememberedSet = extensions->interRegionRememberedSet;
+	tgcExtensions->printf("{RSCL: %zu regions overflowed since last freed, %zu more than once (max %zu times); %zu duplicate cards removed instead of overflowing }\n",
+			overflowedRegions, repeatedlyOverflowedRegions, maxOverflowCount, interRegionRememberedSet->_duplicateCardsRemovedCount);
+	interRegionRememberedSet->_duplicateCardsRemovedCount = 0;
 }
 
 
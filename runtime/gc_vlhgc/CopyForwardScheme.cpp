@@ -107,6 +107,13 @@
 
 #define SCAN_TO_COPY_CACHE_MAX_DISTANCE (UDATA_MAX)
 
+/* Prefetch for write, since forwarding an object writes its header */
+#if defined(__GNUC__) || defined(__clang__)
+#define COPYFORWARD_PREFETCH_FOR_WRITE(address) __builtin_prefetch((const void *)(address), 1)
+#else /* defined(__GNUC__) || defined(__clang__) */
+#define COPYFORWARD_PREFETCH_FOR_WRITE(address)
+#endif /* defined(__GNUC__) || defined(__clang__) */
+
 /* VM Design 1774: Ideally we would pull these cache line values from the port library but this will suffice for
  * a quick implementation
  */
@@ -171,6 +178,7 @@ MM_CopyForwardScheme::MM_CopyForwardScheme(MM_EnvironmentVLHGC *env, MM_HeapRegi
 	, _failedToExpand(false)
 	, _shouldScanFinalizableObjects(false)
 	, _objectAlignmentInBytes(env->getObjectAlignmentInBytes())
+	, _prefetchDepth(_extensions->tarokCopyForwardPrefetchDepth)
 {
 	_typeId = __FUNCTION__;
 }
@@ -352,7 +360,8 @@ MM_CopyForwardScheme::getPreferredAllocationContext(MM_AllocationContextTarok *s
 {
 	MM_AllocationContextTarok *preferredContext = suggestedContext;
 
-	if (preferredContext == _commonContext) {
+	if ((preferredContext == _commonContext) || _extensions->tarokEnableCopyForwardNodeAffinity) {
+		/* with node affinity, survivors stay with the context (and NUMA node) of the thread that allocated them, rather than following their referrer */
 		preferredContext = getContextForHeapAddress(objectPtr);
 	} /* no code beyond this point without modifying else statement below */
 	return preferredContext;
@@ -2030,6 +2039,15 @@ MM_CopyForwardScheme::copy(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *
 					env->_copyForwardCompactGroups[destinationCompactGroup]._nonEdenStats._copiedObjects += 1;
 					env->_copyForwardCompactGroups[destinationCompactGroup]._nonEdenStats._copiedBytes += objectCopySizeInBytes;
 				}
+				if (_extensions->_numaManager.isPhysicalNUMASupported()) {
+					/* node 0 is the common context, which is not bound to a node */
+					UDATA sourceNode = sourceRegion->getNumaNode();
+					UDATA destinationNode = _regionManager->tableDescriptorForAddress(destinationObjectPtr)->getNumaNode();
+					if ((0 != sourceNode) && (0 != destinationNode) && (sourceNode != destinationNode)) {
+						env->_copyForwardStats._crossNodeCopyObjects += 1;
+						env->_copyForwardStats._crossNodeCopyBytes += objectCopySizeInBytes;
+					}
+				}
 				copyCache->_allocationAgeSizeProduct += ((double)objectReserveSizeInBytes * (double)sourceRegion->getAllocationAge());
 				copyCache->_objectSize += objectReserveSizeInBytes;
 				copyCache->_lowerAgeBound = OMR_MIN(copyCache->_lowerAgeBound, sourceRegion->getLowerAgeBound());
@@ -2276,6 +2294,10 @@ MM_CopyForwardScheme::scanOwnableSynchronizerObjectSlots(MM_EnvironmentVLHGC *en
  */
 MMINLINE bool
 MM_CopyForwardScheme::iterateAndCopyforwardSlotReference(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *reservingContext, J9Object *objectPtr) {
+	if (0 != _prefetchDepth) {
+		return iterateAndCopyforwardSlotReferenceWithPrefetch(env, reservingContext, objectPtr);
+	}
+
 	bool success = true;
 	fj9object_t *endScanPtr;
 	UDATA *descriptionPtr;
@@ -2335,6 +2357,103 @@ MM_CopyForwardScheme::iterateAndCopyforwardSlotReference(MM_EnvironmentVLHGC *en
 	return success;
 }
 
+bool
+MM_CopyForwardScheme::iterateAndCopyforwardSlotReferenceWithPrefetch(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *reservingContext, J9Object *objectPtr)
+{
+	bool success = true;
+	fj9object_t *endScanPtr;
+	UDATA *descriptionPtr;
+	UDATA descriptionBits;
+	UDATA descriptionIndex;
+#if defined(J9VM_GC_LEAF_BITS)
+	UDATA *leafPtr = (UDATA *)J9GC_J9OBJECT_CLAZZ(objectPtr, env)->instanceLeafDescription;
+	UDATA leafBits;
+#endif /* J9VM_GC_LEAF_BITS */
+	bool const compressed = env->compressObjectReferences();
+	UDATA const prefetchDepth = _prefetchDepth;
+
+	/* Ring of slots whose target header has been prefetched, oldest at pendingHead */
+	volatile fj9object_t *pendingSlots[MAX_PREFETCH_DEPTH];
+	bool pendingLeaf[MAX_PREFETCH_DEPTH];
+	UDATA pendingHead = 0;
+	UDATA pendingCount = 0;
+	UDATA slotsPrefetched = 0;
+
+	/* Object slots */
+	volatile fj9object_t* scanPtr = _extensions->mixedObjectModel.getHeadlessObject(objectPtr);
+	UDATA objectSize = _extensions->mixedObjectModel.getSizeInBytesWithHeader(objectPtr);
+
+	endScanPtr = (fj9object_t*)(((U_8 *)objectPtr) + objectSize);
+	descriptionPtr = (UDATA *)J9GC_J9OBJECT_CLAZZ(objectPtr, env)->instanceDescription;
+
+	if (((UDATA)descriptionPtr) & 1) {
+		descriptionBits = ((UDATA)descriptionPtr) >> 1;
+#if defined(J9VM_GC_LEAF_BITS)
+		leafBits = ((UDATA)leafPtr) >> 1;
+#endif /* J9VM_GC_LEAF_BITS */
+	} else {
+		descriptionBits = *descriptionPtr++;
+#if defined(J9VM_GC_LEAF_BITS)
+		leafBits = *leafPtr++;
+#endif /* J9VM_GC_LEAF_BITS */
+	}
+	descriptionIndex = J9_OBJECT_DESCRIPTION_SIZE - 1;
+
+	while (success && (scanPtr < endScanPtr)) {
+		/* Determine if the slot should be processed */
+		if (descriptionBits & 1) {
+			GC_SlotObject slotObject(_javaVM->omrVM, scanPtr);
+#if defined(J9VM_GC_LEAF_BITS)
+			bool leafType = (1 == (leafBits & 1));
+#else /* J9VM_GC_LEAF_BITS */
+			bool leafType = false;
+#endif /* J9VM_GC_LEAF_BITS */
+			J9Object *value = slotObject.readReferenceFromSlot();
+			if ((NULL != value) && isObjectInEvacuateMemory(value)) {
+				/* The target may have to be copied: start loading its header and defer the slot */
+				COPYFORWARD_PREFETCH_FOR_WRITE(value);
+				slotsPrefetched += 1;
+				if (pendingCount == prefetchDepth) {
+					GC_SlotObject pendingSlotObject(_javaVM->omrVM, pendingSlots[pendingHead]);
+					success = copyAndForward(env, reservingContext, objectPtr, &pendingSlotObject, pendingLeaf[pendingHead]);
+					pendingHead = (pendingHead + 1) % prefetchDepth;
+					pendingCount -= 1;
+				}
+				UDATA pendingTail = (pendingHead + pendingCount) % prefetchDepth;
+				pendingSlots[pendingTail] = scanPtr;
+				pendingLeaf[pendingTail] = leafType;
+				pendingCount += 1;
+			} else {
+				/* Nothing to copy, but the reference may still have to be remembered */
+				success = copyAndForward(env, reservingContext, objectPtr, &slotObject, leafType);
+			}
+		}
+		descriptionBits >>= 1;
+#if defined(J9VM_GC_LEAF_BITS)
+		leafBits >>= 1;
+#endif /* J9VM_GC_LEAF_BITS */
+		if (descriptionIndex-- == 0) {
+			descriptionBits = *descriptionPtr++;
+#if defined(J9VM_GC_LEAF_BITS)
+			leafBits = *leafPtr++;
+#endif /* J9VM_GC_LEAF_BITS */
+			descriptionIndex = J9_OBJECT_DESCRIPTION_SIZE - 1;
+		}
+		scanPtr = GC_SlotObject::addToSlotAddress((fomrobject_t*)scanPtr, 1, compressed);
+	}
+
+	/* Drain the slots still in flight */
+	while (success && (0 != pendingCount)) {
+		GC_SlotObject pendingSlotObject(_javaVM->omrVM, pendingSlots[pendingHead]);
+		success = copyAndForward(env, reservingContext, objectPtr, &pendingSlotObject, pendingLeaf[pendingHead]);
+		pendingHead = (pendingHead + 1) % prefetchDepth;
+		pendingCount -= 1;
+	}
+
+	env->_copyForwardStats._slotsPrefetched += slotsPrefetched;
+	return success;
+}
+
 void
 MM_CopyForwardScheme::scanMixedObjectSlots(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *reservingContext, J9Object *objectPtr, ScanReason reason)
 {
@@ -4073,6 +4192,8 @@ MM_CopyForwardScheme::alignMemoryPool(MM_EnvironmentVLHGC *env, MM_MemoryPoolBum
 void
 MM_CopyForwardScheme::workThreadGarbageCollect(MM_EnvironmentVLHGC *env)
 {
+	PORT_ACCESS_FROM_ENVIRONMENT(env);
+
 	/* GC init (set up per-invocation values) */
 	workerSetupForCopyForward(env);
 
@@ -4149,11 +4270,19 @@ MM_CopyForwardScheme::workThreadGarbageCollect(MM_EnvironmentVLHGC *env)
 	env->enableHotFieldDepthCopy();
 	
 	/* scan roots before cleaning the card table since the roots give us more concrete NUMA recommendations */
+	U_64 phaseStartTime = j9time_hires_clock();
 	scanRoots(env);
+	U_64 phaseEndTime = j9time_hires_clock();
+	env->_copyForwardStats._rootScanTime += phaseEndTime - phaseStartTime;
 
+	phaseStartTime = phaseEndTime;
 	cleanCardTable(env);
-	
+	phaseEndTime = j9time_hires_clock();
+	env->_copyForwardStats._cardCleanTime += phaseEndTime - phaseStartTime;
+
+	phaseStartTime = phaseEndTime;
 	completeScan(env);
+	env->_copyForwardStats._completeScanTime += j9time_hires_clock() - phaseStartTime;
 
 	/* TODO: check if abort happened during root scanning/cardTable clearing (and optimize in any other way) */
 	if(abortFlagRaised()) {
@@ -80,6 +80,11 @@ private:
 		SCAN_REASON_OVERFLOWED_REGION = 4, /**< Indicates the object being scanned was in an overflowed region */
 	};
 
+public:
+	enum { MAX_PREFETCH_DEPTH = 16 }; /**< upper bound of -XXgc:tarokCopyForwardPrefetchDepth= */
+
+private:
+
 	MM_HeapRegionManager *_regionManager;  /**< Region manager for the heap instance */
 	MM_InterRegionRememberedSet *_interRegionRememberedSet;	/**< A cached pointer to the inter-region reference tracking mechanism */
 
@@ -158,6 +163,7 @@ private:
 	volatile bool _failedToExpand; /**< Record if we've failed to expand in this collection already, in order to avoid repeated expansion attempts */
 	bool _shouldScanFinalizableObjects; /**< Set to true at the beginning of a collection if there are any pending finalizable objects */
 	const UDATA _objectAlignmentInBytes;	/**< Run-time objects alignment in bytes */
+	UDATA _prefetchDepth; /**< Local cached value of tarokCopyForwardPrefetchDepth; 0 if slots are forwarded as they are read */
 
 protected:
 public:
@@ -989,6 +995,13 @@ private:
 	 */
 	MMINLINE bool iterateAndCopyforwardSlotReference(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *reservingContext, J9Object *objectPtr);
 
+	/**
+	 *  Same as iterateAndCopyforwardSlotReference, but software pipelined: the header of the target of each slot
+	 *  that points into evacuate memory is prefetched, and the slot is forwarded only once _prefetchDepth more such
+	 *  slots have been read, so that the cache miss on the target overlaps with the work on the other slots.
+	 */
+	bool iterateAndCopyforwardSlotReferenceWithPrefetch(MM_EnvironmentVLHGC *env, MM_AllocationContextTarok *reservingContext, J9Object *objectPtr);
+
 protected:
 
 	MM_CopyForwardScheme(MM_EnvironmentVLHGC *env, MM_HeapRegionManager *manager);
@@ -123,6 +123,7 @@ MM_HeapRegionDataForAllocate::taskAsFreePool(MM_EnvironmentBase *env)
 
 	_region->setRegionType(MM_HeapRegionDescriptor::FREE);
 	_region->_allocateData._owningContext = NULL;
+	_region->getRememberedSetCardList()->resetOverflowCount();
 	/* set _projectedLiveBytes to 'uninitialized' value. it will be initialized at the beginning of the first PGC */
 	_region->_projectedLiveBytes = UDATA_MAX;
 	_region->_projectedLiveBytesDeviation = 0;
@@ -143,6 +144,7 @@ MM_HeapRegionDataForAllocate::taskAsIdlePool(MM_EnvironmentVLHGC *env)
 	 * PGC swept this region (it's empty), but RS list is stale - we should clear it
 	 */
 	MM_GCExtensions::getExtensions(env)->interRegionRememberedSet->clearReferencesToRegion(env, _region);
+	_region->getRememberedSetCardList()->resetOverflowCount();
 	_region->setRegionType(MM_HeapRegionDescriptor::BUMP_ALLOCATED_IDLE);
 	/* set _projectedLiveBytes to 'uninitialized' value. it will be initialized at the beginning of the first PGC */
 	_region->_projectedLiveBytes = UDATA_MAX;
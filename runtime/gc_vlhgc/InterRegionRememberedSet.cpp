@@ -62,6 +62,7 @@ MM_InterRegionRememberedSet::MM_InterRegionRememberedSet(MM_HeapRegionManager *h
 	, _overflowedRegionCount(0)
 	, _stableRegionCount(0)
 	, _beingRebuiltRegionCount(0)
+	, _duplicateCardsRemovedCount(0)
 	, _unusedRegionThreshold(0.0)
 	, _regionTable(NULL)
 	, _tableDescriptorSize(0)
@@ -525,6 +526,7 @@ MM_InterRegionRememberedSet::enqueueOverflowedRscl(MM_EnvironmentVLHGC *env, MM_
 {
 	/* have to use atomic update, since other overflowed RSCLs can be updating it concurrently */
 	MM_AtomicOperations::add(&_overflowedRegionCount, 1);
+	rsclToEnqueue->_overflowCount += 1;
 
 	rsclToEnqueue->_nonEmptyOverflowedNext = NULL;
 	/* make sure rsclToEnqueue->_nonEmptyOverflowedNext does not point to a stale RSCL before we make it visible to the other users of the list */
@@ -77,6 +77,7 @@ public:
 	volatile UDATA _overflowedRegionCount;					/**< count of regions overflowed as full */
 	UDATA _stableRegionCount;								/**< count of regions overflowed as stable */
 	volatile UDATA _beingRebuiltRegionCount;				/**< count of overflowed regions currently being rebuilt */
+	volatile UDATA _duplicateCardsRemovedCount;				/**< cards removed from buckets of full lists in place of overflowing them (cleared by consumers such as TGC) */
 	double _unusedRegionThreshold;							/**< fraction of region unused (free&fragmented) to be considered full (used for stable region detection) */
 
 	MM_HeapRegionDescriptor *_regionTable;					/**< cached copy of regionTable (from HeapRegionManager) */
@@ -35,6 +35,7 @@ MM_RememberedSetCardBucket::initialize(MM_EnvironmentVLHGC *env, MM_RememberedSe
 	_cardBufferControlBlockHead = NULL;
 	_current = NULL;
 	_bufferCount = 0;
+	_sizeAfterDuplicateRemoval = 0;
 
 	return true;
 }
@@ -76,7 +77,12 @@ MM_RememberedSetCardBucket::addToNewBuffer(MM_EnvironmentVLHGC *env, UDATA card)
 			MM_AtomicOperations::subtract(&_rscl->_bufferCount, 1);
 			_bufferCount -= 1;
 
-			setListAsOverflow(env, _rscl);
+			if (removeDuplicates(env)) {
+				/* there is room again, either in the current buffer or for a new one */
+				add(env, card);
+			} else {
+				setListAsOverflow(env, _rscl);
+			}
 		} else {
 			MM_InterRegionRememberedSet *interRegionRememberedSet = MM_GCExtensions::getExtensions(env)->interRegionRememberedSet;
 
@@ -154,6 +160,53 @@ MM_RememberedSetCardBucket::isRemembered(MM_EnvironmentVLHGC *env, UDATA card)
 	return false;
 }
 
+bool
+MM_RememberedSetCardBucket::removeDuplicates(MM_EnvironmentVLHGC *env)
+{
+	UDATA sizeBefore = getSize(env);
+	if ((sizeBefore < (2 * MAX_BUFFER_SIZE)) || (sizeBefore < (2 * _sizeAfterDuplicateRemoval))) {
+		/* too small to be worth it, or nothing much was added since the last attempt */
+		return false;
+	}
+
+	bool const compressed = env->compressObjectReferences();
+	UDATA filter[DUPLICATE_FILTER_SIZE];
+	memset(filter, 0, sizeof(filter));
+
+	MM_CardBufferControlBlock *cardBufferControlBlock = _cardBufferControlBlockHead;
+	while (NULL != cardBufferControlBlock) {
+		MM_RememberedSetCard *bufferCardList = cardBufferControlBlock->_card;
+
+		/* find top index for this buffer */
+		UDATA cardIndexTop = MAX_BUFFER_SIZE;
+		if (isCurrentSlotWithinBuffer(env, bufferCardList)) {
+			cardIndexTop = MM_RememberedSetCard::subtractCardAddresses(_current, bufferCardList, compressed);
+		}
+
+		for (UDATA cardIndex = 0; cardIndex < cardIndexTop; cardIndex++) {
+			MM_RememberedSetCard *cardAddress = MM_RememberedSetCard::addToCardAddress(bufferCardList, cardIndex, compressed);
+			UDATA card = MM_RememberedSetCard::readCard(cardAddress, compressed);
+			UDATA *filterSlot = &filter[card % DUPLICATE_FILTER_SIZE];
+			if (card == *filterSlot) {
+				MM_RememberedSetCard::writeCard(cardAddress, 0, compressed);
+			} else {
+				*filterSlot = card;
+			}
+		}
+		cardBufferControlBlock = cardBufferControlBlock->_next;
+	}
+
+	compact(env);
+
+	_sizeAfterDuplicateRemoval = getSize(env);
+	UDATA removedCount = sizeBefore - _sizeAfterDuplicateRemoval;
+	if (0 != removedCount) {
+		MM_AtomicOperations::add(&MM_GCExtensions::getExtensions(env)->interRegionRememberedSet->_duplicateCardsRemovedCount, removedCount);
+	}
+
+	return (0 != removedCount);
+}
+
 void
 MM_RememberedSetCardBucket::releaseBuffers(MM_EnvironmentVLHGC *env, UDATA buffersToLocalPoolCount)
 {
@@ -166,6 +219,7 @@ MM_RememberedSetCardBucket::releaseBuffers(MM_EnvironmentVLHGC *env, UDATA buffe
 	MM_AtomicOperations::subtract(&_rscl->_bufferCount, releasedCount);
 	_bufferCount = 0;
 	_current = NULL;
+	_sizeAfterDuplicateRemoval = 0;
 }
 
 void
@@ -264,7 +318,8 @@ MM_RememberedSetCardBucket::compact(MM_EnvironmentVLHGC *env)
 		UDATA releasedCount = MM_GCExtensions::getExtensions(env)->interRegionRememberedSet->releaseCardBufferControlBlockListToLocalPool(env, toDeleteCardBufferControlBlock, UDATA_MAX);
 		Assert_MM_true(releasedCount <= _bufferCount);
 		_bufferCount -= releasedCount;
-		_rscl->_bufferCount -= releasedCount;
+		/* other threads may be adding buffers to their own buckets of the same list */
+		MM_AtomicOperations::subtract(&_rscl->_bufferCount, releasedCount);
 	}
 	
 	Assert_MM_true(_rscl->_bufferCount >= _bufferCount);
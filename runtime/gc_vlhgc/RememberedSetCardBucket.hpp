@@ -46,6 +46,7 @@ private:
 	enum {
 		MAX_BUFFER_SIZE_LOG = 5,
 		MAX_BUFFER_SIZE = (1 << MAX_BUFFER_SIZE_LOG),
+		DUPLICATE_FILTER_SIZE = 509, /* prime, so that card aligned addresses spread over the whole filter */
 	};
 
 	friend class MM_RememberedSetCardList;
@@ -58,6 +59,7 @@ private:
 	MM_RememberedSetCardList *_rscl;						/**< owning RSCL */
 	MM_RememberedSetCardBucket *_next;						/**< next bucket in the owning RSCL */
 	UDATA _bufferCount;										/**< the count of buffers in this bucket */
+	UDATA _sizeAfterDuplicateRemoval;						/**< card count left by the last removeDuplicates, so that it only reruns once the bucket has doubled */
 protected:
 public:
 	/* function members */
@@ -72,6 +74,14 @@ private:
 	 * @param buffersToLocalPoolCount max buffers returned to the local pool. typically UDATA_MAX (all goes to local) or MAX_LOCAL_RSCL_BUFFER_POOL_SIZE (small part goes to local, rest to global)
 	 */
 	void releaseBuffers(MM_EnvironmentVLHGC *env, UDATA buffersToLocalPoolCount);
+
+	/**
+	 * Remove repeated cards from the bucket and compact it, as a last resort before overflowing the owning list as full.
+	 * Repeats are found through a small direct mapped filter, so not all of them may be removed, but no card is lost.
+	 * Only called by the thread owning the bucket.
+	 * @return true if at least one card was removed
+	 */
+	bool removeDuplicates(MM_EnvironmentVLHGC *env);
 protected:
 public:
 	bool initialize(MM_EnvironmentVLHGC *env, MM_RememberedSetCardList *rscl, MM_RememberedSetCardBucket *next);
@@ -177,6 +187,7 @@ public:
 	  , _rscl(NULL)
 	  , _next(NULL)
 	  , _bufferCount(0)
+	  , _sizeAfterDuplicateRemoval(0)
 	{
 		_typeId = __FUNCTION__;
 	}
@@ -50,6 +50,7 @@ private:
 	bool _stable;											/**< if true, list is overflowed due to region being stable */
 	volatile UDATA _bufferCount;										/**< count of buffers in all buckets' lists */
 	MM_RememberedSetCardList * volatile _nonEmptyOverflowedNext; 		/**< overflowed RSCL found during a GC cycle are linked into a single liked list - this is next pointer */
+	UDATA _overflowCount;									/**< number of times the list overflowed (full, or its buffers taken for other lists) since its region was last freed */
 private:
 	/**
 	 * Remove an entry. This just NULLs the entry. Compaction/shifting is to be done later, explicitly.
@@ -95,6 +96,20 @@ public:
 		return (TRUE == _overflowed);
 	}
 
+	/**
+	 * @return number of times the list overflowed since its region was last freed
+	 */
+	UDATA getOverflowCount() {
+		return _overflowCount;
+	}
+
+	/**
+	 * Forget the overflow history of the list, once its region is freed and may be reused for unrelated objects
+	 */
+	void resetOverflowCount() {
+		_overflowCount = 0;
+	}
+
 	/*
 	 * return  true if overflowed as stable region
 	 */
@@ -193,6 +208,7 @@ public:
 	  , _stable(false)
 	  , _bufferCount(0)
 	  , _nonEmptyOverflowedNext(NULL)
+	  , _overflowCount(0)
 	{
 		_typeId = __FUNCTION__;
 	}
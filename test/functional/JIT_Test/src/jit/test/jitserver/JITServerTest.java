@@ -29,6 +29,8 @@ import java.util.ArrayList;
 import java.io.File;
 import java.io.IOException;
 import java.io.FileNotFoundException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
 
 import org.testng.AssertJUnit;
 import org.testng.SkipException;
@@ -43,6 +45,9 @@ public class JITServerTest {
 	private static final int SERVER_START_WAIT_TIME_MS = 5 * 1000;
 	private static final int CLIENT_TEST_TIME_MS = 45 * 1000;
 	private static final int SUCCESS_RETURN_VALUE = 0;
+	// Verbose log line written by the server for every AOT cache hit, followed by the name of the cache.
+	private static final String AOT_CACHE_HIT_PATTERN = "sent cached AOT body for clientUID=";
+	private static final String AOT_CACHE_NAME_FORMAT_STRING = "from cache \"%s\"";
 
 	private final ProcessBuilder clientBuilder;
 	private final ProcessBuilder serverBuilder;
@@ -367,4 +372,100 @@ public class JITServerTest {
 		logger.info("Stopping client...");
 		destroyAndCheckProcess(client, clientBuilder);
 	}
+
+	// Returns a copy of builder with extraOptions inserted after the element at insertIndex of its command.
+	private static ProcessBuilder copyBuilderWithOptions(final ProcessBuilder builder, final int insertIndex, final String... extraOptions) {
+		ArrayList<String> command = new ArrayList<String>(builder.command());
+		command.addAll(insertIndex + 1, Arrays.asList(extraOptions));
+		ProcessBuilder copy = new ProcessBuilder(command);
+		copy.environment().clear();
+		copy.environment().putAll(builder.environment());
+		copy.redirectErrorStream(true);
+		return copy;
+	}
+
+	// Returns the contents of all the verbose logs written for outputName; the JIT appends a suffix to the vlog file name.
+	private static String readVerboseLogs(final String outputName) throws IOException {
+		final String prefix = outputName + ".jitverboselog.out";
+		StringBuilder contents = new StringBuilder();
+		File[] logs = new File(".").listFiles((dir, name) -> name.startsWith(prefix));
+		if (logs != null) {
+			for (File log : logs) {
+				contents.append(new String(Files.readAllBytes(log.toPath()), StandardCharsets.UTF_8));
+			}
+		}
+		return contents.toString();
+	}
+
+	// Runs two clients one after the other against a server that caches AOT bodies and returns the server verbose log.
+	// Bodies can only be shared by clients whose shared class caches have the same content, which the client can only
+	// guarantee for read-only caches. So a first client run populates a shared class cache, and then both clients
+	// open that same cache read-only and request the same remote AOT compilations.
+	// The symbol validation manager is disabled because bodies compiled with it are never cached.
+	private String runAOTCacheClients(final String testName, final String firstCacheName, final String secondCacheName) throws IOException, InterruptedException {
+		if (System.getProperty("CLIENT_PROGRAM").contains("-Xshareclasses:none")) {
+			throw new SkipException("The JITServer AOT cache requires a shared class cache at the client.");
+		}
+
+		final ProcessBuilder aotServerBuilder = copyBuilderWithOptions(serverBuilder, 0, "-XX:+JITServerUseAOTCache");
+		redirectProcessOutputs(aotServerBuilder, testName + ".server");
+		final Process server = startProcess(aotServerBuilder, "server");
+
+		Thread.sleep(SERVER_START_WAIT_TIME_MS);
+
+		final int useJITServerIndex = clientBuilder.command().indexOf("-XX:+UseJITServer");
+		final File cacheDir = Files.createTempDirectory(testName + ".scc").toFile();
+		final String shareClassesOption = "-Xshareclasses:name=jitserverAOTCache,cacheDir=" + cacheDir.getAbsolutePath();
+
+		final ProcessBuilder populateBuilder = copyBuilderWithOptions(clientBuilder, useJITServerIndex, shareClassesOption);
+		redirectProcessOutputs(populateBuilder, testName + ".populate");
+		final Process populate = startProcess(populateBuilder, "client");
+
+		logger.info("Populating the shared class cache for " + CLIENT_TEST_TIME_MS + " millis.");
+		Thread.sleep(CLIENT_TEST_TIME_MS);
+
+		logger.info("Stopping client...");
+		destroyAndCheckProcess(populate, populateBuilder);
+
+		final String[] cacheNames = { firstCacheName, secondCacheName };
+		for (int i = 0; i < cacheNames.length; ++i) {
+			final ProcessBuilder aotClientBuilder = copyBuilderWithOptions(clientBuilder, useJITServerIndex,
+				shareClassesOption + ",readonly",
+				"-XX:+JITServerUseAOTCache", "-XX:JITServerAOTCacheName=" + cacheNames[i]);
+			// Synchronous compilations make both clients request the same methods at the same points of their runs.
+			final String JIT_AOT_CACHE_ENV_OPTION = "disableSymbolValidationManager,disableAsyncCompilation";
+			final String AOT_AOT_CACHE_ENV_OPTION = "disableSymbolValidationManager";
+			aotClientBuilder.environment().compute("TR_Options", (k, v) -> v != null && !v.isEmpty() ? String.join(",", JIT_AOT_CACHE_ENV_OPTION, v) : JIT_AOT_CACHE_ENV_OPTION);
+			aotClientBuilder.environment().compute("TR_AOTOptions", (k, v) -> v != null && !v.isEmpty() ? String.join(",", v, AOT_AOT_CACHE_ENV_OPTION) : AOT_AOT_CACHE_ENV_OPTION);
+			redirectProcessOutputs(aotClientBuilder, testName + ".client" + i);
+			final Process client = startProcess(aotClientBuilder, "client");
+
+			logger.info("Waiting for " + CLIENT_TEST_TIME_MS + " millis.");
+			Thread.sleep(CLIENT_TEST_TIME_MS);
+
+			logger.info("Stopping client...");
+			destroyAndCheckProcess(client, aotClientBuilder);
+		}
+
+		logger.info("Stopping server...");
+		destroyAndCheckProcess(server, aotServerBuilder);
+
+		return readVerboseLogs(testName + ".server");
+	}
+
+	public void testAOTCacheHit() throws IOException, InterruptedException {
+		logger.info("running testAOTCacheHit: INFO and above level logging enabled");
+
+		final String serverLog = runAOTCacheClients("testAOTCacheHit", "sharedCache", "sharedCache");
+		AssertJUnit.assertTrue("Expected the server to send AOT bodies cached for the first client to the second client using the same read-only shared class cache.",
+			serverLog.contains(AOT_CACHE_HIT_PATTERN) && serverLog.contains(String.format(AOT_CACHE_NAME_FORMAT_STRING, "sharedCache")));
+	}
+
+	public void testAOTCacheMissWithDifferentIdentity() throws IOException, InterruptedException {
+		logger.info("running testAOTCacheMissWithDifferentIdentity: INFO and above level logging enabled");
+
+		final String serverLog = runAOTCacheClients("testAOTCacheMissWithDifferentIdentity", "firstCache", "secondCache");
+		AssertJUnit.assertFalse("Clients with different AOT cache identities must not share cached AOT bodies.",
+			serverLog.contains(String.format(AOT_CACHE_NAME_FORMAT_STRING, "secondCache")));
+	}
 }